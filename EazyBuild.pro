@@ -1,4 +1,4 @@
-QT       += core gui network
+QT       += core gui network concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -9,17 +9,61 @@ CONFIG += c++17
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    artifactcache.cpp \
+    builddaemon.cpp \
+    buildmatrix.cpp \
+    buildplanner.cpp \
+    buildtimings.cpp \
+    buildtrace.cpp \
+    cmakegenerator.cpp \
     commandexecutor.cpp \
+    commandline.cpp \
+    compilercache.cpp \
+    configurecache.cpp \
+    diagnostics.cpp \
+    errorscanner.cpp \
     filepathselector.cpp \
+    jobserver.cpp \
+    logfileviewer.cpp \
+    logview.cpp \
+    logarchive.cpp \
+    logwriter.cpp \
+    outputcapture.cpp \
+    processtree.cpp \
     main.cpp \
     mainwindow.cpp \
-    remoteconfigdialog.cpp
+    remoteconfigdialog.cpp \
+    remotefilesender.cpp \
+    resourceusage.cpp \
+    sourcechangetracker.cpp
 
 HEADERS += \
+    artifactcache.h \
+    builddaemon.h \
+    buildmatrix.h \
+    buildplanner.h \
+    buildtimings.h \
+    buildtrace.h \
+    cmakegenerator.h \
     commandexecutor.h \
+    commandline.h \
+    compilercache.h \
+    configurecache.h \
+    diagnostics.h \
+    errorscanner.h \
     filepathselector.h \
+    jobserver.h \
+    logfileviewer.h \
+    logview.h \
+    logarchive.h \
+    logwriter.h \
+    outputcapture.h \
+    processtree.h \
     mainwindow.h \
-    remoteconfigdialog.h
+    remoteconfigdialog.h \
+    remotefilesender.h \
+    resourceusage.h \
+    sourcechangetracker.h
 
 FORMS += \
     mainwindow.ui
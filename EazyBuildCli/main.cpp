@@ -0,0 +1,368 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalSocket>
+#include <QSet>
+#include <QTimer>
+#include <cstdio>
+#include "buildplanner.h"
+#include "buildmatrix.h"
+#include "builddaemon.h"
+#include "commandexecutor.h"
+
+// Process exit codes
+enum ExitCode
+{
+    ExitOk          = 0,  // Every job built (and deployed) successfully
+    ExitBuildFailed = 1,  // A command or a deployment failed
+    ExitUsageError  = 2,  // Invalid arguments or paths
+    ExitNoDaemon    = 3,  // --daemon given but no daemon is listening
+};
+
+static int usageError(const QString& message)
+{
+    fprintf(stderr, "eazybuild-cli: %s\n", message.toLocal8Bit().constData());
+    return ExitUsageError;
+}
+
+// Map an option value onto an enum value (case-insensitive), false = unknown value
+template <typename T>
+static bool parseChoice(const QString& value, const QList<QPair<QString, T>>& choices, T& result)
+{
+    for (const auto& choice : choices) {
+        if (value.compare(choice.first, Qt::CaseInsensitive) == 0) {
+            result = choice.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Comma-separated variant of parseChoice (matrix axes), false = unknown or empty value
+template <typename T>
+static bool parseChoices(const QString& value, const QList<QPair<QString, T>>& choices, QList<T>& results)
+{
+    for (const QString& item : value.split(',', Qt::SkipEmptyParts)) {
+        T result;
+        if (!parseChoice(item.trimmed(), choices, result)) return false;
+        if (!results.contains(result)) results << result;
+    }
+    return !results.isEmpty();
+}
+
+// Submit one build request to a running eazybuild-daemon and stream its events until the jobs finish
+static int runViaDaemon(QCoreApplication& a, const QString& serverName, const QJsonObject& request)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if (!socket.waitForConnected(3000)) {
+        fprintf(stderr, "eazybuild-cli: no daemon listening on %s (start eazybuild-daemon first)\n", serverName.toLocal8Bit().constData());
+        return ExitNoDaemon;
+    }
+
+    QSet<int> pendingJobs;
+    bool hasFailedJob = false;
+    bool isAccepted = false;
+    QByteArray buffer;
+
+    QObject::connect(&socket, &QLocalSocket::readyRead, &a, [&]() {
+        buffer.append(socket.readAll());
+        int newline;
+        while ((newline = buffer.indexOf('\n')) >= 0) {
+            QJsonObject event = QJsonDocument::fromJson(buffer.left(newline)).object();
+            buffer.remove(0, newline + 1);
+            QString type = event.value("event").toString();
+
+            if (type == "log") {
+                FILE* stream = event.value("error").toBool() ? stderr : stdout;
+                fputs(event.value("text").toString().toUtf8().constData(), stream);
+                fflush(stream);
+            } else if (type == "error") {
+                fprintf(stderr, "eazybuild-cli: daemon: %s\n", event.value("message").toString().toLocal8Bit().constData());
+                a.exit(isAccepted ? ExitBuildFailed : ExitUsageError);
+                return;
+            } else if (type == "accepted") {
+                isAccepted = true;
+                if (event.contains("message")) {
+                    fprintf(stdout, "%s\n", event.value("message").toString().toLocal8Bit().constData());
+                }
+                // Jobs restored from cache may already be done when the reply arrives
+                for (const QJsonValue& value : event.value("jobs").toArray()) {
+                    QJsonObject job = value.toObject();
+                    QString status = job.value("status").toString();
+                    if (status == "queued" || status == "running") {
+                        pendingJobs.insert(job.value("id").toInt());
+                    } else if (status != "succeeded") {
+                        hasFailedJob = true;
+                    }
+                }
+            } else if (type == "jobFinished") {
+                hasFailedJob = hasFailedJob || !event.value("success").toBool();
+                pendingJobs.remove(event.value("id").toInt());
+            }
+
+            if (isAccepted && pendingJobs.isEmpty()) {
+                a.exit(hasFailedJob ? ExitBuildFailed : ExitOk);
+                return;
+            }
+        }
+    });
+    QObject::connect(&socket, &QLocalSocket::disconnected, &a, [&]() {
+        fprintf(stderr, "eazybuild-cli: daemon closed the connection\n");
+        a.exit(ExitBuildFailed);
+    });
+
+    socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact));
+    socket.write("\n", 1);
+    int exitCode = a.exec();
+    QObject::disconnect(&socket, nullptr, &a, nullptr);
+    return exitCode;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("eazybuild-cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless EazyBuild: builds GPU driver / FantasyPanel with the same options as the GUI");
+    parser.addHelpOption();
+
+    QCommandLineOption projectOption({"p", "project"}, "Project source directory (default: current directory).", "dir", QDir::currentPath());
+    QCommandLineOption typeOption({"t", "type"}, "Build type: gpu, panel, all (default: all).", "type", "all");
+    QCommandLineOption gpuOption({"g", "gpu"}, "GPU model: G0M, G3, G1P (default: G0M). Comma list with --matrix.", "model", "G0M");
+    QCommandLineOption driverOption({"d", "driver"}, "Driver type: umd, kmd, all (default: all).", "driver", "all");
+    QCommandLineOption bitOption({"b", "bit"}, "UMD architecture: 32, 64, all (default: 64). Comma list with --matrix.", "bit", "64");
+    QCommandLineOption configOption({"c", "config"}, "Build config: debug, release (default: debug). Comma list with --matrix.", "config", "debug");
+    QCommandLineOption firmwareOption({"f", "firmware"}, "Firmware version: 116, 119 (default: 119). Comma list with --matrix.", "version", "119");
+    QCommandLineOption generatorOption("generator", "CMake generator: vs2019, ninja, ninja-multi, make (default: "
+                                       + CMakeGenerator::optionName(CMakeGenerator::defaultKind()) + ").", "name",
+                                       CMakeGenerator::optionName(CMakeGenerator::defaultKind()));
+    QCommandLineOption launcherOption("compiler-launcher", "Compiler cache for every configure: ccache, sccache or a path (hit rate is reported at the end).", "launcher");
+    QCommandLineOption matrixOption({"m", "matrix"}, "Build every combination of --gpu/--config/--bit/--firmware in one batch and print a summary table.");
+    QCommandLineOption uniqOption("uniq", "Enable SUPPORT_UNIQ (not available with firmware 116).");
+    QCommandLineOption pvrOption("pvr", "Enable SUPPORT_PERF (KMD).");
+    QCommandLineOption statOption("stat", "Enable ENABLE_PROCESS_STATS (KMD).");
+    QCommandLineOption deleteKmdOption("delete-kmd", "Delete the KMD build directory before building.");
+    QCommandLineOption replaceOption({"r", "replace"}, "Copy the built artifacts to this directory after a successful build.", "dir");
+    QCommandLineOption remoteOption("remote", "Deploy to the RemoteReceiver on this host instead of copying locally (requires --replace).", "host");
+    QCommandLineOption remotePathOption("remote-path", "Target directory on the remote host.", "path");
+    QCommandLineOption jobsOption({"j", "jobs"}, "Core budget shared by all parallel builds (default: all cores).", "n");
+    QCommandLineOption noConfigureCacheOption("no-configure-cache", "Always run the configure step.");
+    QCommandLineOption noArtifactCacheOption("no-artifact-cache", "Do not restore or store artifacts in the artifact cache.");
+    QCommandLineOption failFastOption("fail-fast", "Abort a build at the first compiler, linker or CMake error (kills its parallel commands).");
+    QCommandLineOption logFileOption("log-file", "Write the detailed execution log to this file.", "path");
+    QCommandLineOption noBuildTimingsOption("no-build-timings", "Do not rank the slowest targets and translation units after each build.");
+    QCommandLineOption noTraceOption("no-trace", "Do not write the build trace (eazybuild_trace_*.json next to the log, for chrome://tracing or Perfetto).");
+    QCommandLineOption daemonOption("daemon", "Submit the build to a running eazybuild-daemon (warm caches) instead of building in-process.");
+    QCommandLineOption daemonNameOption("daemon-name", "Local socket name of the daemon (default: " + BuildDaemon::defaultServerName() + ").",
+                                        "name", BuildDaemon::defaultServerName());
+    QCommandLineOption noSkipUnchangedOption("no-skip-unchanged", "With --daemon: rebuild components whose sources did not change since the daemon last built them.");
+
+    parser.addOptions({projectOption, typeOption, gpuOption, driverOption, bitOption, configOption, firmwareOption, generatorOption, launcherOption,
+                       uniqOption, pvrOption, statOption, deleteKmdOption, replaceOption, remoteOption, remotePathOption,
+                       jobsOption, noConfigureCacheOption, noArtifactCacheOption, failFastOption, logFileOption, noBuildTimingsOption,
+                       noTraceOption, matrixOption, daemonOption, daemonNameOption, noSkipUnchangedOption});
+    parser.process(a);
+
+    // ========== Options -> BuildOptions ==========
+    BuildOptions options;
+    if (!parseChoice<BuildOptions::BuildType>(parser.value(typeOption),
+            {{"gpu", BuildOptions::GPUDriver}, {"panel", BuildOptions::FantasyPanel}, {"all", BuildOptions::AllType}}, options.buildType)) {
+        return usageError("invalid --type: " + parser.value(typeOption));
+    }
+    if (!parseChoice<BuildOptions::DriverType>(parser.value(driverOption),
+            {{"umd", BuildOptions::UMD}, {"kmd", BuildOptions::KMD}, {"all", BuildOptions::AllDriver}}, options.driver)) {
+        return usageError("invalid --driver: " + parser.value(driverOption));
+    }
+
+    if (!CMakeGenerator::fromOptionName(parser.value(generatorOption), options.generator)) {
+        return usageError("invalid --generator: " + parser.value(generatorOption));
+    }
+
+    // Axes: one value each, or comma lists in matrix mode
+    MatrixAxes axes;
+    if (!parseChoices<BuildOptions::GPUModel>(parser.value(gpuOption),
+            {{"G0M", BuildOptions::G0M}, {"G3", BuildOptions::G3}, {"G1P", BuildOptions::G1P}}, axes.gpus)) {
+        return usageError("invalid --gpu: " + parser.value(gpuOption));
+    }
+    if (!parseChoices<BuildOptions::Bit>(parser.value(bitOption),
+            {{"32", BuildOptions::Bit32}, {"64", BuildOptions::Bit64}, {"all", BuildOptions::AllBit}}, axes.bits)) {
+        return usageError("invalid --bit: " + parser.value(bitOption));
+    }
+    if (!parseChoices<BuildOptions::BuildConfig>(parser.value(configOption),
+            {{"debug", BuildOptions::Debug}, {"release", BuildOptions::Release}}, axes.configs)) {
+        return usageError("invalid --config: " + parser.value(configOption));
+    }
+    if (!parseChoices<BuildOptions::FirmwareVersion>(parser.value(firmwareOption),
+            {{"116", BuildOptions::Firmware116}, {"119", BuildOptions::Firmware119}}, axes.firmwares)) {
+        return usageError("invalid --firmware: " + parser.value(firmwareOption));
+    }
+
+    bool isMatrix = parser.isSet(matrixOption);
+    if (!isMatrix && (axes.gpus.size() > 1 || axes.configs.size() > 1 || axes.firmwares.size() > 1 || axes.bits.size() > 1)) {
+        return usageError("several values per option need --matrix");
+    }
+    // "all" = both architectures in one UMD chain, as "32,64" does in matrix mode
+    if (axes.bits.contains(BuildOptions::AllBit) || axes.bits.size() > 1) {
+        axes.bits = {BuildOptions::Bit32, BuildOptions::Bit64};
+        options.bit = BuildOptions::AllBit;
+    } else {
+        options.bit = axes.bits.first();
+    }
+    options.gpu      = axes.gpus.first();
+    options.config   = axes.configs.first();
+    options.firmware = axes.firmwares.first();
+    options.uniq           = parser.isSet(uniqOption);
+    options.pvr            = parser.isSet(pvrOption);
+    options.stat           = parser.isSet(statOption);
+    options.forceDeleteKMD = parser.isSet(deleteKmdOption);
+    options.autoReplace    = parser.isSet(replaceOption);
+    options.compilerLauncher = parser.value(launcherOption);
+    if (!options.compilerLauncher.isEmpty() && !CMakeGenerator(options.generator).supportsCompilerLauncher()) {
+        fprintf(stderr, "eazybuild-cli: warning: --compiler-launcher is ignored by the %s generator\n",
+                CMakeGenerator(options.generator).cmakeName().toLocal8Bit().constData());
+    }
+
+    if (options.uniq && !isMatrix && options.firmware == BuildOptions::Firmware116) {
+        return usageError("--uniq is not supported with firmware 116");
+    }
+
+    QString projectPath = QDir::cleanPath(QDir(parser.value(projectOption)).absolutePath());
+    if (!QFileInfo(projectPath).isDir()) {
+        return usageError("project directory does not exist: " + projectPath);
+    }
+
+    QString targetPath;
+    if (options.autoReplace) {
+        targetPath = QDir::cleanPath(QDir(parser.value(replaceOption)).absolutePath());
+    }
+
+    if (isMatrix && options.autoReplace) {
+        return usageError("--replace is not supported with --matrix (variants would overwrite each other)");
+    }
+
+    bool isRemote = parser.isSet(remoteOption);
+    if (isRemote && (!options.autoReplace || !parser.isSet(remotePathOption))) {
+        return usageError("--remote requires --replace and --remote-path");
+    }
+
+    // ========== Daemon client ==========
+    if (parser.isSet(daemonOption)) {
+        // Executor settings belong to the daemon's own command line
+        for (const QCommandLineOption& option : {matrixOption, jobsOption, noConfigureCacheOption, noArtifactCacheOption, logFileOption, noBuildTimingsOption, noTraceOption}) {
+            if (parser.isSet(option)) {
+                return usageError("--" + option.names().last() + " is not supported with --daemon");
+            }
+        }
+        QJsonObject request;
+        request["request"]       = "build";
+        request["project"]       = projectPath;
+        request["target"]        = targetPath;
+        request["options"]       = BuildPlanner::optionsToJson(options);
+        request["skipUnchanged"] = !parser.isSet(noSkipUnchangedOption);
+        request["failFast"]      = parser.isSet(failFastOption);
+        if (isRemote) {
+            QString remoteHost = parser.value(remoteOption).trimmed();
+            if (remoteHost.startsWith("\\\\")) {
+                remoteHost = remoteHost.mid(2);
+            }
+            request["remoteHost"] = remoteHost;
+            request["remotePath"] = parser.value(remotePathOption);
+        }
+        return runViaDaemon(a, parser.value(daemonNameOption), request);
+    }
+
+    // ========== Executor setup ==========
+    CommandExecutor executor;
+    if (parser.isSet(jobsOption)) {
+        bool isNumber = false;
+        int cores = parser.value(jobsOption).toInt(&isNumber);
+        if (!isNumber || cores < 1) {
+            return usageError("invalid --jobs: " + parser.value(jobsOption));
+        }
+        executor.setCpuBudget(cores);
+    }
+    executor.setConfigureCacheEnabled(!parser.isSet(noConfigureCacheOption));
+    executor.setArtifactCacheEnabled(!parser.isSet(noArtifactCacheOption));
+    executor.setCompilerLauncher(options.compilerLauncher);
+    executor.setFailFastEnabled(parser.isSet(failFastOption));
+    executor.setTraceEnabled(!parser.isSet(noTraceOption));
+    executor.setBuildTimingsEnabled(!parser.isSet(noBuildTimingsOption));
+    if (parser.isSet(logFileOption)) {
+        executor.setLogFilePath(QDir(parser.value(logFileOption)).absolutePath());
+    }
+    if (isRemote) {
+        QString remoteHost = parser.value(remoteOption).trimmed();
+        if (remoteHost.startsWith("\\\\")) {
+            remoteHost = remoteHost.mid(2);
+        }
+        executor.setRemoteHost(remoteHost);
+        executor.setRemotePath(parser.value(remotePathOption));
+    }
+
+    // Stream logs as they arrive (errors on stderr)
+    QObject::connect(&executor, &CommandExecutor::logUpdated, [](const QString& logContent, bool isError) {
+        FILE* stream = isError ? stderr : stdout;
+        fputs(logContent.toUtf8().constData(), stream);
+        fflush(stream);
+    });
+
+    BuildMatrix matrix;
+    bool hasFailedJob = false;
+    QObject::connect(&executor, &CommandExecutor::jobFinished, [&](int jobId, const QString&, bool success, const QString&, const QString&) {
+        hasFailedJob = hasFailedJob || !success;
+        if (isMatrix) {
+            matrix.setResult(jobId, success, executor.jobDurationMs(jobId));
+        }
+    });
+
+    auto finish = [&]() {
+        if (isMatrix) {
+            fprintf(stdout, "\n%s\n", matrix.summaryTable().toUtf8().constData());
+            fflush(stdout);
+        }
+        a.exit(hasFailedJob ? ExitBuildFailed : ExitOk);
+    };
+
+    // Queued: a job may finish while later jobs are still being enqueued
+    QObject::connect(&executor, &CommandExecutor::commandFinished, &a, [&](bool success, const QString&, const QString&) {
+        if (executor.isExecuting()) return;
+        hasFailedJob = hasFailedJob || !success;
+        finish();
+    }, Qt::QueuedConnection);
+
+    QList<PlannedJob> jobs;
+    if (isMatrix) {
+        jobs = BuildMatrix::expand(options, axes, projectPath);
+        // As many combinations as cores and memory allow; jobs sharing a build dir still run one after another
+        executor.setMaxConcurrentJobs(BuildMatrix::recommendedConcurrentJobs(4, 4096));
+    } else {
+        jobs = BuildPlanner::plan(options, projectPath, targetPath);
+    }
+    if (jobs.isEmpty()) {
+        return usageError("nothing to build for the selected options");
+    }
+
+    QTimer::singleShot(0, &a, [&]() {
+        matrix.begin();
+        for (const PlannedJob& job : jobs) {
+            int jobId = executor.enqueueJob(job.name, job.nodes, job.copyTasks, job.delTasks, job.workDir, isRemote);
+            if (jobId < 0) {
+                hasFailedJob = true;
+            } else if (isMatrix) {
+                matrix.addJob(jobId, job);
+            }
+        }
+        // Every job was rejected or finished while queueing: nothing more will report back
+        if (!executor.isExecuting()) {
+            finish();
+        }
+    });
+
+    return a.exec();
+}
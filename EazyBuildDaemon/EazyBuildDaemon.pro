@@ -0,0 +1,65 @@
+QT = core network concurrent
+
+CONFIG += c++17 cmdline
+
+TARGET = eazybuild-daemon
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Build engine shared with the GUI (no QtWidgets dependency)
+INCLUDEPATH += ..
+
+SOURCES += \
+    ../artifactcache.cpp \
+    ../builddaemon.cpp \
+    ../buildplanner.cpp \
+    ../buildtimings.cpp \
+    ../buildtrace.cpp \
+    ../cmakegenerator.cpp \
+    ../commandexecutor.cpp \
+    ../commandline.cpp \
+    ../compilercache.cpp \
+    ../configurecache.cpp \
+    ../diagnostics.cpp \
+    ../errorscanner.cpp \
+    ../jobserver.cpp \
+    ../logarchive.cpp \
+    ../logwriter.cpp \
+    ../outputcapture.cpp \
+    ../processtree.cpp \
+    ../remotefilesender.cpp \
+    ../resourceusage.cpp \
+    ../sourcechangetracker.cpp \
+    main.cpp
+
+HEADERS += \
+    ../artifactcache.h \
+    ../builddaemon.h \
+    ../buildplanner.h \
+    ../buildtimings.h \
+    ../buildtrace.h \
+    ../cmakegenerator.h \
+    ../commandexecutor.h \
+    ../commandline.h \
+    ../compilercache.h \
+    ../configurecache.h \
+    ../diagnostics.h \
+    ../errorscanner.h \
+    ../jobserver.h \
+    ../logarchive.h \
+    ../logwriter.h \
+    ../outputcapture.h \
+    ../processtree.h \
+    ../remotefilesender.h \
+    ../resourceusage.h \
+    ../sourcechangetracker.h
+
+DEFINES += \
+    QT_NO_PROCESS_COMBINED_ARGUMENT_START
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
@@ -0,0 +1,56 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <cstdio>
+#include "builddaemon.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("eazybuild-daemon");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Resident EazyBuild service: accepts build requests from eazybuild-cli --daemon and other local clients");
+    parser.addHelpOption();
+
+    QCommandLineOption nameOption("name", "Local socket name (default: " + BuildDaemon::defaultServerName() + ").", "name", BuildDaemon::defaultServerName());
+    QCommandLineOption jobsOption({"j", "jobs"}, "Core budget shared by all parallel builds (default: all cores).", "n");
+    QCommandLineOption noConfigureCacheOption("no-configure-cache", "Always run the configure step.");
+    QCommandLineOption noArtifactCacheOption("no-artifact-cache", "Do not restore or store artifacts in the artifact cache.");
+    QCommandLineOption logFileOption("log-file", "Write the detailed execution log to this file.", "path");
+    QCommandLineOption noBuildTimingsOption("no-build-timings", "Do not rank the slowest targets and translation units after each build.");
+    QCommandLineOption noTraceOption("no-trace", "Do not write the build trace (eazybuild_trace_*.json next to the log, for chrome://tracing or Perfetto).");
+
+    parser.addOptions({nameOption, jobsOption, noConfigureCacheOption, noArtifactCacheOption, logFileOption, noBuildTimingsOption, noTraceOption});
+    parser.process(a);
+
+    BuildDaemon daemon;
+    CommandExecutor* executor = daemon.executor();
+    if (parser.isSet(jobsOption)) {
+        bool isNumber = false;
+        int cores = parser.value(jobsOption).toInt(&isNumber);
+        if (!isNumber || cores < 1) {
+            fprintf(stderr, "eazybuild-daemon: invalid --jobs: %s\n", parser.value(jobsOption).toLocal8Bit().constData());
+            return 2;
+        }
+        executor->setCpuBudget(cores);
+    }
+    executor->setConfigureCacheEnabled(!parser.isSet(noConfigureCacheOption));
+    executor->setArtifactCacheEnabled(!parser.isSet(noArtifactCacheOption));
+    executor->setTraceEnabled(!parser.isSet(noTraceOption));
+    executor->setBuildTimingsEnabled(!parser.isSet(noBuildTimingsOption));
+    if (parser.isSet(logFileOption)) {
+        executor->setLogFilePath(QDir(parser.value(logFileOption)).absolutePath());
+    }
+
+    QString errorMsg;
+    if (!daemon.listen(parser.value(nameOption), errorMsg)) {
+        fprintf(stderr, "eazybuild-daemon: %s\n", errorMsg.toLocal8Bit().constData());
+        return 1;
+    }
+    fprintf(stdout, "eazybuild-daemon: listening on %s\n", parser.value(nameOption).toLocal8Bit().constData());
+    fflush(stdout);
+
+    QObject::connect(&daemon, &BuildDaemon::shutdownRequested, &a, &QCoreApplication::quit, Qt::QueuedConnection);
+    return a.exec();
+}
@@ -0,0 +1,252 @@
+#include "artifactcache.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QTemporaryFile>
+
+ArtifactCache::ArtifactCache(const QString& rootDir)
+    : m_rootDir(rootDir)
+    , m_budgetBytes(qint64(10) * 1024 * 1024 * 1024)
+{
+    if (m_rootDir.isEmpty())
+    {
+        QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+        if (cacheLocation.isEmpty())
+        {
+            cacheLocation = QDir::homePath() + "/.cache";
+        }
+        m_rootDir = cacheLocation + "/EazyBuild/artifacts";
+    }
+}
+
+// Relative path + size + mtime of every source file (sorted for a stable digest)
+QByteArray ArtifactCache::sourceTreeState(const QString& sourceDir)
+{
+    QDir root(sourceDir);
+    QStringList entries;
+    QDirIterator it(sourceDir, QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        QString relativePath = root.relativeFilePath(it.filePath());
+
+        // Skip build output, VCS and IDE folders (they change with every build)
+        bool excluded = false;
+        const QStringList parts = relativePath.split('/');
+        for (int i = 0; i < parts.size() - 1; ++i)
+        {
+            const QString& part = parts[i];
+            if (part.startsWith("cmake_build_") || part == ".git" || part == ".vs" || part == ".svn")
+            {
+                excluded = true;
+                break;
+            }
+        }
+        if (excluded) continue;
+
+        QFileInfo info = it.fileInfo();
+        entries << QString("%1|%2|%3").arg(relativePath).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+    }
+    entries.sort();
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (const QString& entry : qAsConst(entries))
+    {
+        hash.addData(entry.toUtf8());
+        hash.addData("\n", 1);
+    }
+    return hash.result();
+}
+
+// Key = tree state + options
+QString ArtifactCache::computeKey(const QByteArray& treeState, const QStringList& options)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(treeState);
+    for (const QString& option : options)
+    {
+        hash.addData(option.trimmed().toUtf8());
+        hash.addData("\n", 1);
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+// Restore every artifact of a manifest (all or nothing)
+bool ArtifactCache::restore(const QString& key, const QStringList& artifactPaths, QString& errorMsg)
+{
+    QFile manifestFile(manifestPath(key));
+    if (!manifestFile.open(QIODevice::ReadOnly))
+    {
+        errorMsg = "Cache miss";
+        return false;
+    }
+    QJsonObject manifest = QJsonDocument::fromJson(manifestFile.readAll()).object();
+    manifestFile.close();
+
+    // Verify every blob before touching the build dir
+    QStringList blobs;
+    for (const QString& artifactPath : artifactPaths)
+    {
+        QString fileName = QFileInfo(artifactPath).fileName();
+        QString contentHash = manifest.value(fileName).toString();
+        if (contentHash.isEmpty() || !QFile::exists(blobPath(contentHash)))
+        {
+            errorMsg = QString("Cache entry incomplete: %1").arg(fileName);
+            return false;
+        }
+        blobs << blobPath(contentHash);
+    }
+
+    for (int i = 0; i < artifactPaths.size(); ++i)
+    {
+        QString targetPath = artifactPaths[i];
+        QDir().mkpath(QFileInfo(targetPath).absolutePath());
+        QFile::remove(targetPath);
+        if (!QFile::copy(blobs[i], targetPath))
+        {
+            errorMsg = QString("Failed to restore %1").arg(targetPath);
+            return false;
+        }
+    }
+
+    // Touch manifest (records last use of the entry)
+    manifestFile.open(QIODevice::ReadWrite);
+    manifestFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return true;
+}
+
+// Store artifacts as content-addressed blobs and write the manifest
+bool ArtifactCache::store(const QString& key, const QStringList& artifactPaths, QString& errorMsg)
+{
+    QJsonObject manifest;
+    for (const QString& artifactPath : artifactPaths)
+    {
+        QFile artifact(artifactPath);
+        if (!artifact.open(QIODevice::ReadOnly))
+        {
+            errorMsg = QString("Artifact not found: %1").arg(artifactPath);
+            return false;
+        }
+
+        // The copy is hashed, not the artifact: a rebuild overwriting it meanwhile cannot get a wrong blob
+        // Temporary blobs end in ".tmp" so readers never see partial blobs and evict() leaves them alone
+        QDir().mkpath(m_rootDir + "/blobs");
+        QTemporaryFile tempBlob(m_rootDir + "/blobs/XXXXXX.tmp");
+        if (!tempBlob.open())
+        {
+            errorMsg = QString("Failed to store %1: %2").arg(artifactPath, tempBlob.errorString());
+            return false;
+        }
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        while (!artifact.atEnd())
+        {
+            QByteArray block = artifact.read(1024 * 1024);
+            if (block.isEmpty() || tempBlob.write(block) != block.size())
+            {
+                errorMsg = QString("Failed to store %1").arg(artifactPath);
+                return false;
+            }
+            hash.addData(block);
+        }
+        tempBlob.close();
+
+        QString contentHash = QString::fromLatin1(hash.result().toHex());
+        QString blob = blobPath(contentHash);
+        if (!QFile::exists(blob))
+        {
+            QDir().mkpath(QFileInfo(blob).absolutePath());
+            // A renamed temporary file is still removed on destruction unless told otherwise
+            tempBlob.setAutoRemove(false);
+            if (!tempBlob.rename(blob))
+            {
+                tempBlob.remove();
+                errorMsg = QString("Failed to store %1").arg(artifactPath);
+                return false;
+            }
+        }
+        manifest.insert(QFileInfo(artifactPath).fileName(), contentHash);
+    }
+
+    // Written atomically: a restore never reads half a manifest
+    QDir().mkpath(m_rootDir + "/keys");
+    QSaveFile manifestFile(manifestPath(key));
+    if (!manifestFile.open(QIODevice::WriteOnly)
+        || manifestFile.write(QJsonDocument(manifest).toJson(QJsonDocument::Compact)) < 0
+        || !manifestFile.commit())
+    {
+        errorMsg = manifestFile.errorString();
+        return false;
+    }
+
+    evict();
+    return true;
+}
+
+// Newest manifests keep their blobs while they fit; the rest are deleted, then every unreferenced blob
+int ArtifactCache::evict()
+{
+    if (m_budgetBytes <= 0) return 0;
+
+    QFileInfoList manifests = QDir(m_rootDir + "/keys").entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Time);
+    QSet<QString> keptBlobs;
+    qint64 total = 0;
+    int deleted = 0;
+    for (const QFileInfo& manifestInfo : qAsConst(manifests))
+    {
+        QFile manifestFile(manifestInfo.absoluteFilePath());
+        if (!manifestFile.open(QIODevice::ReadOnly)) continue;
+        QJsonObject manifest = QJsonDocument::fromJson(manifestFile.readAll()).object();
+        manifestFile.close();
+
+        // Blobs already counted for a newer entry cost nothing more
+        QStringList newBlobs;
+        qint64 entryBytes = 0;
+        for (auto it = manifest.constBegin(); it != manifest.constEnd(); ++it)
+        {
+            QString contentHash = it.value().toString();
+            if (contentHash.isEmpty() || keptBlobs.contains(contentHash)) continue;
+            newBlobs << contentHash;
+            entryBytes += QFileInfo(blobPath(contentHash)).size();
+        }
+
+        if (total + entryBytes <= m_budgetBytes)
+        {
+            total += entryBytes;
+            for (const QString& contentHash : qAsConst(newBlobs)) keptBlobs.insert(contentHash);
+        }
+        else if (manifestFile.remove())
+        {
+            deleted++;
+        }
+    }
+    if (deleted == 0) return 0;
+
+    QDirIterator it(m_rootDir + "/blobs", QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        it.next();
+        // Temporary blobs are being stored right now
+        if (it.fileName().endsWith(".tmp") || keptBlobs.contains(it.fileName())) continue;
+        QFile::remove(it.filePath());
+    }
+    return deleted;
+}
+
+QString ArtifactCache::manifestPath(const QString& key) const
+{
+    return m_rootDir + "/keys/" + key + ".json";
+}
+
+QString ArtifactCache::blobPath(const QString& contentHash) const
+{
+    return m_rootDir + "/blobs/" + contentHash.left(2) + "/" + contentHash;
+}
@@ -0,0 +1,82 @@
+#ifndef ARTIFACTCACHE_H
+#define ARTIFACTCACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+
+/**
+ * @brief Local content-addressed cache of build artifacts (DLLs, executables)
+ * @note Key = hash of source tree state + build options; value = manifest of artifact blobs
+ * @note Layout: <root>/blobs/<2 hex>/<sha256> (file contents), <root>/keys/<key>.json (manifests)
+ * @note Size-bounded: least recently used entries (manifest mtime, touched on restore) are evicted after each store
+ */
+class ArtifactCache
+{
+public:
+    /**
+     * @brief Constructor
+     * @param rootDir Cache directory (empty = per-user cache location)
+     */
+    explicit ArtifactCache(const QString& rootDir = "");
+
+    /**
+     * @brief Compute state of a source tree (relative path, size and mtime of every file)
+     * @param sourceDir Source root
+     * @return SHA-256 digest of the sorted file list
+     * @note Build output (cmake_build_*), VCS and IDE folders are excluded
+     */
+    static QByteArray sourceTreeState(const QString& sourceDir);
+
+    /**
+     * @brief Compute cache key from source tree state and build options
+     * @param treeState Result of sourceTreeState
+     * @param options Build options (configure/build command lines, SOC_TYPE, firmware, UNIQ, PVR, STAT, ...)
+     * @return Hex SHA-256 key
+     */
+    static QString computeKey(const QByteArray& treeState, const QStringList& options);
+
+    /**
+     * @brief Restore artifacts of a key into their build locations
+     * @param key Cache key
+     * @param artifactPaths Absolute target paths (file names must match the stored manifest)
+     * @param errorMsg Filled with a description when restore is impossible
+     * @return True = cache hit, every artifact was restored
+     */
+    bool restore(const QString& key, const QStringList& artifactPaths, QString& errorMsg);
+
+    /**
+     * @brief Store artifacts under a key (blobs are deduplicated by content hash)
+     * @param key Cache key
+     * @param artifactPaths Absolute paths of freshly built artifacts
+     * @param errorMsg Filled with a description when storing fails
+     * @return True = manifest written
+     * @note Reads and writes only files under the root: safe on a worker thread while restores run elsewhere
+     *       (an entry being stored is simply not found yet)
+     */
+    bool store(const QString& key, const QStringList& artifactPaths, QString& errorMsg);
+
+    /**
+     * @brief Set the disk budget of the cache
+     * @param budgetBytes Total size of all blobs kept (0 = unlimited, default 10 GB)
+     */
+    void setBudget(qint64 budgetBytes) { m_budgetBytes = budgetBytes; }
+
+    /**
+     * @brief Delete least recently used entries until the blobs fit into the budget
+     * @return Number of deleted manifests
+     * @note Blobs shared by several entries stay until their last entry is evicted
+     */
+    int evict();
+
+    QString rootDir() const { return m_rootDir; }
+
+private:
+    QString manifestPath(const QString& key) const;
+    QString blobPath(const QString& contentHash) const;
+
+    QString m_rootDir;
+    qint64  m_budgetBytes;
+};
+
+#endif // ARTIFACTCACHE_H
@@ -0,0 +1,381 @@
+#include "builddaemon.h"
+#include "buildplanner.h"
+#include "sourcechangetracker.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaEnum>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSettings>
+#include <QDir>
+
+// Finished jobs remembered for "status" (older records are dropped)
+static const int MAX_JOB_RECORDS = 200;
+// Log events are dropped for a client that stopped reading once this much output is pending
+static const qint64 MAX_PENDING_CLIENT_BYTES = 32 * 1024 * 1024;
+
+BuildDaemon::BuildDaemon(QObject *parent)
+    : QObject(parent)
+    , m_server(new QLocalServer(this))
+    , m_executor(new CommandExecutor(this))
+    , m_changeTracker(new SourceChangeTracker(this))
+{
+    // Same component subtrees as the GUI
+    QSettings trackerSettings("EazyBuild", "ChangeTracker");
+    m_changeTracker->setComponentPaths("UMD", trackerSettings.value("UMD", QStringList() << "umd").toStringList());
+    m_changeTracker->setComponentPaths("KMD", trackerSettings.value("KMD", QStringList() << "kmd").toStringList());
+    m_changeTracker->setComponentPaths("Panel", trackerSettings.value("Panel", QStringList() << "tools/fantasypanel").toStringList());
+
+    connect(m_server, &QLocalServer::newConnection, this, &BuildDaemon::onNewConnection);
+
+    connect(m_executor, &CommandExecutor::logUpdated, this, [this](const QString& logContent, bool isError) {
+        QJsonObject event;
+        event["event"] = "log";
+        event["text"]  = logContent;
+        event["error"] = isError;
+        publish(event);
+    });
+
+    connect(m_executor, &CommandExecutor::jobStatusChanged, this, [this](int jobId, const QString& jobName, CommandExecutor::JobStatus status) {
+        JobRecord& record = m_jobRecords[jobId];
+        record.name   = jobName;
+        record.status = status;
+
+        QJsonObject event;
+        event["event"]  = "job";
+        event["id"]     = jobId;
+        event["name"]   = jobName;
+        event["status"] = statusName(status);
+        publish(event, jobId);
+    });
+
+    // Remember successful chains so unchanged components can be skipped by later requests
+    connect(m_executor, &CommandExecutor::chainSucceeded, this, [this](int jobId, const QString& chain) {
+        QString buildKey = m_chainBuildKeys.value(jobId).value(chain);
+        if (!buildKey.isEmpty()) {
+            m_changeTracker->markBuilt(buildKey, m_jobStartSequence.value(jobId));
+        }
+    });
+
+    connect(m_executor, &CommandExecutor::jobFinished, this, [this](int jobId, const QString& jobName, bool success, const QString&, const QString& stderrLog) {
+        m_chainBuildKeys.remove(jobId);
+        m_jobStartSequence.remove(jobId);
+        qint64 durationMs = m_executor->jobDurationMs(jobId);
+        m_jobRecords[jobId].durationMs = durationMs;
+
+        QJsonObject event;
+        event["event"]      = "jobFinished";
+        event["id"]         = jobId;
+        event["name"]       = jobName;
+        event["success"]    = success;
+        event["durationMs"] = durationMs;
+        event["stderr"]     = stderrLog;
+        publish(event, jobId);
+
+        for (Client& client : m_clients) {
+            client.jobIds.remove(jobId);
+        }
+
+        // Drop the oldest finished records (ids grow, so QMap order is queue order)
+        while (m_jobRecords.size() > MAX_JOB_RECORDS) {
+            auto oldest = m_jobRecords.begin();
+            if (oldest.value().status == CommandExecutor::JobQueued || oldest.value().status == CommandExecutor::JobRunning) break;
+            m_jobRecords.erase(oldest);
+        }
+    });
+
+    connect(m_executor, &CommandExecutor::commandFinished, this, [this](bool success, const QString&, const QString&, const ResourceUsage& usage) {
+        QJsonObject event;
+        event["event"]   = "idle";
+        event["success"] = success;
+        event["compilerCache"] = m_executor->compilerCacheSummary();
+        event["errors"]        = m_executor->diagnostics()->errorCount();
+        event["warnings"]      = m_executor->diagnostics()->warningCount();
+        event["resources"]     = usage.toJson();
+        for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+            if (it.value().isSubscribed) {
+                send(it.key(), event);
+            }
+        }
+    });
+}
+
+BuildDaemon::~BuildDaemon()
+{
+    m_executor->stopExecution();
+}
+
+QString BuildDaemon::defaultServerName()
+{
+    QString user = qEnvironmentVariable("USER", qEnvironmentVariable("USERNAME"));
+    return user.isEmpty() ? "eazybuild-daemon" : "eazybuild-daemon-" + user;
+}
+
+bool BuildDaemon::listen(const QString& serverName, QString& errorMsg)
+{
+    // Only the owning user may submit builds
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (m_server->listen(serverName)) return true;
+
+    if (m_server->serverError() == QAbstractSocket::AddressInUseError) {
+        QLocalSocket probe;
+        probe.connectToServer(serverName);
+        if (probe.waitForConnected(1000)) {
+            errorMsg = "another daemon is already listening on " + serverName;
+            return false;
+        }
+        // Socket file left behind by a daemon that did not shut down cleanly
+        QLocalServer::removeServer(serverName);
+        if (m_server->listen(serverName)) return true;
+    }
+
+    errorMsg = m_server->errorString();
+    return false;
+}
+
+void BuildDaemon::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        m_clients.insert(socket, Client());
+        connect(socket, &QLocalSocket::readyRead, this, &BuildDaemon::onClientReadyRead);
+        connect(socket, &QLocalSocket::disconnected, this, &BuildDaemon::onClientDisconnected);
+    }
+}
+
+// Split the stream into lines, one request per line
+void BuildDaemon::onClientReadyRead()
+{
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    if (!socket || !m_clients.contains(socket)) return;
+
+    m_clients[socket].buffer.append(socket->readAll());
+    for (;;) {
+        // Re-fetched every round: a request may disconnect the client
+        auto it = m_clients.find(socket);
+        if (it == m_clients.end()) return;
+        int newline = it.value().buffer.indexOf('\n');
+        if (newline < 0) return;
+
+        QByteArray line = it.value().buffer.left(newline).trimmed();
+        it.value().buffer.remove(0, newline + 1);
+        if (line.isEmpty()) continue;
+
+        QJsonParseError parseError;
+        QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+            QJsonObject reply;
+            reply["event"]   = "error";
+            reply["message"] = "malformed request: " + parseError.errorString();
+            send(socket, reply);
+            continue;
+        }
+        handleRequest(socket, document.object());
+    }
+}
+
+// Jobs of a disconnected client keep running (fire-and-forget submissions)
+void BuildDaemon::onClientDisconnected()
+{
+    QLocalSocket* socket = qobject_cast<QLocalSocket*>(sender());
+    if (!socket) return;
+    m_clients.remove(socket);
+    if (m_enqueuingClient == socket) {
+        m_enqueuingClient = nullptr;
+    }
+    socket->deleteLater();
+}
+
+void BuildDaemon::handleRequest(QLocalSocket* socket, const QJsonObject& request)
+{
+    QString type = request.value("request").toString();
+    QJsonObject reply;
+
+    if (type == "build") {
+        handleBuild(socket, request);
+        return;
+    } else if (type == "status") {
+        reply = statusReply();
+    } else if (type == "cancel") {
+        int jobId = request.value("job").toInt(-1);
+        m_executor->cancelJob(jobId);
+        reply["event"] = "cancelled";
+        reply["job"]   = jobId;
+    } else if (type == "subscribe") {
+        m_clients[socket].isSubscribed = true;
+        reply["event"] = "subscribed";
+    } else if (type == "shutdown") {
+        m_executor->stopExecution();
+        reply["event"] = "shutdown";
+        send(socket, reply);
+        socket->flush();
+        emit shutdownRequested();
+        return;
+    } else {
+        reply["event"]   = "error";
+        reply["message"] = "unknown request: " + type;
+    }
+    send(socket, reply);
+}
+
+void BuildDaemon::handleBuild(QLocalSocket* socket, const QJsonObject& request)
+{
+    auto replyError = [this, socket](const QString& message) {
+        QJsonObject reply;
+        reply["event"]   = "error";
+        reply["message"] = message;
+        send(socket, reply);
+    };
+
+    BuildOptions options;
+    QString errorMsg;
+    if (!BuildPlanner::optionsFromJson(request.value("options").toObject(), options, errorMsg)) {
+        replyError(errorMsg);
+        return;
+    }
+
+    QString projectPath = QDir::cleanPath(request.value("project").toString());
+    if (projectPath.isEmpty() || !QFileInfo(projectPath).isDir()) {
+        replyError("project directory does not exist: " + projectPath);
+        return;
+    }
+    QString targetPath = QDir::cleanPath(request.value("target").toString());
+    if (options.autoReplace && targetPath.isEmpty()) {
+        replyError("target is required when autoReplace is set");
+        return;
+    }
+
+    bool isRemote = request.contains("remoteHost");
+    if (isRemote) {
+        if (!options.autoReplace || request.value("remotePath").toString().isEmpty()) {
+            replyError("remoteHost requires autoReplace and remotePath");
+            return;
+        }
+        // Jobs keep the remote settings they were queued with: other clients' queued jobs are unaffected
+        m_executor->setRemoteHost(request.value("remoteHost").toString());
+        m_executor->setRemotePath(request.value("remotePath").toString());
+    }
+
+    // Counters are sampled per batch; the latest request decides which cache is sampled
+    m_executor->setCompilerLauncher(options.compilerLauncher);
+    // Like the remote settings, fail-fast is captured per job when it is queued
+    m_executor->setFailFastEnabled(request.value("failFast").toBool(false));
+
+    // The first request for a project is a full build; later ones reuse the change history
+    if (m_changeTracker->root() != projectPath) {
+        m_changeTracker->setRoot(projectPath);
+    }
+    m_changeTracker->flushPendingEvents();
+
+    bool isSkipUnchanged = request.value("skipUnchanged").toBool(true);
+    QList<PlannedJob> jobs = BuildPlanner::plan(options, projectPath, targetPath,
+        [this, isSkipUnchanged](const QString& component, const QString& chain, const QString& buildKey, const QStringList& artifacts) {
+            if (!isSkipUnchanged || !skipUnchangedChain(component, buildKey, artifacts)) return false;
+            QJsonObject event;
+            event["event"] = "log";
+            event["text"]  = QString("%1 [%2] ⏭️ %3 sources unchanged since last successful build, skipped\n")
+                                .arg(QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]"), chain, component);
+            event["error"] = false;
+            publish(event);
+            return true;
+        },
+        [this](const QString& dir) { return m_changeTracker->treeStateOf(dir); });
+
+    // Events raised while queueing (cache restores can finish a job right away) go to this client too
+    m_enqueuingClient = socket;
+    QList<int> jobIds;
+    for (const PlannedJob& job : jobs) {
+        int jobId = m_executor->enqueueJob(job.name, job.nodes, job.copyTasks, job.delTasks, job.workDir, isRemote);
+        if (jobId < 0) continue;
+        jobIds << jobId;
+        if (!job.chainKeys.isEmpty()) {
+            m_chainBuildKeys.insert(jobId, job.chainKeys);
+            // Edits made while the job runs stay pending for the next request
+            m_jobStartSequence.insert(jobId, m_changeTracker->currentSequence());
+        }
+    }
+    m_enqueuingClient = nullptr;
+    if (!m_clients.contains(socket)) return;
+
+    QJsonArray acceptedJobs;
+    for (int jobId : jobIds) {
+        const JobRecord record = m_jobRecords.value(jobId);
+        if (record.status == CommandExecutor::JobQueued || record.status == CommandExecutor::JobRunning) {
+            m_clients[socket].jobIds.insert(jobId);
+        }
+        QJsonObject acceptedJob;
+        acceptedJob["id"]     = jobId;
+        acceptedJob["name"]   = record.name;
+        acceptedJob["status"] = statusName(record.status);
+        acceptedJobs.append(acceptedJob);
+    }
+
+    QJsonObject reply;
+    reply["event"] = "accepted";
+    reply["jobs"]  = acceptedJobs;
+    if (jobs.isEmpty()) {
+        reply["message"] = "All selected components are up to date";
+    } else if (jobIds.isEmpty()) {
+        reply["event"]   = "error";
+        reply["message"] = "every job was rejected (see log)";
+    }
+    send(socket, reply);
+}
+
+QJsonObject BuildDaemon::statusReply() const
+{
+    QJsonArray jobs;
+    for (auto it = m_jobRecords.constBegin(); it != m_jobRecords.constEnd(); ++it) {
+        QJsonObject job;
+        job["id"]         = it.key();
+        job["name"]       = it.value().name;
+        job["status"]     = statusName(it.value().status);
+        job["durationMs"] = it.value().durationMs;
+        jobs.append(job);
+    }
+
+    QJsonObject reply;
+    reply["event"]     = "status";
+    reply["executing"] = m_executor->isExecuting();
+    reply["project"]   = m_changeTracker->root();
+    reply["reliable"]  = m_changeTracker->isReliable();
+    reply["jobs"]      = jobs;
+    return reply;
+}
+
+
+bool BuildDaemon::skipUnchangedChain(const QString& component, const QString& buildKey, const QStringList& artifacts) const
+{
+    if (m_changeTracker->hasChangesSince(component, buildKey)) return false;
+    for (const QString& artifact : artifacts) {
+        if (!QFileInfo::exists(artifact)) return false;
+    }
+    return true;
+}
+
+void BuildDaemon::publish(const QJsonObject& event, int jobId)
+{
+    bool isLog = event.value("event").toString() == "log";
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        const Client& client = it.value();
+        bool isOwner = jobId >= 0 ? client.jobIds.contains(jobId) : !client.jobIds.isEmpty();
+        if (!client.isSubscribed && !isOwner && it.key() != m_enqueuingClient) continue;
+        // A client that stopped reading must not grow the daemon without bound
+        if (isLog && it.key()->bytesToWrite() > MAX_PENDING_CLIENT_BYTES) continue;
+        send(it.key(), event);
+    }
+}
+
+void BuildDaemon::send(QLocalSocket* socket, const QJsonObject& message)
+{
+    socket->write(QJsonDocument(message).toJson(QJsonDocument::Compact));
+    socket->write("\n", 1);
+}
+
+// "JobRunning" -> "running"
+QString BuildDaemon::statusName(CommandExecutor::JobStatus status)
+{
+    QString key = QMetaEnum::fromType<CommandExecutor::JobStatus>().valueToKey(status);
+    return key.mid(3).toLower();
+}
@@ -0,0 +1,111 @@
+#ifndef BUILDDAEMON_H
+#define BUILDDAEMON_H
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QByteArray>
+#include <QJsonObject>
+#include "commandexecutor.h"
+
+class QLocalServer;
+class QLocalSocket;
+class SourceChangeTracker;
+
+/**
+ * @brief Long-running build service around one CommandExecutor, reachable over a local socket
+ * @note Warm state survives between requests: configure fingerprints (executor), source change
+ *       history (SourceChangeTracker) and artifact cache tree states of unchanged source dirs
+ * @note Protocol: one compact JSON object per line (UTF-8) in both directions
+ *
+ * Requests (client -> daemon), field "request":
+ *   build     {project, target, options (BuildPlanner::optionsToJson), skipUnchanged, failFast, remoteHost, remotePath}
+ *             -> accepted {jobs: [{id, name, status}]} or error {message}
+ *   status    -> status {executing, project, reliable, jobs: [{id, name, status, durationMs}]}
+ *   cancel    {job} -> cancelled {job}
+ *   subscribe -> every following log/job event, not only those of the client's own builds
+ *   shutdown  -> running jobs are stopped and the daemon exits
+ *
+ * Events (daemon -> client), field "event":
+ *   log {text, error}, job {id, name, status}, jobFinished {id, name, success, durationMs, stderr}, idle {success, compilerCache, errors, warnings}
+ */
+class BuildDaemon : public QObject
+{
+    Q_OBJECT
+public:
+    explicit BuildDaemon(QObject *parent = nullptr);
+    ~BuildDaemon();
+
+    /**
+     * @brief Default local server name (per user, so several users can run their own daemon)
+     */
+    static QString defaultServerName();
+
+    /**
+     * @brief Start accepting clients
+     * @param serverName Local server name (a stale socket of a crashed daemon is removed)
+     * @param errorMsg Filled with a description when listening fails
+     * @return False = name is in use by a live daemon or the socket cannot be created
+     */
+    bool listen(const QString& serverName, QString& errorMsg);
+
+    CommandExecutor* executor() const { return m_executor; }
+
+signals:
+    /**
+     * @brief Emitted when a client sent "shutdown" (running jobs are already stopped)
+     */
+    void shutdownRequested();
+
+private slots:
+    void onNewConnection();
+    void onClientReadyRead();
+    void onClientDisconnected();
+
+private:
+    // One connected client
+    struct Client
+    {
+        QByteArray buffer;              // Bytes received after the last complete line
+        QSet<int>  jobIds;              // Unfinished jobs submitted by this client
+        bool       isSubscribed = false; // True = receives events of every job
+    };
+
+    // Known job (kept after it finished so "status" can report it)
+    struct JobRecord
+    {
+        QString                    name;
+        CommandExecutor::JobStatus status = CommandExecutor::JobQueued;
+        qint64                     durationMs = 0;
+    };
+
+    void handleRequest(QLocalSocket* socket, const QJsonObject& request);
+    void handleBuild(QLocalSocket* socket, const QJsonObject& request);
+    QJsonObject statusReply() const;
+
+
+    /**
+     * @brief Drop a chain whose component sources are unchanged since its last successful build
+     */
+    bool skipUnchangedChain(const QString& component, const QString& buildKey, const QStringList& artifacts) const;
+
+    /**
+     * @brief Send an event to subscribers and to the clients owning the job
+     * @param jobId Job the event belongs to (-1 = every client with an unfinished job)
+     */
+    void publish(const QJsonObject& event, int jobId = -1);
+    void send(QLocalSocket* socket, const QJsonObject& message);
+    static QString statusName(CommandExecutor::JobStatus status);
+
+    QLocalServer*        m_server;
+    CommandExecutor*     m_executor;
+    SourceChangeTracker* m_changeTracker;
+    QHash<QLocalSocket*, Client> m_clients;
+    QLocalSocket*        m_enqueuingClient = nullptr;  // Client whose build is being queued (owns events raised meanwhile)
+    QMap<int, JobRecord> m_jobRecords;                 // Job id -> record (oldest finished records are dropped)
+    QHash<int, QHash<QString, QString>> m_chainBuildKeys; // Job id -> (chain -> build key)
+    QHash<int, quint64>  m_jobStartSequence;           // Job id -> change sequence when the job was queued
+};
+
+#endif // BUILDDAEMON_H
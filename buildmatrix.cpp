@@ -0,0 +1,199 @@
+#include "buildmatrix.h"
+#include <QFile>
+#include <QSet>
+#include <QThread>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+static QString configName(BuildOptions::BuildConfig config)
+{
+    return config == BuildOptions::Debug ? "Debug" : "Release";
+}
+
+static QString firmwareName(BuildOptions::FirmwareVersion firmware)
+{
+    return firmware == BuildOptions::Firmware116 ? "FW116" : "FW119";
+}
+
+QList<PlannedJob> BuildMatrix::expand(const BuildOptions& base, const MatrixAxes& axes, const QString& projectPath)
+{
+    QList<PlannedJob> jobs;
+    QSet<QString>     plannedNames;
+
+    // Both bitnesses build in one job (separate build dirs, concurrent chains, one KMD build)
+    BuildOptions::Bit bit = BuildOptions::Bit64;
+    QString bitName = "64";
+    if (axes.bits.contains(BuildOptions::Bit32) && axes.bits.contains(BuildOptions::Bit64)) {
+        bit = BuildOptions::AllBit;
+        bitName = "32+64";
+    } else if (axes.bits.contains(BuildOptions::Bit32)) {
+        bit = BuildOptions::Bit32;
+        bitName = "32";
+    }
+
+    for (BuildOptions::GPUModel gpu : axes.gpus) {
+        for (BuildOptions::BuildConfig config : axes.configs) {
+            for (BuildOptions::FirmwareVersion firmware : axes.firmwares) {
+                BuildOptions options = base;
+                options.gpu         = gpu;
+                options.config      = config;
+                options.bit         = bit;
+                options.firmware    = firmware;
+                options.autoReplace = false;                                         // Variants would overwrite each other
+                options.uniq        = base.uniq && firmware != BuildOptions::Firmware116; // UNIQ needs firmware 119
+                if (axes.firmwares.size() > 1) {
+                    options.driverDirSuffix = "_" + firmwareName(firmware).toLower();
+                }
+
+                for (PlannedJob job : BuildPlanner::plan(options, projectPath, QString())) {
+                    bool isPanel = job.name.startsWith("FantasyPanel");
+                    job.name += " " + configName(config);
+                    if (!isPanel) {
+                        job.name += " " + bitName + " " + firmwareName(firmware);
+                    }
+                    // Panel does not depend on bitness or firmware: build it once per model/config
+                    if (plannedNames.contains(job.name)) continue;
+                    plannedNames.insert(job.name);
+                    jobs.append(job);
+                }
+            }
+        }
+    }
+    return jobs;
+}
+
+int BuildMatrix::recommendedConcurrentJobs(int coresPerJob, int memoryPerJobMB)
+{
+    int jobs = qMax(1, QThread::idealThreadCount() / qMax(1, coresPerJob));
+    qint64 memoryMB = availableMemoryMB();
+    if (memoryMB > 0 && memoryPerJobMB > 0) {
+        jobs = qMin<qint64>(jobs, memoryMB / memoryPerJobMB);
+    }
+    return qMax(1, jobs);
+}
+
+qint64 BuildMatrix::availableMemoryMB()
+{
+#if defined(Q_OS_WIN)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (!GlobalMemoryStatusEx(&status)) return -1;
+    return static_cast<qint64>(status.ullAvailPhys / (1024 * 1024));
+#elif defined(Q_OS_LINUX)
+    QFile meminfo("/proc/meminfo");
+    if (!meminfo.open(QIODevice::ReadOnly | QIODevice::Text)) return -1;
+    while (!meminfo.atEnd()) {
+        QString line = QString::fromLatin1(meminfo.readLine());
+        if (line.startsWith("MemAvailable:")) {
+            return line.section(':', 1).trimmed().section(' ', 0, 0).toLongLong() / 1024; // kB -> MB
+        }
+    }
+    return -1;
+#else
+    return -1;
+#endif
+}
+
+void BuildMatrix::begin()
+{
+    m_order.clear();
+    m_rows.clear();
+    m_earlyResults.clear();
+    m_timer.start();
+}
+
+void BuildMatrix::addJob(int jobId, const PlannedJob& job)
+{
+    if (jobId < 0) return;
+
+    Row row;
+    row.name = job.name;
+    for (const CommandNode& node : job.nodes) {
+        if (!node.artifacts.isEmpty()) {
+            row.artifacts << node.artifacts;
+        }
+    }
+    // Chains without known artifacts (KMD) are listed by build dir
+    for (const CommandNode& node : job.nodes) {
+        bool hasArtifacts = false;
+        for (const CommandNode& other : job.nodes) {
+            if (other.chain == node.chain && !other.artifacts.isEmpty()) hasArtifacts = true;
+        }
+        QString buildDir = BuildPlanner::joinPath({job.workDir, node.chain});
+        if (!hasArtifacts && !node.chain.isEmpty() && !row.artifacts.contains(buildDir)) {
+            row.artifacts << buildDir;
+        }
+    }
+
+    if (m_earlyResults.contains(jobId)) {
+        QPair<bool, qint64> result = m_earlyResults.take(jobId);
+        row.state = result.first ? RowPassed : RowFailed;
+        row.durationMs = result.second;
+    }
+
+    m_order.append(jobId);
+    m_rows.insert(jobId, row);
+}
+
+void BuildMatrix::setResult(int jobId, bool success, qint64 durationMs)
+{
+    auto it = m_rows.find(jobId);
+    if (it == m_rows.end()) {
+        m_earlyResults.insert(jobId, qMakePair(success, durationMs));
+        return;
+    }
+    it->state = success ? RowPassed : RowFailed;
+    it->durationMs = durationMs;
+}
+
+int BuildMatrix::passedCount() const
+{
+    int count = 0;
+    for (const Row& row : m_rows) {
+        if (row.state == RowPassed) count++;
+    }
+    return count;
+}
+
+int BuildMatrix::failedCount() const
+{
+    int count = 0;
+    for (const Row& row : m_rows) {
+        if (row.state == RowFailed) count++;
+    }
+    return count;
+}
+
+QString BuildMatrix::formatDuration(qint64 ms)
+{
+    qint64 seconds = ms / 1000;
+    return QString("%1:%2").arg(seconds / 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+QString BuildMatrix::summaryTable() const
+{
+    int nameWidth = 4;
+    for (const Row& row : m_rows) {
+        nameWidth = qMax(nameWidth, row.name.size());
+    }
+
+    QStringList lines;
+    lines << QString("%1  %2  %3  %4").arg(QString("Job"), -nameWidth).arg(QString("Result"), -7).arg(QString("Duration"), -8).arg(QString("Artifacts"));
+    lines << QString(nameWidth + 7 + 8 + 6 + 9, QChar('-'));
+    for (int jobId : m_order) {
+        const Row& row = m_rows[jobId];
+        QString result = row.state == RowPassed ? "PASS" : row.state == RowFailed ? "FAIL" : "SKIP";
+        QString duration = row.state == RowPending ? "-" : formatDuration(row.durationMs);
+        QString firstArtifact = row.artifacts.isEmpty() ? "-" : row.artifacts.first();
+        lines << QString("%1  %2  %3  %4").arg(row.name, -nameWidth).arg(result, -7).arg(duration, -8).arg(firstArtifact);
+        for (int i = 1; i < row.artifacts.size(); ++i) {
+            lines << QString("%1  %2").arg(QString(), nameWidth + 7 + 8 + 4).arg(row.artifacts[i]);
+        }
+    }
+    lines << QString("Total: %1 jobs, %2 passed, %3 failed, wall time %4")
+                 .arg(m_order.size()).arg(passedCount()).arg(failedCount())
+                 .arg(formatDuration(m_timer.isValid() ? m_timer.elapsed() : 0));
+    return lines.join("\n");
+}
@@ -0,0 +1,72 @@
+#ifndef BUILDMATRIX_H
+#define BUILDMATRIX_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QHash>
+#include <QElapsedTimer>
+#include "buildplanner.h"
+
+// Axes of a build matrix (every combination becomes one job)
+struct MatrixAxes
+{
+    QList<BuildOptions::GPUModel>        gpus;
+    QList<BuildOptions::BuildConfig>     configs;
+    QList<BuildOptions::Bit>             bits;       // Bit32/Bit64 (both = one job building both UMD flavours)
+    QList<BuildOptions::FirmwareVersion> firmwares;
+};
+
+// Expands matrix axes into executor jobs and collects their results for one summary table
+class BuildMatrix
+{
+public:
+    // Plan one job per GPU model x config x firmware (Panel jobs are shared across bit/firmware)
+    // Several firmwares get separate UMD/KMD build dirs; artifacts are never copied to the target path
+    static QList<PlannedJob> expand(const BuildOptions& base, const MatrixAxes& axes, const QString& projectPath);
+
+    // Concurrent jobs that fit the machine: min(cores / coresPerJob, available memory / memoryPerJobMB)
+    static int recommendedConcurrentJobs(int coresPerJob, int memoryPerJobMB);
+
+    // Available physical memory in MB (-1 = unknown)
+    static qint64 availableMemoryMB();
+
+    // Start collecting a new batch
+    void begin();
+    void addJob(int jobId, const PlannedJob& job);
+    bool contains(int jobId) const { return m_rows.contains(jobId); }
+    // Results may arrive before addJob (job finished while being queued)
+    void setResult(int jobId, bool success, qint64 durationMs);
+
+    bool isEmpty() const { return m_order.isEmpty(); }
+    int passedCount() const;
+    int failedCount() const;
+
+    // Plain-text table: job, result, duration, artifact paths
+    QString summaryTable() const;
+
+private:
+    enum RowState
+    {
+        RowPending,
+        RowPassed,
+        RowFailed,
+    };
+
+    struct Row
+    {
+        QString     name;
+        QStringList artifacts;
+        RowState    state = RowPending;
+        qint64      durationMs = 0;
+    };
+
+    static QString formatDuration(qint64 ms);
+
+    QList<int>       m_order;   // Job ids in queue order
+    QHash<int, Row>  m_rows;    // Job id -> row
+    QHash<int, QPair<bool, qint64>> m_earlyResults; // Results reported before addJob (success, duration)
+    QElapsedTimer    m_timer;   // Wall time of the whole batch
+};
+
+#endif // BUILDMATRIX_H
@@ -0,0 +1,336 @@
+#include "buildplanner.h"
+#include "artifactcache.h"
+#include "commandline.h"
+
+QList<PlannedJob> BuildPlanner::plan(const BuildOptions& options, const QString& projectPath, const QString& targetPath,
+                                     const ChainFilter& skipChain, const TreeStateProvider& treeStateOf)
+{
+    QList<PlannedJob> jobs;
+    QString         workDir    = projectPath;
+    QString         foldername = "cmake_build_";
+    QString         umdfoldername;
+    QString         umd32foldername;
+    QString         kmdfoldername;
+    QString         panelfoldername;
+    QString         soctype;
+    QString         socname;
+    QString         buildconfig;
+    QString         firmware;
+    QString         UNIQ;
+    QString         procstat;
+    QString         pvrtune;
+    CMakeGenerator  generator(options.generator);
+    QStringList     launcherArgs = generator.compilerLauncherArgs(options.compilerLauncher);
+    QString         bkmd       = "BUILD_KMD=1";
+    QString         conf32     = "CONFIG=wnow32";
+    bool            isGPU      = options.buildType != BuildOptions::FantasyPanel;
+    bool            isPanel    = options.buildType != BuildOptions::GPUDriver;
+    bool            isUMD      = options.driver    != BuildOptions::KMD;
+    bool            isKMD      = options.driver    != BuildOptions::UMD;
+    bool            is32Bit    = options.bit       != BuildOptions::Bit64;
+    bool            is64Bit    = options.bit       != BuildOptions::Bit32;
+
+    // A chain is dropped only when the caller says so (e.g. unchanged sources)
+    auto isSkipped = [&skipChain](const QString& component, const QString& chain, const QString& buildKey, const QStringList& artifacts) {
+        return skipChain && skipChain(component, chain, buildKey, artifacts);
+    };
+    auto treeState = [&treeStateOf](const QString& dir) {
+        return treeStateOf ? treeStateOf(dir) : ArtifactCache::sourceTreeState(dir);
+    };
+
+    switch(options.firmware)
+    {
+    case BuildOptions::Firmware116:
+        firmware = "IMGDDK116=1"; // Remove leading space and -D for later concatenation
+        break;
+    case BuildOptions::Firmware119:
+        firmware = "IMGDDK119=1"; // Remove leading space and -D for later concatenation
+        break;
+    default:
+        break;
+    }
+
+    UNIQ       = options.uniq ? "SUPPORT_UNIQ=1" : "";       // Remove leading space and -D for later concatenation
+    procstat   = options.stat ? "ENABLE_PROCESS_STATS=1" : "";// Remove leading space and -D for later concatenation
+    pvrtune    = options.pvr ? "SUPPORT_PERF=1" : "";        // Remove leading space and -D for later concatenation
+
+    socname         = socName(options.gpu);
+    buildconfig     = options.config == BuildOptions::Debug ? "Debug" : "Release";
+    // Single-config generators get one build dir per config
+    umdfoldername   = generator.buildDir(foldername + "umd_" + socname + options.driverDirSuffix, buildconfig);
+    umd32foldername = generator.buildDir(foldername + "umd_" + socname + options.driverDirSuffix + "_win32", buildconfig);
+    kmdfoldername   = generator.buildDir(foldername + "kmd_" + socname + options.driverDirSuffix, buildconfig);
+    panelfoldername = generator.buildDir(foldername + socname, buildconfig);
+    soctype         = "SOC_TYPE=" + socname;           // Remove leading space and -D for later concatenation
+
+    // ========== GPU Driver Logic ==========
+    if (isGPU) {
+        PlannedJob gpuJob;
+        gpuJob.name    = "GPU Driver " + socname;
+        gpuJob.workDir = workDir;
+
+        // Source tree state is part of every artifact cache key
+        QByteArray gpuTreeState = treeState(workDir);
+
+        // UMD logic (simplified by merging 32/64-bit handling)
+        if (isUMD) {
+            // Define UMD 32/64-bit configuration map using nested QPair
+            // Format: QPair<bool, QPair<QString, QPair<QString, QString>>>
+            //         {isBitEnabled, {buildDir, {extraParams, dllFileName}}}
+            QList<QPair<bool, QPair<QString, QPair<QString, QString>>>> umdConfigs = {
+                qMakePair(is32Bit, qMakePair(umd32foldername, qMakePair(conf32, QString("fantumd32.dll")))),
+                qMakePair(is64Bit, qMakePair(umdfoldername, qMakePair(QString(), QString("fantumd64.dll"))))
+            };
+
+            for (const auto& config : umdConfigs) {
+                bool isBitEnabled = config.first;
+                QString buildDir = config.second.first;
+                QString extraParams = config.second.second.first;
+                QString dllName = config.second.second.second;
+
+                if (isBitEnabled) {
+                    QStringList cmakeConfigureArgs;
+                    cmakeConfigureArgs << "-S." << "-B" << buildDir
+                                       << "-D" << soctype
+                                       << (UNIQ.isEmpty() ? "" : "-D") << UNIQ
+                                       << (firmware.isEmpty() ? "" : "-D") << firmware
+                                       << "-G" << generator.cmakeName()
+                                       << generator.configureArgs(buildconfig)
+                                       << launcherArgs
+                                       << (extraParams.isEmpty() ? "" : "-D") << extraParams;
+                    // Arguments with spaces (generator, paths) are quoted for the executor's tokenizer
+                    QString cmakeConfigureCmd = "cmake " + CommandLine::join(cmakeConfigureArgs);
+
+                    // Independent chain per build dir: configure -> build (DLL is restored from cache on hit)
+                    QString srcFile = joinPath({workDir, generator.artifactPath(buildDir, buildconfig, dllName)});
+                    QString cmakeBuildCmd = generator.buildCommand(buildDir, buildconfig);
+                    QString buildKey = joinPath({workDir, buildDir}) + "|" + cmakeConfigureCmd + "|" + cmakeBuildCmd;
+                    if (!isSkipped("UMD", buildDir, buildKey, QStringList() << srcFile)) {
+                        appendBuildChain(gpuJob.nodes, buildDir, cmakeConfigureCmd, cmakeBuildCmd, gpuTreeState, QStringList() << srcFile);
+                        gpuJob.chainKeys.insert(buildDir, buildKey);
+                    }
+                    // Automatic file copy logic
+                    if (options.autoReplace)
+                    {
+                        gpuJob.copyTasks.append(qMakePair(srcFile, targetPath));
+                    }
+                }
+            }
+        }
+
+        // KMD logic
+        if (isKMD) {
+            // Force delete KMD directory if enabled
+            if (options.forceDeleteKMD) {
+                QString KmdFolder = workDir + "/" + kmdfoldername;
+                gpuJob.delTasks.append(KmdFolder);
+            }
+            QStringList cmakeKmdArgs;
+            cmakeKmdArgs << "-S." << "-B" << kmdfoldername
+                         << "-D" << soctype
+                         << "-D" << bkmd
+                         << (UNIQ.isEmpty() ? "" : "-D") << UNIQ
+                         << (firmware.isEmpty() ? "" : "-D") << firmware
+                         << (pvrtune.isEmpty() ? "" : "-D") << pvrtune
+                         << (procstat.isEmpty() ? "" : "-D") << procstat
+                         << "-G" << generator.cmakeName()
+                         << generator.configureArgs(buildconfig)
+                         << launcherArgs;
+            QString cmakeKmdConfigureCmd = "cmake " + CommandLine::join(cmakeKmdArgs);
+
+            // KMD chain runs concurrently with the UMD chains (a deleted build dir is always rebuilt)
+            QString cmakeKmdBuildCmd = generator.buildCommand(kmdfoldername, buildconfig);
+            QString kmdBuildKey = joinPath({workDir, kmdfoldername}) + "|" + cmakeKmdConfigureCmd + "|" + cmakeKmdBuildCmd;
+            // No single KMD output is copied: the build dir's cache stands in for it
+            QString kmdCacheFile = joinPath({workDir, kmdfoldername, "CMakeCache.txt"});
+            if (options.forceDeleteKMD || !isSkipped("KMD", kmdfoldername, kmdBuildKey, QStringList() << kmdCacheFile)) {
+                appendBuildChain(gpuJob.nodes, kmdfoldername, cmakeKmdConfigureCmd, cmakeKmdBuildCmd);
+                gpuJob.chainKeys.insert(kmdfoldername, kmdBuildKey);
+            }
+        }
+
+        // Queued as its own job so a FantasyPanel job can run side by side
+        if (!gpuJob.nodes.isEmpty() || !gpuJob.copyTasks.isEmpty()) {
+            jobs.append(gpuJob);
+        }
+    }
+
+    // ========== FantasyPanel Logic ==========
+    if (isPanel) {
+        PlannedJob panelJob;
+        panelJob.name = "FantasyPanel " + socname;
+
+        QStringList cmakePanelArgs;
+        cmakePanelArgs << "-S." << "-B" << panelfoldername
+                       << "-D" << soctype
+                       << "-G" << generator.cmakeName()
+                       << generator.configureArgs(buildconfig)
+                       << launcherArgs;
+        QString cmakePanelConfigureCmd = "cmake " + CommandLine::join(cmakePanelArgs);
+        // 1. Update working directory (NOTE: Use temporary variable to avoid polluting original workDir)
+        panelJob.workDir = joinPath({workDir, "tools", "fantasypanel"});
+        // 2. Combine Panel path and additional parameters (keep original comment, adjusted logic)
+        QString srcFile = joinPath({panelJob.workDir, generator.artifactPath(panelfoldername, buildconfig, "FantasyPanel.exe")});
+        // 3. Generate CMake configure -> build chain for Panel (skipped when its sources are unchanged)
+        QString cmakePanelBuildCmd = generator.buildCommand(panelfoldername, buildconfig);
+        QString panelBuildKey = joinPath({panelJob.workDir, panelfoldername}) + "|" + cmakePanelConfigureCmd + "|" + cmakePanelBuildCmd;
+        if (!isSkipped("Panel", panelfoldername, panelBuildKey, QStringList() << srcFile)) {
+            appendBuildChain(panelJob.nodes, panelfoldername, cmakePanelConfigureCmd, cmakePanelBuildCmd,
+                             treeState(panelJob.workDir), QStringList() << srcFile);
+            panelJob.chainKeys.insert(panelfoldername, panelBuildKey);
+        }
+        // 4. Automatic file copy if enabled
+        if (options.autoReplace)
+        {
+            panelJob.copyTasks.append(qMakePair(srcFile, targetPath));
+        }
+
+        if (!panelJob.nodes.isEmpty() || !panelJob.copyTasks.isEmpty()) {
+            jobs.append(panelJob);
+        }
+    }
+
+    return jobs;
+}
+
+QString BuildPlanner::socName(BuildOptions::GPUModel gpu)
+{
+    switch(gpu)
+    {
+    case BuildOptions::G3:
+        return "G3";
+    case BuildOptions::G0M:
+        return "G0M";
+    case BuildOptions::G1P:
+        return "G1P";
+    default:
+        return "";
+    }
+}
+
+// Spellings shared by optionsToJson/optionsFromJson (same values as the CLI options)
+static const QList<QPair<QString, int>> BUILD_TYPE_NAMES = {
+    {"gpu", BuildOptions::GPUDriver}, {"panel", BuildOptions::FantasyPanel}, {"all", BuildOptions::AllType}};
+static const QList<QPair<QString, int>> GPU_NAMES = {
+    {"G0M", BuildOptions::G0M}, {"G3", BuildOptions::G3}, {"G1P", BuildOptions::G1P}};
+static const QList<QPair<QString, int>> DRIVER_NAMES = {
+    {"umd", BuildOptions::UMD}, {"kmd", BuildOptions::KMD}, {"all", BuildOptions::AllDriver}};
+static const QList<QPair<QString, int>> CONFIG_NAMES = {
+    {"debug", BuildOptions::Debug}, {"release", BuildOptions::Release}};
+static const QList<QPair<QString, int>> BIT_NAMES = {
+    {"32", BuildOptions::Bit32}, {"64", BuildOptions::Bit64}, {"all", BuildOptions::AllBit}};
+static const QList<QPair<QString, int>> FIRMWARE_NAMES = {
+    {"116", BuildOptions::Firmware116}, {"119", BuildOptions::Firmware119}};
+
+static QString nameOf(const QList<QPair<QString, int>>& names, int value)
+{
+    for (const auto& name : names) {
+        if (name.second == value) return name.first;
+    }
+    return QString();
+}
+
+// Missing key keeps the default; unknown value is an error
+static bool valueOf(const QJsonObject& json, const QString& key, const QList<QPair<QString, int>>& names, int& value, QString& errorMsg)
+{
+    if (!json.contains(key)) return true;
+    QString text = json.value(key).toString();
+    for (const auto& name : names) {
+        if (text.compare(name.first, Qt::CaseInsensitive) == 0) {
+            value = name.second;
+            return true;
+        }
+    }
+    errorMsg = QString("invalid %1: %2").arg(key, text);
+    return false;
+}
+
+QJsonObject BuildPlanner::optionsToJson(const BuildOptions& options)
+{
+    QJsonObject json;
+    json["type"]           = nameOf(BUILD_TYPE_NAMES, options.buildType);
+    json["gpu"]            = nameOf(GPU_NAMES, options.gpu);
+    json["driver"]         = nameOf(DRIVER_NAMES, options.driver);
+    json["config"]         = nameOf(CONFIG_NAMES, options.config);
+    json["bit"]            = nameOf(BIT_NAMES, options.bit);
+    json["firmware"]       = nameOf(FIRMWARE_NAMES, options.firmware);
+    json["generator"]      = CMakeGenerator::optionName(options.generator);
+    json["compilerLauncher"] = options.compilerLauncher;
+    json["autoReplace"]    = options.autoReplace;
+    json["forceDeleteKMD"] = options.forceDeleteKMD;
+    json["uniq"]           = options.uniq;
+    json["pvr"]            = options.pvr;
+    json["stat"]           = options.stat;
+    if (!options.driverDirSuffix.isEmpty()) {
+        json["driverDirSuffix"] = options.driverDirSuffix;
+    }
+    return json;
+}
+
+bool BuildPlanner::optionsFromJson(const QJsonObject& json, BuildOptions& options, QString& errorMsg)
+{
+    int buildType = options.buildType, gpu = options.gpu, driver = options.driver;
+    int config = options.config, bit = options.bit, firmware = options.firmware;
+    if (!valueOf(json, "type", BUILD_TYPE_NAMES, buildType, errorMsg)
+        || !valueOf(json, "gpu", GPU_NAMES, gpu, errorMsg)
+        || !valueOf(json, "driver", DRIVER_NAMES, driver, errorMsg)
+        || !valueOf(json, "config", CONFIG_NAMES, config, errorMsg)
+        || !valueOf(json, "bit", BIT_NAMES, bit, errorMsg)
+        || !valueOf(json, "firmware", FIRMWARE_NAMES, firmware, errorMsg)) {
+        return false;
+    }
+    if (json.contains("generator") && !CMakeGenerator::fromOptionName(json.value("generator").toString(), options.generator)) {
+        errorMsg = "invalid generator: " + json.value("generator").toString();
+        return false;
+    }
+    options.buildType       = static_cast<BuildOptions::BuildType>(buildType);
+    options.gpu             = static_cast<BuildOptions::GPUModel>(gpu);
+    options.driver          = static_cast<BuildOptions::DriverType>(driver);
+    options.config          = static_cast<BuildOptions::BuildConfig>(config);
+    options.bit             = static_cast<BuildOptions::Bit>(bit);
+    options.firmware        = static_cast<BuildOptions::FirmwareVersion>(firmware);
+    options.autoReplace     = json.value("autoReplace").toBool(options.autoReplace);
+    options.forceDeleteKMD  = json.value("forceDeleteKMD").toBool(options.forceDeleteKMD);
+    options.uniq            = json.value("uniq").toBool(options.uniq);
+    options.pvr             = json.value("pvr").toBool(options.pvr);
+    options.stat            = json.value("stat").toBool(options.stat);
+    options.driverDirSuffix = json.value("driverDirSuffix").toString(options.driverDirSuffix);
+    options.compilerLauncher = json.value("compilerLauncher").toString(options.compilerLauncher);
+    return true;
+}
+
+void BuildPlanner::appendBuildChain(QList<CommandNode>& nodes, const QString& buildDir, const QString& configureCmd, const QString& buildCmd,
+                                    const QByteArray& treeState, const QStringList& artifacts)
+{
+    CommandNode configureNode;
+    configureNode.id      = buildDir + ":configure";
+    configureNode.command = configureCmd;
+    configureNode.chain   = buildDir;
+
+    CommandNode buildNode;
+    buildNode.id          = buildDir + ":build";
+    buildNode.command     = buildCmd;
+    buildNode.dependsOn   = QStringList() << configureNode.id;
+    buildNode.chain       = buildDir;
+    buildNode.artifacts   = artifacts;
+    // Key covers source tree + every build option (SOC_TYPE, firmware, UNIQ, PVR, STAT, config)
+    if (!artifacts.isEmpty())
+    {
+        buildNode.cacheKey = ArtifactCache::computeKey(treeState, QStringList() << configureCmd << buildCmd);
+    }
+
+    nodes << configureNode << buildNode;
+}
+
+QString BuildPlanner::joinPath(const QStringList& parts)
+{
+    QString path;
+    for (const QString& part : parts) {
+        if (path.isEmpty()) {
+            path = part;
+        } else {
+            path += "/" + part;
+        }
+    }
+    return path;
+}
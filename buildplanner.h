@@ -0,0 +1,114 @@
+#ifndef BUILDPLANNER_H
+#define BUILDPLANNER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <QHash>
+#include <QJsonObject>
+#include <functional>
+#include "commandexecutor.h"
+#include "cmakegenerator.h"
+
+// Build matrix selection shared by the GUI and the CLI
+struct BuildOptions
+{
+    enum BuildType
+    {
+        GPUDriver,
+        FantasyPanel,
+        AllType,
+    };
+
+    enum GPUModel
+    {
+        G0M,
+        G3,
+        G1P,
+    };
+
+    enum DriverType
+    {
+        UMD,
+        KMD,
+        AllDriver,
+    };
+
+    enum BuildConfig
+    {
+        Debug,
+        Release,
+    };
+
+    enum Bit
+    {
+        Bit32,
+        Bit64,
+        AllBit
+    };
+
+    enum FirmwareVersion
+    {
+        Firmware116,
+        Firmware119,
+    };
+
+    BuildType       buildType      = AllType;
+    GPUModel        gpu            = G0M;
+    BuildConfig     config         = Debug;
+    bool            autoReplace    = false;   // Copy artifacts to the target path after a successful build
+    DriverType      driver         = AllDriver;
+    Bit             bit            = Bit64;
+    FirmwareVersion firmware       = Firmware119;
+    bool            forceDeleteKMD = false;
+    bool            uniq           = false;
+    bool            pvr            = false;
+    bool            stat           = false;
+    QString         driverDirSuffix;          // Appended to UMD/KMD build dirs (keeps matrix variants apart)
+    CMakeGenerator::Kind generator = CMakeGenerator::defaultKind();
+    QString         compilerLauncher;         // ccache/sccache for every configure (empty = none)
+};
+
+// One executor job produced by the planner
+struct PlannedJob
+{
+    QString                        name;      // Job name (e.g. "GPU Driver G0M")
+    QString                        workDir;   // Working directory of the commands
+    QList<CommandNode>             nodes;     // configure -> build chains
+    QList<QPair<QString, QString>> copyTasks; // Artifact -> target directory
+    QList<QString>                 delTasks;  // Directories deleted before the job starts
+    QHash<QString, QString>        chainKeys; // Chain -> build key (build dir + commands)
+};
+
+// Turns BuildOptions into executor jobs (no UI, no validation of user paths)
+class BuildPlanner
+{
+public:
+    // Called per chain before it is added; returning true drops the chain (its copy task is kept)
+    // Parameters: component ("UMD", "KMD", "Panel"), chain (build dir), build key, expected artifacts
+    using ChainFilter = std::function<bool(const QString&, const QString&, const QString&, const QStringList&)>;
+
+    // Returns the artifact cache tree state of a source dir (default: ArtifactCache::sourceTreeState)
+    // Long-running callers pass a memoizing provider to skip the tree walk while nothing changed
+    using TreeStateProvider = std::function<QByteArray(const QString&)>;
+
+    // Plan the jobs of one build request
+    // Jobs without commands and without copy tasks are omitted
+    static QList<PlannedJob> plan(const BuildOptions& options, const QString& projectPath, const QString& targetPath,
+                                  const ChainFilter& skipChain = ChainFilter(),
+                                  const TreeStateProvider& treeStateOf = TreeStateProvider());
+
+    static QString socName(BuildOptions::GPUModel gpu);
+    static QString joinPath(const QStringList& parts);
+
+    // BuildOptions <-> JSON (daemon protocol); values use the CLI spellings ("gpu", "G0M", "debug", "64", "119", ...)
+    static QJsonObject optionsToJson(const BuildOptions& options);
+    static bool optionsFromJson(const QJsonObject& json, BuildOptions& options, QString& errorMsg);
+
+private:
+    static void appendBuildChain(QList<CommandNode>& nodes, const QString& buildDir, const QString& configureCmd, const QString& buildCmd,
+                                 const QByteArray& treeState = QByteArray(), const QStringList& artifacts = QStringList());
+};
+
+#endif // BUILDPLANNER_H
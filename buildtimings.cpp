@@ -0,0 +1,432 @@
+#include "buildtimings.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStringList>
+#include <algorithm>
+
+// Durations of the previous runs, next to CMakeCache.txt
+static const char* HISTORY_FILE = "/.eazybuild_timings.json";
+// Time traces are megabytes each: only the slowest TUs are parsed
+static const int MAX_TIME_TRACES = 20;
+
+// Generator and time-trace flag of a configured build dir
+struct CacheInfo
+{
+    QString generator;
+    bool    hasTimeTrace = false;
+};
+
+static CacheInfo readCache(const QString& buildDir)
+{
+    CacheInfo info;
+    QFile cacheFile(buildDir + "/CMakeCache.txt");
+    if (!cacheFile.open(QIODevice::ReadOnly | QIODevice::Text)) return info;
+
+    while (!cacheFile.atEnd())
+    {
+        QString line = QString::fromUtf8(cacheFile.readLine()).trimmed();
+        if (line.startsWith("CMAKE_GENERATOR:INTERNAL="))
+        {
+            info.generator = line.mid(line.indexOf('=') + 1);
+        }
+        else if (line.startsWith("CMAKE_") && line.contains("_FLAGS") && line.contains("-ftime-trace"))
+        {
+            info.hasTimeTrace = true;
+        }
+    }
+    return info;
+}
+
+static void sortSlowestFirst(QList<BuildTimings::Entry>& entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const BuildTimings::Entry& a, const BuildTimings::Entry& b) {
+        return a.durationMs > b.durationMs;
+    });
+}
+
+static QString unitKey(const BuildTimings::Entry& unit)
+{
+    return unit.target + "/" + unit.name;
+}
+
+QString BuildTimings::withPerformanceSummary(const QString& command, const QString& buildDir)
+{
+    if (command.contains("PerformanceSummary", Qt::CaseInsensitive)) return command;
+    if (!readCache(buildDir).generator.startsWith("Visual Studio")) return command;
+
+    // Arguments after "--" go to MSBuild itself
+    static const QRegularExpression nativeArgsRegex(R"(\s--(\s|$))");
+    return command + (nativeArgsRegex.match(command).hasMatch() ? " " : " -- ") + "/clp:PerformanceSummary";
+}
+
+// Output from the last "Project Performance Summary:" on
+// Streamed from the spool: the summary ends a long build's output, past what the head and tail keep in memory
+static QString lastPerformanceSummary(const OutputCapture& output)
+{
+    static const QString marker = "Project Performance Summary:";
+    QString section;       // From the last marker on, or the few characters a marker split across blocks needs
+    bool hasMarker = false;
+    output.writeTo([&](const QString& block) {
+        int from = qMax(0, section.size() - (marker.size() - 1));
+        section += block;
+        int markerPos = -1;
+        for (int pos = section.indexOf(marker, from); pos >= 0; pos = section.indexOf(marker, pos + 1)) markerPos = pos;
+        if (markerPos >= 0)
+        {
+            section.remove(0, markerPos);
+            hasMarker = true;
+        }
+        else if (!hasMarker)
+        {
+            section = section.right(marker.size() - 1);
+        }
+    });
+    return hasMarker ? section : QString();
+}
+
+BuildTimings::Report BuildTimings::collect(const QString& buildDir, const OutputCapture& buildOutput, const QDateTime& startedAt)
+{
+    Report report;
+    report.buildDir = buildDir;
+
+    CacheInfo cache = readCache(buildDir);
+    if (cache.generator.startsWith("Ninja"))
+    {
+        if (parseNinjaLog(buildDir, startedAt, report)) report.source = "ninja";
+    }
+    else if (cache.generator.startsWith("Visual Studio"))
+    {
+        if (parseMsBuildSummary(lastPerformanceSummary(buildOutput), report)) report.source = "msbuild";
+    }
+    if (cache.hasTimeTrace)
+    {
+        parseTimeTraces(buildDir, startedAt, report);
+        if (report.source.isEmpty() && !report.units.isEmpty()) report.source = "time trace";
+    }
+
+    sortSlowestFirst(report.targets);
+    sortSlowestFirst(report.units);
+    sortSlowestFirst(report.headers);
+    loadPrevious(report);
+    return report;
+}
+
+// "# ninja log v5" (v6, v7 alike), then "<start ms>\t<end ms>\t<mtime>\t<output>\t<command hash>" per output
+bool BuildTimings::parseNinjaLog(const QString& buildDir, const QDateTime& startedAt, Report& report)
+{
+    QFile logFile(buildDir + "/.ninja_log");
+    // Ninja did not touch its log: nothing was rebuilt, the entries belong to an earlier run
+    if (!logFile.open(QIODevice::ReadOnly) || QFileInfo(logFile).lastModified() < startedAt) return false;
+
+    struct Edge
+    {
+        qint64     start;
+        qint64     end;
+        QByteArray hash;
+        QString    output;
+    };
+    QList<Edge> edges;
+    qint64 lastEnd = -1;
+    while (!logFile.atEnd())
+    {
+        QByteArray line = logFile.readLine();
+        if (line.startsWith('#')) continue;
+        QList<QByteArray> fields = line.trimmed().split('\t');
+        if (fields.size() < 5) continue;
+
+        Edge edge{ fields[0].toLongLong(), fields[1].toLongLong(), fields[4], QString::fromUtf8(fields[3]) };
+        // Entries are appended as edges complete: a smaller end time starts the next run
+        if (edge.end < lastEnd) edges.clear();
+        lastEnd = edge.end;
+        // One edge with several outputs writes one line per output
+        if (!edges.isEmpty() && edges.last().start == edge.start && edges.last().end == edge.end && edges.last().hash == edge.hash) continue;
+        edges.append(edge);
+    }
+    if (edges.isEmpty()) return false;
+
+    // CMake object files: CMakeFiles/<target>.dir/<source>.o (precompiled headers alike)
+    static const QRegularExpression objectRegex(R"((?:^|/)CMakeFiles/([^/]+)\.dir/(.+)\.(?:o|obj|gch|pch)$)");
+    static const QRegularExpression binaryRegex(R"(\.(?:exe|dll|so(?:\.[\d.]+)?|dylib|a|lib)$)");
+
+    QHash<QString, Entry> targets;
+    QList<QPair<QString, qint64>> links;
+    qint64 firstStart = edges.first().start;
+    qint64 lastEdgeEnd = 0;
+    for (const Edge& edge : qAsConst(edges))
+    {
+        firstStart = qMin(firstStart, edge.start);
+        lastEdgeEnd = qMax(lastEdgeEnd, edge.end);
+        qint64 durationMs = edge.end - edge.start;
+
+        QRegularExpressionMatch match = objectRegex.match(edge.output);
+        if (match.hasMatch())
+        {
+            Entry unit;
+            unit.name = match.captured(2);
+            unit.target = match.captured(1);
+            unit.durationMs = durationMs;
+            report.units << unit;
+
+            Entry& target = targets[unit.target];
+            target.name = unit.target;
+            target.durationMs += durationMs;
+            target.count++;
+            continue;
+        }
+
+        // Executables without suffix live outside CMakeFiles (which also holds stamps and generated files)
+        QFileInfo outputInfo(edge.output);
+        bool isBinary = binaryRegex.match(edge.output).hasMatch()
+                        || (outputInfo.suffix().isEmpty() && !edge.output.contains("CMakeFiles/") && outputInfo.fileName() != "build.ninja");
+        if (isBinary) links << qMakePair(outputInfo.fileName().section('.', 0, 0), durationMs);
+    }
+
+    // A link output is named after its target, libraries with a "lib" prefix
+    for (const auto& link : qAsConst(links))
+    {
+        QString name = link.first;
+        if (!targets.contains(name) && name.startsWith("lib") && targets.contains(name.mid(3))) name = name.mid(3);
+        Entry& target = targets[name];
+        target.name = name;
+        target.durationMs += link.second;
+        target.linkMs = qMax<qint64>(target.linkMs, 0) + link.second;
+    }
+
+    report.targets = targets.values();
+    report.wallMs = lastEdgeEnd - firstStart;
+    return true;
+}
+
+// "Project Performance Summary:" followed by "<ms> ms  <project file>  <n> calls" lines
+bool BuildTimings::parseMsBuildSummary(const QString& output, Report& report)
+{
+    int summaryPos = output.lastIndexOf("Project Performance Summary:");
+    if (summaryPos < 0) return false;
+
+    static const QRegularExpression projectRegex(R"(^\s*(\d+) ms\s+(.+?\.\w*proj)\s+\d+ calls?\s*$)");
+    // CMake's aggregate projects only wait for the real ones
+    static const QStringList aggregateProjects = { "ALL_BUILD", "ZERO_CHECK", "INSTALL", "RUN_TESTS", "PACKAGE" };
+
+    QHash<QString, Entry> targets;
+    const QStringList lines = output.mid(summaryPos).split('\n');
+    for (int i = 1; i < lines.size(); ++i)
+    {
+        QString line = lines[i];
+        line.remove('\r');
+        if (line.trimmed().endsWith("Summary:")) break;
+
+        QRegularExpressionMatch match = projectRegex.match(line);
+        if (!match.hasMatch()) continue;
+        QString name = QFileInfo(match.captured(2).trimmed()).completeBaseName();
+        if (aggregateProjects.contains(name)) continue;
+
+        // Per-call lines repeat the project: its total is the largest
+        Entry& target = targets[name];
+        target.name = name;
+        target.durationMs = qMax(target.durationMs, match.captured(1).toLongLong());
+    }
+    report.targets = targets.values();
+    return !report.targets.isEmpty();
+}
+
+// Clang writes <object without suffix>.json next to each object file
+void BuildTimings::parseTimeTraces(const QString& buildDir, const QDateTime& startedAt, Report& report)
+{
+    struct Candidate
+    {
+        QString path;
+        int     unitIdx;  // Index in report.units (-1 = TU not known from the generator)
+        qint64  size;
+    };
+    QList<Candidate> candidates;
+
+    if (!report.units.isEmpty())
+    {
+        // Ninja knows the TUs: the slowest ones are the interesting traces
+        sortSlowestFirst(report.units);
+        for (int i = 0; i < report.units.size() && candidates.size() < MAX_TIME_TRACES; ++i)
+        {
+            const Entry& unit = report.units[i];
+            QString path = QString("%1/CMakeFiles/%2.dir/%3.json").arg(buildDir, unit.target, unit.name);
+            if (QFileInfo::exists(path)) candidates << Candidate{ path, i, 0 };
+        }
+    }
+    else
+    {
+        // Visual Studio: <target>.dir/<config>/<source>.json; the largest traces belong to the longest compiles
+        QDirIterator it(buildDir, QStringList() << "*.json", QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            QString path = it.next();
+            QFileInfo info = it.fileInfo();
+            if (!path.contains(".dir/") || info.lastModified() < startedAt) continue;
+            candidates << Candidate{ path, -1, info.size() };
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.size > b.size; });
+        if (candidates.size() > MAX_TIME_TRACES) candidates.erase(candidates.begin() + MAX_TIME_TRACES, candidates.end());
+    }
+
+    QHash<QString, Entry> headers;
+    for (const Candidate& candidate : qAsConst(candidates))
+    {
+        QFile traceFile(candidate.path);
+        if (!traceFile.open(QIODevice::ReadOnly)) continue;
+        const QJsonArray events = QJsonDocument::fromJson(traceFile.readAll()).object().value("traceEvents").toArray();
+        if (events.isEmpty()) continue;
+
+        qint64 compilerUs = 0;
+        qint64 frontendUs = 0;
+        qint64 backendUs = 0;
+        QHash<QString, qint64> includedUs;
+        for (const QJsonValue& value : events)
+        {
+            QJsonObject event = value.toObject();
+            QString name = event.value("name").toString();
+            qint64 durationUs = static_cast<qint64>(event.value("dur").toDouble());
+            if (name == "Total ExecuteCompiler") compilerUs = durationUs;
+            else if (name == "Total Frontend") frontendUs = durationUs;
+            else if (name == "Total Backend") backendUs = durationUs;
+            // Parse time of an included file, nested includes counted in their includer too
+            else if (name == "Source") includedUs[event.value("args").toObject().value("detail").toString()] += durationUs;
+        }
+
+        int unitIdx = candidate.unitIdx;
+        if (unitIdx < 0)
+        {
+            QString relativePath = QDir(buildDir).relativeFilePath(candidate.path);
+            int dirPos = relativePath.indexOf(".dir/");
+            Entry unit;
+            unit.target = relativePath.left(dirPos).section('/', -1);
+            unit.name = relativePath.mid(dirPos + 5).section('/', 1);
+            unit.name.chop(5);
+            unit.durationMs = compilerUs / 1000;
+            report.units << unit;
+            unitIdx = report.units.size() - 1;
+        }
+        report.units[unitIdx].frontendMs = frontendUs / 1000;
+        report.units[unitIdx].backendMs = backendUs / 1000;
+        report.tracedUnits++;
+
+        for (auto it = includedUs.constBegin(); it != includedUs.constEnd(); ++it)
+        {
+            if (it.key().isEmpty()) continue;
+            Entry& header = headers[it.key()];
+            header.name = it.key();
+            header.durationMs += it.value() / 1000;
+            header.count++;
+        }
+    }
+    report.headers = headers.values();
+}
+
+void BuildTimings::loadPrevious(Report& report)
+{
+    QFile historyFile(report.buildDir + HISTORY_FILE);
+    if (!historyFile.open(QIODevice::ReadOnly)) return;
+    QJsonObject history = QJsonDocument::fromJson(historyFile.readAll()).object();
+    QJsonObject targets = history.value("targets").toObject();
+    QJsonObject units = history.value("units").toObject();
+
+    for (Entry& target : report.targets)
+    {
+        if (targets.contains(target.name)) target.previousMs = static_cast<qint64>(targets.value(target.name).toDouble());
+    }
+    for (Entry& unit : report.units)
+    {
+        QString key = unitKey(unit);
+        if (units.contains(key)) unit.previousMs = static_cast<qint64>(units.value(key).toDouble());
+    }
+}
+
+void BuildTimings::save(const Report& report)
+{
+    if (report.isEmpty()) return;
+
+    QString historyPath = report.buildDir + HISTORY_FILE;
+    QJsonObject history;
+    QFile historyFile(historyPath);
+    if (historyFile.open(QIODevice::ReadOnly))
+    {
+        history = QJsonDocument::fromJson(historyFile.readAll()).object();
+        historyFile.close();
+    }
+
+    // An incremental build rebuilds a few TUs: the others keep the duration of their last build
+    QJsonObject targets = history.value("targets").toObject();
+    QJsonObject units = history.value("units").toObject();
+    for (const Entry& target : report.targets) targets.insert(target.name, target.durationMs);
+    for (const Entry& unit : report.units) units.insert(unitKey(unit), unit.durationMs);
+    history.insert("targets", targets);
+    history.insert("units", units);
+    history.insert("updated", QDateTime::currentDateTime().toString(Qt::ISODate));
+
+    QSaveFile saveFile(historyPath);
+    if (!saveFile.open(QIODevice::WriteOnly)) return;
+    saveFile.write(QJsonDocument(history).toJson(QJsonDocument::Compact));
+    saveFile.commit();
+}
+
+QString BuildTimings::format(const Report& report, int maxRows)
+{
+    if (report.isEmpty()) return QString();
+
+    auto seconds = [](qint64 ms) { return QString::number(ms / 1000.0, 'f', 1) + "s"; };
+    auto change = [&seconds](const Entry& entry) {
+        if (entry.previousMs < 0) return QString("new");
+        qint64 deltaMs = entry.durationMs - entry.previousMs;
+        return (deltaMs < 0 ? "-" : "+") + seconds(qAbs(deltaMs));
+    };
+
+    QStringList lines;
+    QString header = QString("⏱️ Build time breakdown of %1 (%2").arg(report.buildDir, report.source);
+    if (report.wallMs > 0) header += ", wall " + seconds(report.wallMs);
+    lines << header + ")";
+
+    if (!report.targets.isEmpty())
+    {
+        lines << (report.source == "msbuild" ? "Slowest targets (project time, including the projects it waits for):"
+                                             : "Slowest targets (compile + link time summed over parallel steps):");
+        for (int i = 0; i < report.targets.size() && i < maxRows; ++i)
+        {
+            const Entry& target = report.targets[i];
+            QStringList details;
+            if (target.count > 0) details << QString("%1 TUs").arg(target.count);
+            if (target.linkMs >= 0) details << "link " + seconds(target.linkMs);
+            lines << QString("  %1 %2  %3%4").arg(seconds(target.durationMs), 8).arg("(" + change(target) + ")", -9).arg(target.name)
+                         .arg(details.isEmpty() ? QString() : " (" + details.join(", ") + ")");
+        }
+    }
+
+    if (!report.units.isEmpty())
+    {
+        lines << "Slowest translation units:";
+        for (int i = 0; i < report.units.size() && i < maxRows; ++i)
+        {
+            const Entry& unit = report.units[i];
+            QString split;
+            if (unit.frontendMs >= 0) split = QString(" (frontend %1, backend %2)").arg(seconds(unit.frontendMs), seconds(unit.backendMs));
+            lines << QString("  %1 %2  %3 [%4]%5").arg(seconds(unit.durationMs), 8).arg("(" + change(unit) + ")", -9)
+                         .arg(unit.name, unit.target, split);
+        }
+    }
+
+    if (!report.headers.isEmpty())
+    {
+        lines << QString("Slowest headers (-ftime-trace parse time of the %1 slowest TUs, nested includes counted in their includers):")
+                     .arg(report.tracedUnits);
+        for (int i = 0; i < report.headers.size() && i < maxRows; ++i)
+        {
+            const Entry& header = report.headers[i];
+            lines << QString("  %1  %2 (%3 TUs)").arg(seconds(header.durationMs), 8).arg(header.name).arg(header.count);
+        }
+    }
+    return lines.join("\n");
+}
@@ -0,0 +1,62 @@
+#ifndef BUILDTIMINGS_H
+#define BUILDTIMINGS_H
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+#include "outputcapture.h"
+
+// Where the time of one "cmake --build" went, from the generator's own records
+// Ninja: .ninja_log of the build dir (every compile and link edge of the last run)
+// Visual Studio: "Project Performance Summary" printed by MSBuild's /clp:PerformanceSummary
+// Clang -ftime-trace (when in the cached compile flags): <object>.json of the slowest TUs
+// Each build dir remembers the last duration of every target and TU for the comparison with the next run
+class BuildTimings
+{
+public:
+    struct Entry
+    {
+        QString name;              // Target name, source path of a TU (relative to its target dir) or header path
+        QString target;            // Target of a TU (empty for targets and headers)
+        qint64  durationMs = 0;    // Targets: compile + link time summed; headers: parse time summed over TUs
+        qint64  previousMs = -1;   // Duration of the previous run that built it (-1 = first time)
+        int     count = 0;         // Targets: compiled TUs; headers: TUs including it
+        qint64  linkMs = -1;       // Targets: link/archive time (-1 = not linked in this run)
+        qint64  frontendMs = -1;   // TUs with a time trace: parsing and template instantiation
+        qint64  backendMs = -1;    // TUs with a time trace: optimization and code generation
+    };
+
+    struct Report
+    {
+        QString      buildDir;
+        QString      source;       // "ninja" or "msbuild" (empty = nothing recorded)
+        qint64       wallMs = 0;   // Ninja: first edge start to last edge end
+        QList<Entry> targets;      // Slowest first
+        QList<Entry> units;        // Slowest first
+        QList<Entry> headers;      // Slowest first (time traces only)
+        int          tracedUnits = 0;
+
+        bool isEmpty() const { return targets.isEmpty() && units.isEmpty(); }
+    };
+
+    // Add /clp:PerformanceSummary to a build command of a Visual Studio build dir (other commands unchanged)
+    static QString withPerformanceSummary(const QString& command, const QString& buildDir);
+
+    // Timings of the build that ran in buildDir since startedAt (buildOutput: its stdout, for MSBuild)
+    // Reads the build dir and the spooled output: meant for a worker thread once the build has finished
+    static Report collect(const QString& buildDir, const OutputCapture& buildOutput, const QDateTime& startedAt);
+
+    // Ranked report: the slowest maxRows targets, TUs and headers with their change since the previous run
+    static QString format(const Report& report, int maxRows = 10);
+
+    // Remember the durations of this run for the next report of the build dir (entries not rebuilt keep theirs)
+    static void save(const Report& report);
+
+private:
+    static bool parseNinjaLog(const QString& buildDir, const QDateTime& startedAt, Report& report);
+    static bool parseMsBuildSummary(const QString& output, Report& report);
+    static void parseTimeTraces(const QString& buildDir, const QDateTime& startedAt, Report& report);
+    static void loadPrevious(Report& report);
+};
+
+#endif // BUILDTIMINGS_H
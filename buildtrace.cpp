@@ -0,0 +1,103 @@
+#include "buildtrace.h"
+#include <QCoreApplication>
+#include <QJsonDocument>
+
+// All tracks belong to one process of the trace
+static const int TRACE_PID = 1;
+
+void BuildTrace::start()
+{
+    m_events = QJsonArray();
+    m_namedTracks.clear();
+    m_timer.start();
+    m_isActive = true;
+
+    QJsonObject process;
+    process.insert("ph", "M");
+    process.insert("name", "process_name");
+    process.insert("pid", TRACE_PID);
+    process.insert("args", QJsonObject{ { "name", QString("EazyBuild %1").arg(QCoreApplication::applicationPid()) } });
+    m_events.append(process);
+    nameTrack(EXECUTOR_TRACK, "Executor (delete, copy, transfer, cache)", 0);
+}
+
+qint64 BuildTrace::now() const
+{
+    return m_timer.isValid() ? m_timer.nsecsElapsed() / 1000 : 0;
+}
+
+void BuildTrace::nameTrack(int track, const QString& name, int sortIndex)
+{
+    if (!m_isActive || m_namedTracks.contains(track)) return;
+    m_namedTracks.insert(track);
+
+    QJsonObject threadName;
+    threadName.insert("ph", "M");
+    threadName.insert("name", "thread_name");
+    threadName.insert("pid", TRACE_PID);
+    threadName.insert("tid", track);
+    threadName.insert("args", QJsonObject{ { "name", name } });
+    m_events.append(threadName);
+
+    QJsonObject threadOrder;
+    threadOrder.insert("ph", "M");
+    threadOrder.insert("name", "thread_sort_index");
+    threadOrder.insert("pid", TRACE_PID);
+    threadOrder.insert("tid", track);
+    threadOrder.insert("args", QJsonObject{ { "sort_index", sortIndex } });
+    m_events.append(threadOrder);
+}
+
+void BuildTrace::addSpan(int track, const QString& name, const QString& category, qint64 startUs, qint64 endUs,
+                         const QJsonObject& args)
+{
+    if (!m_isActive) return;
+
+    QJsonObject event;
+    event.insert("ph", "X");
+    event.insert("name", name);
+    event.insert("cat", category);
+    event.insert("pid", TRACE_PID);
+    event.insert("tid", track);
+    event.insert("ts", startUs);
+    event.insert("dur", qMax<qint64>(0, endUs - startUs));
+    if (!args.isEmpty()) event.insert("args", args);
+    m_events.append(event);
+}
+
+void BuildTrace::addInstant(int track, const QString& name, const QString& category, const QJsonObject& args)
+{
+    if (!m_isActive) return;
+
+    QJsonObject event;
+    event.insert("ph", "i");
+    event.insert("s", "t");
+    event.insert("name", name);
+    event.insert("cat", category);
+    event.insert("pid", TRACE_PID);
+    event.insert("tid", track);
+    event.insert("ts", now());
+    if (!args.isEmpty()) event.insert("args", args);
+    m_events.append(event);
+}
+
+void BuildTrace::addCounter(const QString& name, const QJsonObject& values)
+{
+    if (!m_isActive) return;
+
+    QJsonObject event;
+    event.insert("ph", "C");
+    event.insert("name", name);
+    event.insert("pid", TRACE_PID);
+    event.insert("ts", now());
+    event.insert("args", values);
+    m_events.append(event);
+}
+
+QByteArray BuildTrace::toJson() const
+{
+    QJsonObject root;
+    root.insert("traceEvents", m_events);
+    root.insert("displayTimeUnit", "ms");
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,53 @@
+#ifndef BUILDTRACE_H
+#define BUILDTRACE_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+
+// Timeline of one build batch in the Chrome trace-event format
+// Opens in chrome://tracing and ui.perfetto.dev: one track per process slot, one per job,
+// one for the steps the executor runs itself (delete, copy, remote transfer, cache restore)
+class BuildTrace
+{
+public:
+    // Track of the executor's own steps; slots and jobs get their own ids
+    static const int EXECUTOR_TRACK = 0;
+    static int slotTrack(int slotIdx) { return 1 + slotIdx; }
+    static int jobTrack(int jobId) { return 100000 + jobId; }
+
+    // New batch: forget the previous events, time 0 = now
+    void start();
+    void stop() { m_isActive = false; }
+    bool isActive() const { return m_isActive; }
+
+    // Microseconds since start()
+    qint64 now() const;
+
+    // Name shown for a track (set once; sortIndex orders the tracks top to bottom)
+    void nameTrack(int track, const QString& name, int sortIndex);
+
+    // Complete event ("X") from startUs to endUs
+    void addSpan(int track, const QString& name, const QString& category, qint64 startUs, qint64 endUs,
+                 const QJsonObject& args = QJsonObject());
+
+    // Point in time ("i"), e.g. a fail-fast abort
+    void addInstant(int track, const QString& name, const QString& category, const QJsonObject& args = QJsonObject());
+
+    // Counter sample ("C"): every key of values becomes a series of the counter track
+    void addCounter(const QString& name, const QJsonObject& values);
+
+    // {"traceEvents": [...]} with the process and track names
+    QByteArray toJson() const;
+
+private:
+    QElapsedTimer m_timer;
+    QJsonArray    m_events;
+    QSet<int>     m_namedTracks;
+    bool          m_isActive = false;
+};
+
+#endif // BUILDTRACE_H
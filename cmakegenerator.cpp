@@ -0,0 +1,126 @@
+#include "cmakegenerator.h"
+#include "commandline.h"
+
+CMakeGenerator::Kind CMakeGenerator::defaultKind()
+{
+#ifdef Q_OS_WIN
+    return VisualStudio2019;
+#else
+    return Ninja;
+#endif
+}
+
+QList<CMakeGenerator::Kind> CMakeGenerator::kinds()
+{
+    return {VisualStudio2019, Ninja, NinjaMultiConfig, UnixMakefiles};
+}
+
+QString CMakeGenerator::optionName(Kind kind)
+{
+    switch (kind)
+    {
+    case VisualStudio2019:
+        return "vs2019";
+    case Ninja:
+        return "ninja";
+    case NinjaMultiConfig:
+        return "ninja-multi";
+    case UnixMakefiles:
+        return "make";
+    default:
+        return "";
+    }
+}
+
+// Accepts the option spelling or the cmake -G name
+bool CMakeGenerator::fromOptionName(const QString& name, Kind& kind)
+{
+    for (Kind candidate : kinds())
+    {
+        if (name.compare(optionName(candidate), Qt::CaseInsensitive) == 0
+            || name.compare(CMakeGenerator(candidate).cmakeName(), Qt::CaseInsensitive) == 0)
+        {
+            kind = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+QString CMakeGenerator::cmakeName() const
+{
+    switch (m_kind)
+    {
+    case VisualStudio2019:
+        return "Visual Studio 16 2019";
+    case Ninja:
+        return "Ninja";
+    case NinjaMultiConfig:
+        return "Ninja Multi-Config";
+    case UnixMakefiles:
+        return "Unix Makefiles";
+    default:
+        return "";
+    }
+}
+
+bool CMakeGenerator::isMultiConfig() const
+{
+    return m_kind == VisualStudio2019 || m_kind == NinjaMultiConfig;
+}
+
+// CMake refuses to reconfigure a build dir with another generator, and Debug and Release of a
+// single-config generator must not share a cache: both go into the name (Visual Studio keeps the plain one)
+QString CMakeGenerator::buildDir(const QString& baseDir, const QString& config) const
+{
+    QString dir = baseDir;
+    switch (m_kind)
+    {
+    case Ninja:
+        dir += "_ninja";
+        break;
+    case NinjaMultiConfig:
+        dir += "_nmc";
+        break;
+    case UnixMakefiles:
+        dir += "_make";
+        break;
+    default:
+        break;
+    }
+    return isMultiConfig() ? dir : dir + "_" + config.toLower();
+}
+
+QStringList CMakeGenerator::configureArgs(const QString& config) const
+{
+    if (isMultiConfig()) return QStringList();
+    return QStringList() << "-D" << "CMAKE_BUILD_TYPE=" + config;
+}
+
+// Empty list for Visual Studio (MSBuild ignores the variable)
+QStringList CMakeGenerator::compilerLauncherArgs(const QString& launcher) const
+{
+    if (!supportsCompilerLauncher()) return QStringList();
+    if (launcher.isEmpty())
+    {
+        return QStringList() << "-U" << "CMAKE_C_COMPILER_LAUNCHER" << "-U" << "CMAKE_CXX_COMPILER_LAUNCHER";
+    }
+    return QStringList() << "-D" << "CMAKE_C_COMPILER_LAUNCHER=" + launcher
+                         << "-D" << "CMAKE_CXX_COMPILER_LAUNCHER=" + launcher;
+}
+
+QString CMakeGenerator::buildCommand(const QString& buildDir, const QString& config) const
+{
+    QString cmd = "cmake --build " + CommandLine::quote(buildDir);
+    if (isMultiConfig())
+    {
+        cmd += " --config " + config;
+    }
+    return cmd;
+}
+
+// Assumes the default CMAKE_RUNTIME_OUTPUT_DIRECTORY (per-config subfolder for multi-config generators)
+QString CMakeGenerator::artifactPath(const QString& buildDir, const QString& config, const QString& fileName) const
+{
+    return isMultiConfig() ? buildDir + "/" + config + "/" + fileName : buildDir + "/" + fileName;
+}
@@ -0,0 +1,65 @@
+#ifndef CMAKEGENERATOR_H
+#define CMAKEGENERATOR_H
+
+#include <QString>
+#include <QStringList>
+
+// CMake generator of a build profile: configure flags, build command and output layout
+// Multi-config generators (Visual Studio, Ninja Multi-Config) share one build dir per chain and pick the
+// config at build time; single-config generators (Ninja, Unix Makefiles) get CMAKE_BUILD_TYPE and one dir per config
+// Parallelism is injected by the executor from the generator recorded in CMakeCache.txt
+// (jobserver tokens for Ninja >= 1.13 / GNU make, --parallel share for MSBuild and older tools)
+class CMakeGenerator
+{
+public:
+    enum Kind
+    {
+        VisualStudio2019,
+        Ninja,
+        NinjaMultiConfig,
+        UnixMakefiles,
+    };
+
+    explicit CMakeGenerator(Kind kind = defaultKind()) : m_kind(kind) {}
+
+    // Visual Studio on Windows, Ninja elsewhere
+    static Kind defaultKind();
+
+    // Every kind, in UI order
+    static QList<Kind> kinds();
+
+    // Option spelling used by the CLI, the daemon protocol and QSettings ("vs2019", "ninja", "ninja-multi", "make")
+    static QString optionName(Kind kind);
+    static bool fromOptionName(const QString& name, Kind& kind);
+
+    Kind kind() const { return m_kind; }
+
+    // Value passed to cmake -G
+    QString cmakeName() const;
+
+    bool isMultiConfig() const;
+
+    // CMAKE_<LANG>_COMPILER_LAUNCHER is honoured by the Ninja and Makefile generators only
+    bool supportsCompilerLauncher() const { return m_kind != VisualStudio2019; }
+
+    // Configure arguments enabling a compiler launcher (empty launcher = remove a previously set one)
+    QStringList compilerLauncherArgs(const QString& launcher) const;
+
+    // Build dir of a chain: generator tag, plus the config for single-config generators
+    // (e.g. cmake_build_umd_G0M for Visual Studio, cmake_build_umd_G0M_nmc, cmake_build_umd_G0M_ninja_debug)
+    QString buildDir(const QString& baseDir, const QString& config) const;
+
+    // Extra configure arguments (CMAKE_BUILD_TYPE for single-config generators)
+    QStringList configureArgs(const QString& config) const;
+
+    // cmake --build command (--config only where the generator reads it)
+    QString buildCommand(const QString& buildDir, const QString& config) const;
+
+    // Location of a runtime artifact relative to the project: <buildDir>/<config>/<file> or <buildDir>/<file>
+    QString artifactPath(const QString& buildDir, const QString& config, const QString& fileName) const;
+
+private:
+    Kind m_kind;
+};
+
+#endif // CMAKEGENERATOR_H
@@ -1,430 +1,1847 @@
-#include "CommandExecutor.h"
+#include "commandexecutor.h"
 #include <QOperatingSystemVersion>
 #include <QDir>
+#include <QFileInfo>
 #include <QTextStream>
 #include <QRegularExpression>
-#include "remoteconfigdialog.h"
+#include <QHash>
+#include <QThread>
+#include "remotefilesender.h"
+#include "commandline.h"
+#include "processtree.h"
+#include "logarchive.h"
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
+
+// Log output is delivered in frames: at most ~30 per second, or earlier once a frame holds this many characters
+static const int LOG_FRAME_INTERVAL_MS = 33;
+static const int LOG_FRAME_MAX_CHARS = 256 * 1024;
+
+// Disk space kept for trace files next to the log, oldest deleted first
+static const qint64 TRACE_BUDGET_BYTES = 256 * 1024 * 1024;
 
 /**
- * @brief Constructor: Initialize process and default settings
+ * @brief Constructor: Initialize process pool and default settings
  */
 CommandExecutor::CommandExecutor(QObject *parent)
     : QObject(parent)
-    , m_process(new QProcess(this))
-    , m_currentAsyncCmdIdx(0)
+    , m_logSegmentBytes(64 * 1024 * 1024)
+    , m_logBudgetBytes(qint64(2048) * 1024 * 1024)
+    , m_nextJobId(1)
+    , m_runningCount(0)
+    , m_maxParallelCommands(qMax(1, QThread::idealThreadCount()))
+    , m_maxConcurrentJobs(2)
     , m_maxLogLines(10000)
+    , m_cpuBudget(0)
+    , m_jobServerNeedsReset(false)
+    , m_tokenRetryTimer(new QTimer(this))
+    , m_logFrameChars(0)
+    , m_logFlushTimer(new QTimer(this))
+    , m_baseEnvironment(QProcessEnvironment::systemEnvironment())
+    , m_configureCacheEnabled(true)
+    , m_artifactCacheEnabled(true)
+    , m_failFastEnabled(false)
+    , m_compilerCacheQuery(0)
+    , m_isSamplingCompilerCache(false)
+    , m_resourceTimer(new QTimer(this))
+    , m_isSamplingResources(false)
+    , m_traceEnabled(true)
+    , m_traceCpuMs(0)
+    , m_traceSampleUs(0)
+    , m_buildTimingsEnabled(true)
+    , m_pendingTimingReports(0)
+    , m_isWaitingForTimingReports(false)
+    , m_diagnostics(new DiagnosticTable(this))
     , m_isExecuting(false)
+    , m_isRemote(false)
 {
     // Generate default log file name with timestamp
     QString defaultLogName = QString("cmd_exec_%1.log").arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
     m_logFileFolder = QDir::currentPath();
     m_logFilePath = m_logFileFolder + "/" + defaultLogName;
 
+    // Log file I/O stays off this thread; write errors come back queued
+    m_logWriter = new LogWriter(this);
+    connect(m_logWriter, &LogWriter::writeFailed, this, [this](const QString& errorMsg) {
+        postLog(formatRealTimeLog(errorMsg), true);
+    });
+    applyLogRotation();
+
+    // Builds waiting for jobserver tokens are retried periodically (children return tokens on their own)
+    m_tokenRetryTimer->setSingleShot(true);
+    m_tokenRetryTimer->setInterval(100);
+    connect(m_tokenRetryTimer, &QTimer::timeout, this, &CommandExecutor::scheduleReadyCommands);
+
+    // One store at a time: concurrent stores could evict each other's fresh blobs
+    m_artifactStorePool.setMaxThreadCount(1);
+
+    // Usage travels through queued connections too (e.g. the CLI's commandFinished handler)
+    qRegisterMetaType<ResourceUsage>("ResourceUsage");
+    m_resourceTimer->setInterval(500);
+    connect(m_resourceTimer, &QTimer::timeout, this, &CommandExecutor::sampleResourceUsage);
+
+    // Child output is coalesced into frames instead of one signal per read
+    m_logFlushTimer->setSingleShot(true);
+    m_logFlushTimer->setInterval(LOG_FRAME_INTERVAL_MS);
+    connect(m_logFlushTimer, &QTimer::timeout, this, &CommandExecutor::flushLog);
+
+    setCpuBudget(QThread::idealThreadCount());
+}
+
+/**
+ * @brief Set total core budget and recreate the jobserver token pool
+ * @param cores Number of tokens (minimum 1)
+ */
+void CommandExecutor::setCpuBudget(int cores)
+{
+    m_cpuBudget = qMax(1, cores);
+
+    QString errorMsg;
+    if (!m_jobServer.start(m_cpuBudget, errorMsg))
+    {
+        // Builds still get a static --parallel share of the budget without a jobserver
+        qWarning() << "Jobserver disabled:" << errorMsg;
+    }
+}
+
+/**
+ * @brief Stop all jobs immediately (kill running processes, cancel queued jobs)
+ */
+void CommandExecutor::stopExecution()
+{
+    if (!m_isExecuting) return;
+
+    for (BuildJob& job : m_jobs)
+    {
+        if (job.status != JobQueued && job.status != JobRunning) continue;
+        killJobCommands(job);
+        setJobStatus(job, JobCancelled);
+        flushLog();
+        emit jobFinished(job.id, job.name, false, "", "Execution stopped");
+    }
+
+    // killJobCommands() detached every running command
+    Q_ASSERT(m_runningCount == 0);
+    m_isExecuting = false;
+    // A pending counter query belongs to the stopped batch
+    m_compilerCacheQuery++;
+    m_isSamplingCompilerCache = false;
+    m_isWaitingForTimingReports = false;
+    postLog(formatRealTimeLog("Execution stopped by user!"), true);
+    writeTrace();
+    flushLog();
+    emit commandFinished(false, "", "Execution stopped", m_batchUsage);
+}
+
+/**
+ * @brief Real-time read of stdout (non-blocking)
+ * @note Triggered by QProcess::readyReadStandardOutput signal of any slot
+ */
+void CommandExecutor::onReadyReadStandardOutput()
+{
+    int slotIdx = slotIndexOf(sender());
+    if (slotIdx < 0) return;
+    ProcessSlot& slot = m_slots[slotIdx];
+    QString content = QString::fromLocal8Bit(slot.process->readAllStandardOutput());
+    int jobIdx = jobIndexOf(slot.jobId);
+    if (slot.nodeIdx < 0 || jobIdx < 0) return;
+    slot.stdoutCapture.append(content);
+    slot.stdoutScanner.feed(content);
+    QString errorLine = collectDiagnostics(slot, m_jobs[jobIdx].name);
+    postOutput(content, m_jobs[jobIdx].nodes[slot.nodeIdx].chain, false);
+
+    if (m_jobs[jobIdx].failFast && !errorLine.isEmpty())
+    {
+        abortOnFatalDiagnostic(slotIdx, errorLine);
+    }
+}
+
+/**
+ * @brief Real-time read of stderr (non-blocking)
+ * @note Triggered by QProcess::readyReadStandardError signal of any slot
+ */
+void CommandExecutor::onReadyReadStandardError()
+{
+    int slotIdx = slotIndexOf(sender());
+    if (slotIdx < 0) return;
+    ProcessSlot& slot = m_slots[slotIdx];
+    QString content = QString::fromLocal8Bit(slot.process->readAllStandardError());
+    int jobIdx = jobIndexOf(slot.jobId);
+    if (slot.nodeIdx < 0 || jobIdx < 0) return;
+    slot.stderrCapture.append(content);
+    slot.stderrScanner.feed(content);
+    QString errorLine = collectDiagnostics(slot, m_jobs[jobIdx].name);
+    postOutput(content, m_jobs[jobIdx].nodes[slot.nodeIdx].chain, true);
+
+    if (m_jobs[jobIdx].failFast && !errorLine.isEmpty())
+    {
+        abortOnFatalDiagnostic(slotIdx, errorLine);
+    }
+}
+
+/**
+ * @brief Parse the diagnostic candidates found by the scanners of a slot
+ * @param slot Slot whose scanners received output
+ * @param jobName Job owning the running command (recorded on first report)
+ * @return First line parsed as an error (empty = none); fail-fast aborts on it
+ * @note Only lines containing an error keyword or "warning" reach the parser, so the generic keyword
+ *       alone (error.cpp, "0 Error(s)") never counts as an error
+ */
+QString CommandExecutor::collectDiagnostics(ProcessSlot& slot, const QString& jobName)
+{
+    QString errorLine;
+    const QStringList lines = slot.stdoutScanner.takeDiagnosticLines() + slot.stderrScanner.takeDiagnosticLines();
+    for (const QString& line : lines)
+    {
+        Diagnostic diagnostic;
+        if (!DiagnosticParser::parse(line, diagnostic)) continue;
+        diagnostic.job = jobName;
+        m_diagnostics->add(diagnostic);
+        if (diagnostic.severity != Diagnostic::Error) continue;
+        slot.errorCount++;
+        if (errorLine.isEmpty()) errorLine = line;
+    }
+    return errorLine;
+}
+
+/**
+ * @brief Sample CPU, memory and I/O of every running command's process tree
+ * @note Linux reads /proc of the whole host for one snapshot on the thread pool (a tick is skipped while the
+ *       previous snapshot is still being read); Windows counts exactly through job objects and is sampled
+ *       only for the trace counters
+ */
+void CommandExecutor::sampleResourceUsage()
+{
+    if (m_runningCount == 0)
+    {
+        m_resourceTimer->stop();
+        return;
+    }
+
+    if (!ResourceMonitor::needsSampling())
+    {
+        for (ProcessSlot& slot : m_slots)
+        {
+            if (slot.nodeIdx >= 0) slot.monitor.sample(QMultiHash<qint64, qint64>());
+        }
+        traceResourceUsage();
+        return;
+    }
+    if (m_isSamplingResources) return;
+
+    QList<qint64> pids;
+    for (const ProcessSlot& slot : qAsConst(m_slots))
+    {
+        if (slot.nodeIdx >= 0) pids << slot.monitor.pid();
+    }
+    m_isSamplingResources = true;
+
+    // Owned by the executor like the timing reports: a snapshot still being read is dropped with it
+    auto* watcher = new QFutureWatcher<QList<ResourceMonitor::Sample>>(this);
+    connect(watcher, &QFutureWatcher<QList<ResourceMonitor::Sample>>::finished, this, [this, watcher]() {
+        const QList<ResourceMonitor::Sample> samples = watcher->result();
+        watcher->deleteLater();
+        m_isSamplingResources = false;
+        // A command that finished meanwhile ignores its reading (its monitor moved on)
+        for (ProcessSlot& slot : m_slots)
+        {
+            if (slot.nodeIdx < 0) continue;
+            for (const ResourceMonitor::Sample& sample : samples) slot.monitor.add(sample);
+        }
+        traceResourceUsage();
+    });
+    watcher->setFuture(QtConcurrent::run([pids]() {
+        QMultiHash<qint64, qint64> children = ProcessTree::childrenByParent();
+        QList<ResourceMonitor::Sample> samples;
+        for (qint64 pid : pids) samples << ResourceMonitor::measure(pid, children);
+        return samples;
+    }));
+}
+
+/**
+ * @brief Add the CPU, memory and running-command counters of the trace from the latest samples
+ */
+void CommandExecutor::traceResourceUsage()
+{
+    if (!m_trace.isActive()) return;
+
+    // CPU time of the batch so far: finished commands plus the running ones as of this sample
+    auto cpuMsOf = [](const ResourceUsage& usage) { return qMax<qint64>(usage.userMs, 0) + qMax<qint64>(usage.systemMs, 0); };
+    qint64 cpuMs = cpuMsOf(m_batchUsage);
+    qint64 memoryKb = 0;
+    bool hasCpu = m_batchUsage.userMs >= 0;
+    for (const ProcessSlot& slot : qAsConst(m_slots))
+    {
+        if (slot.nodeIdx < 0) continue;
+        ResourceUsage usage = slot.monitor.current();
+        cpuMs += cpuMsOf(usage);
+        hasCpu = hasCpu || usage.userMs >= 0;
+        memoryKb += slot.monitor.memoryKb();
+    }
+
+    qint64 nowUs = m_trace.now();
+    m_trace.addCounter("Commands", QJsonObject{ { "running", m_runningCount } });
+    if (hasCpu && nowUs > m_traceSampleUs)
+    {
+        // macOS measures neither CPU nor memory of running commands
+        m_trace.addCounter("Memory (MB)", QJsonObject{ { "commands", memoryKb / 1024.0 } });
+        // Busy cores = CPU time per wall time of the interval
+        double cores = qMax<qint64>(0, cpuMs - m_traceCpuMs) * 1000.0 / (nowUs - m_traceSampleUs);
+        m_trace.addCounter("CPU (cores)", QJsonObject{ { "busy", cores } });
+    }
+    m_traceCpuMs = cpuMs;
+    m_traceSampleUs = nowUs;
+}
+
+/**
+ * @brief Add the span of a command that left its slot to the trace
+ * @param slotIdx Slot the command ran on
+ * @param job Job owning the command
+ * @param nodeIdx Node of the command
+ * @param result "exit <code>", "crashed" or "killed"
+ * @param usage Resources used by the command's process tree
+ */
+void CommandExecutor::traceCommand(int slotIdx, const BuildJob& job, int nodeIdx, const QString& result, const ResourceUsage& usage)
+{
+    if (!m_trace.isActive()) return;
+
+    const CommandNode& node = job.nodes[nodeIdx];
+    QString command = node.command.trimmed();
+    QString buildDir;
+    QString category = "command";
+    if (parseBuildCommand(command, buildDir)) category = "build";
+    else if (command.startsWith("cmake", Qt::CaseInsensitive)) category = "configure";
+
+    QJsonObject args;
+    args.insert("job", job.name);
+    args.insert("command", command);
+    args.insert("result", result);
+    args.insert("resources", usage.toJson());
+    QString label = node.chain.isEmpty() ? job.name : node.chain;
+    m_trace.addSpan(BuildTrace::slotTrack(slotIdx), category + " " + label, category,
+                    m_slots[slotIdx].traceStartUs, m_trace.now(), args);
+}
+
+/**
+ * @brief Log where the time of a build command went (slowest targets and TUs, change since the previous run)
+ * @param job Job owning the command
+ * @param nodeIdx Node of the command
+ * @param buildDir Build directory as written in the command
+ * @param buildOutput Stdout of the build (a copy: it keeps the spool after the slot is reset)
+ * @param wallMs Wall time of the command
+ * @param success True = the durations become the baseline of the next run (a failed build stops early)
+ * @note Collecting and saving run on the thread pool (.ninja_log, time traces and the spooled output can be
+ *       large); the formatted report comes back through a watcher, and the drained batch waits for it
+ */
+void CommandExecutor::reportBuildTimings(const BuildJob& job, int nodeIdx, const QString& buildDir, const OutputCapture& buildOutput,
+                                         qint64 wallMs, bool success)
+{
+    QString absBuildDir = QDir::cleanPath(QDir::isAbsolutePath(buildDir) ? buildDir : QDir(job.workingDir).filePath(buildDir));
+    // One second of slack for file systems with coarse modification times
+    QDateTime startedAt = QDateTime::currentDateTime().addMSecs(-wallMs - 1000);
+    QString chain = job.nodes[nodeIdx].chain;
+
+    // The watcher is owned by the executor: a report still being collected is dropped with it
+    auto* watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, chain]() {
+        QString breakdown = watcher->result();
+        watcher->deleteLater();
+        m_pendingTimingReports--;
+        if (!breakdown.isEmpty())
+        {
+            postLog(formatRealTimeLog(breakdown, chain), false);
+            saveLog(breakdown);
+        }
+        // The drained batch was waiting for its last report
+        if (m_pendingTimingReports == 0 && m_isWaitingForTimingReports)
+        {
+            m_isWaitingForTimingReports = false;
+            finishExecution();
+        }
+    });
+    m_pendingTimingReports++;
+    watcher->setFuture(QtConcurrent::run([absBuildDir, buildOutput, startedAt, success]() {
+        BuildTimings::Report report = BuildTimings::collect(absBuildDir, buildOutput, startedAt);
+        if (report.isEmpty()) return QString();
+        if (success) BuildTimings::save(report);
+        return BuildTimings::format(report);
+    }));
+}
+
+/**
+ * @brief Write the trace of the ending batch next to the log file
+ * @note Serialization and writing run on the thread pool; old traces beyond TRACE_BUDGET_BYTES are deleted
+ */
+void CommandExecutor::writeTrace()
+{
+    if (!m_trace.isActive()) return;
+
+    // Counters end at zero instead of holding their last sample
+    m_trace.addCounter("Commands", QJsonObject{ { "running", 0 } });
+    m_trace.addCounter("Memory (MB)", QJsonObject{ { "commands", 0 } });
+    m_trace.stop();
+
+    QString traceDir = QFileInfo(m_logFilePath).absolutePath();
+    QString tracePath = QString("%1/eazybuild_trace_%2.json").arg(traceDir, QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss_zzz"));
+    m_lastTracePath = tracePath;
+
+    BuildTrace trace = m_trace;
+    QThreadPool::globalInstance()->start([trace, traceDir, tracePath]() {
+        QDir().mkpath(traceDir);
+        QSaveFile file(tracePath);
+        if (!file.open(QIODevice::WriteOnly) || file.write(trace.toJson()) < 0 || !file.commit())
+        {
+            qWarning() << "Failed to write trace" << tracePath << file.errorString();
+            return;
+        }
+        LogArchive::enforceBudget(traceDir, "eazybuild_trace_*.json", TRACE_BUDGET_BYTES, tracePath);
+    });
+
+    QString logLine = formatRealTimeLog(QString("🧭 Build trace: %1 (open in chrome://tracing or ui.perfetto.dev)").arg(tracePath));
+    postLog(logLine, false);
+    saveLog(logLine);
+}
+
+/**
+ * @brief Fail a job at the first fatal diagnostic without waiting for its commands to exit
+ * @param slotIdx Slot whose output contained the diagnostic
+ * @param diagnostic Diagnostic line (becomes the head of the job's error report)
+ * @note The failing command and every parallel sibling of the job are killed with their process trees;
+ *       other jobs keep running
+ */
+void CommandExecutor::abortOnFatalDiagnostic(int slotIdx, const QString& diagnostic)
+{
+    ProcessSlot& slot = m_slots[slotIdx];
+    int jobIdx = jobIndexOf(slot.jobId);
+    if (slot.nodeIdx < 0 || jobIdx < 0) return;
+
+    BuildJob& job = m_jobs[jobIdx];
+    int nodeIdx = slot.nodeIdx;
+    QString currentCmd = job.nodes[nodeIdx].command;
+    QString chain = job.nodes[nodeIdx].chain;
+    QString cmdStdout = slot.stdoutCapture.text();
+    QString cmdStderr = "[Fail-fast] " + diagnostic;
+    if (!slot.stderrCapture.isEmpty()) cmdStderr += "\n" + slot.stderrCapture.text();
+
+    job.nodeStates[nodeIdx] = NodeFailed;
+    if (!job.hasFailure)
+    {
+        job.hasFailure = true;
+        job.failedStdout = cmdStdout;
+        job.failedStderr = cmdStderr;
+    }
+    updateConfigureCache(job, nodeIdx, false);
+
+    saveCommandLog(job.name, currentCmd, "killed (fail-fast)", slot.stdoutCapture, slot.stderrCapture,
+                   "[Fail-fast] " + diagnostic, slot.monitor.current(), true);
+    m_trace.addInstant(BuildTrace::jobTrack(job.id), "fail-fast", "abort",
+                       QJsonObject{ { "diagnostic", diagnostic }, { "command", currentCmd } });
+
+    int siblingCount = job.runningCount - 1;
+    postLog(formatRealTimeLog(QString("⛔ Fail-fast: %1\nStopping %2 (%3 parallel command(s) killed)")
+                                          .arg(diagnostic, currentCmd).arg(siblingCount), chain), true);
+    if (currentCmd.startsWith("cmake", Qt::CaseInsensitive))
+    {
+        flushLog();
+        emit cmakeFailed(cmdStderr, currentCmd);
+    }
+
+    killJobCommands(job);
+    // Nothing of the job runs any more: it is finished and reported right away
+    scheduleReadyCommands();
+}
+
+/**
+ * @brief Format real-time log with timestamp prefix for each line
+ * @param content Raw log content from process output
+ * @param tag Optional chain label (distinguishes interleaved output of parallel commands)
+ * @return Formatted log string with standardized timestamp
+ */
+QString CommandExecutor::formatRealTimeLog(const QString& content, const QString& tag)
+{
+    if (content.isEmpty()) return "";
+    QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+    if (!tag.isEmpty())
+    {
+        timestamp += " [" + tag + "]";
+    }
+    QStringList lines = content.split("\n", Qt::SkipEmptyParts);
+    QStringList formattedLines;
+    for (const QString& line : lines)
+    {
+        formattedLines.append(timestamp + " " + line);
+    }
+    return formattedLines.join("\n") + "\n";
+}
+
+/**
+ * @brief Queue formatted log content for the next log frame
+ * @param content Formatted log content (see formatRealTimeLog)
+ * @param isError True = error log, False = normal log
+ */
+void CommandExecutor::postLog(const QString& content, bool isError)
+{
+    if (content.isEmpty()) return;
+    LogEntry entry;
+    entry.text = content;
+    entry.isError = isError;
+    appendLogEntry(entry);
+}
+
+/**
+ * @brief Queue raw process output for the next log frame
+ * @param content Output chunk as read from the process
+ * @param tag Chain label of the command
+ * @param isError True = stderr, False = stdout
+ * @note Consecutive chunks of the same stream are joined and timestamped once per frame,
+ *       so a line split across reads is no longer logged as two lines
+ */
+void CommandExecutor::postOutput(const QString& content, const QString& tag, bool isError)
+{
+    if (content.isEmpty()) return;
+    if (!m_logFrame.isEmpty())
+    {
+        LogEntry& last = m_logFrame.last();
+        if (last.isRaw && last.isError == isError && last.tag == tag)
+        {
+            last.text += content;
+            m_logFrameChars += content.size();
+            if (m_logFrameChars >= LOG_FRAME_MAX_CHARS) flushLog();
+            return;
+        }
+    }
+
+    LogEntry entry;
+    entry.text = content;
+    entry.tag = tag;
+    entry.isError = isError;
+    entry.isRaw = true;
+    appendLogEntry(entry);
+}
+
+/**
+ * @brief Add an entry to the pending log frame and make sure the frame gets flushed
+ */
+void CommandExecutor::appendLogEntry(const LogEntry& entry)
+{
+    m_logFrame.append(entry);
+    m_logFrameChars += entry.text.size();
+    if (m_logFrameChars >= LOG_FRAME_MAX_CHARS)
+    {
+        flushLog();
+    }
+    else if (!m_logFlushTimer->isActive())
+    {
+        m_logFlushTimer->start();
+    }
+}
+
+/**
+ * @brief Deliver the pending log frame
+ * @note One logUpdated per run of equally colored entries (stdout/stderr order is kept)
+ * @note Called before jobFinished/commandFinished/cmakeFailed so receivers see the log first
+ */
+void CommandExecutor::flushLog()
+{
+    m_logFlushTimer->stop();
+    if (m_logFrame.isEmpty()) return;
+
+    QList<LogEntry> frame;
+    frame.swap(m_logFrame);
+    m_logFrameChars = 0;
+
+    QString run;
+    bool runIsError = frame.first().isError;
+    for (const LogEntry& entry : qAsConst(frame))
+    {
+        if (entry.isError != runIsError && !run.isEmpty())
+        {
+            emit logUpdated(run, runIsError);
+            run.clear();
+        }
+        runIsError = entry.isError;
+        run += entry.isRaw ? formatRealTimeLog(entry.text, entry.tag) : entry.text;
+    }
+    if (!run.isEmpty()) emit logUpdated(run, runIsError);
+}
+
+void CommandExecutor::setLogFilePath(const QString& path)
+{
+    m_logFilePath = path;
+    applyLogRotation();
+}
+
+void CommandExecutor::setLogRotation(qint64 segmentBytes, qint64 budgetBytes)
+{
+    m_logSegmentBytes = qMax<qint64>(0, segmentBytes);
+    m_logBudgetBytes = qMax<qint64>(0, budgetBytes);
+    applyLogRotation();
+}
+
+void CommandExecutor::flushLogFile()
+{
+    m_logWriter->flush(true);
+}
+
+void CommandExecutor::applyLogRotation()
+{
+    // Timestamped default logs share one budget (older sessions are trimmed first);
+    // an explicit log file only covers its own rotated segments
+    QFileInfo info(m_logFilePath);
+    QString nameFilter = info.fileName().startsWith("cmd_exec_")
+                             ? QString("cmd_exec_*.log*")
+                             : QString("%1.*.%2*").arg(info.completeBaseName(), info.suffix());
+    m_logWriter->setRotation(m_logSegmentBytes, m_logBudgetBytes, nameFilter, m_logFilePath);
+}
+
+/**
+ * @brief Save log content to persistent file (with error/info marking)
+ * @param content Log content to save
+ * @param isError True = mark as ERROR log, False = mark as INFO log
+ * @note Queued to the log writer thread (buffered, written in large blocks)
+ */
+void CommandExecutor::saveLog(const QString& content, bool isError)
+{
+    m_logWriter->write(m_logFilePath, (isError ? "[ERROR] " : "[INFO] ") + content + "\n");
+}
+
+/**
+ * @brief Append the record of a finished command to the log file
+ * @param jobName Job owning the command
+ * @param command Executed command
+ * @param exitCode Exit code text
+ * @param stdoutCapture Captured stdout (written completely, also when only head and tail are in memory)
+ * @param stderrCapture Captured stderr
+ * @param stderrSuffix Appended to stderr (e.g. errors extracted from stdout)
+ * @param isError True = mark as ERROR log
+ * @note Same format as saveLog(); the writer thread streams the output, so no string of the whole output is built
+ */
+void CommandExecutor::saveCommandLog(const QString& jobName, const QString& command, const QString& exitCode,
+                                     const OutputCapture& stdoutCapture, const OutputCapture& stderrCapture,
+                                     const QString& stderrSuffix, const ResourceUsage& usage, bool isError)
+{
+    QVector<LogWriter::Part> parts(5);
+    parts[0].text = (isError ? "[ERROR] " : "[INFO] ")
+                    + QString("[%1] Job: %2\nCommand: %3\nExitCode: %4\nResources: %5\nStdout:\n")
+                          .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"), jobName, command, exitCode, usage.summary());
+    parts[1].capture = stdoutCapture;
+    parts[1].isCapture = true;
+    parts[2].text = "\nStderr:\n";
+    parts[3].capture = stderrCapture;
+    parts[3].isCapture = true;
+    if (!stderrSuffix.isEmpty())
+    {
+        parts[4].text = (stderrCapture.isEmpty() ? "" : "\n") + stderrSuffix;
+    }
+    parts[4].text += "\n---\n\n";
+    m_logWriter->write(m_logFilePath, parts);
+}
+
+/**
+ * @brief Get an idle process slot (grows the pool when every slot is busy)
+ * @return Slot index
+ * @note A killed process may still be reaping, so only NotRunning processes are reused
+ */
+int CommandExecutor::acquireFreeSlot()
+{
+    for (int i = 0; i < m_slots.size(); ++i)
+    {
+        if (m_slots[i].nodeIdx < 0 && m_slots[i].process->state() == QProcess::NotRunning)
+        {
+            return i;
+        }
+    }
+
+    ProcessSlot slot;
+    slot.process = new QProcess(this);
     // Bind process signals (fully asynchronous, no blocking calls)
-    connect(m_process, &QProcess::finished, this, &CommandExecutor::onSingleCommandFinished);
-    connect(m_process, &QProcess::readyReadStandardOutput, this, &CommandExecutor::onReadyReadStandardOutput);
-    connect(m_process, &QProcess::readyReadStandardError, this, &CommandExecutor::onReadyReadStandardError);
+    connect(slot.process, &QProcess::finished, this, &CommandExecutor::onSingleCommandFinished);
+    connect(slot.process, &QProcess::readyReadStandardOutput, this, &CommandExecutor::onReadyReadStandardOutput);
+    connect(slot.process, &QProcess::readyReadStandardError, this, &CommandExecutor::onReadyReadStandardError);
+    // Queued: start() may report FailedToStart while the scheduler loop is still running
+    connect(slot.process, &QProcess::errorOccurred, this, &CommandExecutor::onProcessErrorOccurred, Qt::QueuedConnection);
+    m_slots.append(slot);
+    return m_slots.size() - 1;
+}
+
+/**
+ * @brief Find the slot owning a process
+ * @param process Process instance (usually sender())
+ * @return Slot index or -1 if the process does not belong to the pool
+ */
+int CommandExecutor::slotIndexOf(const QObject* process) const
+{
+    for (int i = 0; i < m_slots.size(); ++i)
+    {
+        if (m_slots[i].process == process) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Find a job of the current batch by id
+ * @return Index in m_jobs or -1 if not found
+ */
+int CommandExecutor::jobIndexOf(int jobId) const
+{
+    for (int i = 0; i < m_jobs.size(); ++i)
+    {
+        if (m_jobs[i].id == jobId) return i;
+    }
+    return -1;
+}
+
+/**
+ * @brief Check whether a pending node can start (all dependencies succeeded)
+ */
+bool CommandExecutor::isNodeReady(const BuildJob& job, int nodeIdx) const
+{
+    if (job.nodeStates[nodeIdx] != NodePending) return false;
+
+    for (const QString& dep : job.nodes[nodeIdx].dependsOn)
+    {
+        bool satisfied = false;
+        for (int i = 0; i < job.nodes.size(); ++i)
+        {
+            if (job.nodes[i].id == dep)
+            {
+                satisfied = job.nodeStates[i] == NodeSucceeded;
+                break;
+            }
+        }
+        if (!satisfied) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Validate a command graph before execution
+ * @param nodes Graph nodes
+ * @param errorMsg Filled with a description when validation fails
+ * @return True = ids are unique, dependencies exist and the graph is acyclic
+ */
+bool CommandExecutor::validateGraph(const QList<CommandNode>& nodes, QString& errorMsg) const
+{
+    QHash<QString, int> indexById;
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        if (indexById.contains(nodes[i].id))
+        {
+            errorMsg = QString("Duplicate command id: %1").arg(nodes[i].id);
+            return false;
+        }
+        indexById.insert(nodes[i].id, i);
+    }
+
+    // Kahn's algorithm: every node must become ready at some point
+    QVector<int> inDegree(nodes.size(), 0);
+    QVector<QList<int>> dependents(nodes.size());
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        for (const QString& dep : nodes[i].dependsOn)
+        {
+            if (!indexById.contains(dep))
+            {
+                errorMsg = QString("Command %1 depends on unknown command %2").arg(nodes[i].id, dep);
+                return false;
+            }
+            dependents[indexById.value(dep)].append(i);
+            inDegree[i]++;
+        }
+    }
+
+    QList<int> ready;
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        if (inDegree[i] == 0) ready.append(i);
+    }
+    int visited = 0;
+    while (!ready.isEmpty())
+    {
+        int current = ready.takeFirst();
+        visited++;
+        for (int next : qAsConst(dependents[current]))
+        {
+            if (--inDegree[next] == 0) ready.append(next);
+        }
+    }
+
+    if (visited != nodes.size())
+    {
+        errorMsg = "Command dependency graph contains a cycle";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Update job status and notify listeners
+ */
+void CommandExecutor::setJobStatus(BuildJob& job, JobStatus status)
+{
+    if (job.status == status) return;
+    job.status = status;
+    if (status == JobRunning)
+    {
+        job.timer.start();
+        job.traceStartUs = m_trace.now();
+        m_trace.addSpan(BuildTrace::jobTrack(job.id), "queued", "queue", job.traceQueuedUs, job.traceStartUs);
+    }
+    else if (status != JobQueued && job.timer.isValid())
+    {
+        job.durationMs = job.timer.elapsed();
+        QString result = status == JobSucceeded ? "succeeded" : status == JobFailed ? "failed" : "cancelled";
+        m_trace.addSpan(BuildTrace::jobTrack(job.id), job.name, "job", job.traceStartUs, m_trace.now(),
+                        QJsonObject{ { "result", result }, { "durationMs", job.durationMs } });
+    }
+    else if (status == JobCancelled)
+    {
+        // Cancelled before it started
+        m_trace.addSpan(BuildTrace::jobTrack(job.id), "queued", "queue", job.traceQueuedUs, m_trace.now(),
+                        QJsonObject{ { "result", "cancelled" } });
+    }
+    emit jobStatusChanged(job.id, job.name, status);
+}
+
+/**
+ * @brief Collect the build directories a job writes
+ * @note Two jobs configuring the same dir with different options would corrupt each other
+ */
+QStringList CommandExecutor::collectBuildDirs(const BuildJob& job)
+{
+    QStringList buildDirs;
+    for (const CommandNode& node : job.nodes)
+    {
+        QString buildDir;
+        if (parseBuildCommand(node.command, buildDir))
+        {
+            buildDir = QDir::cleanPath(QDir::isAbsolutePath(buildDir) ? buildDir : QDir(job.workingDir).filePath(buildDir));
+        }
+        else if (node.command.trimmed().startsWith("cmake", Qt::CaseInsensitive))
+        {
+            QStringList args = CommandLine::split(node.command, m_baseEnvironment);
+            args.removeFirst();
+            if (!ConfigureCache::parseConfigureCommand(args, job.workingDir, buildDir)) continue;
+        }
+        else
+        {
+            continue;
+        }
+        buildDirs << buildDir;
+    }
+    for (const QString& delDir : job.delTasks)
+    {
+        buildDirs << QDir::cleanPath(delDir);
+    }
+    buildDirs.removeDuplicates();
+    return buildDirs;
 }
 
-/**
- * @brief Stop current execution immediately (kill running process)
- */
-void CommandExecutor::stopExecution()
-{
-    if (m_isExecuting && m_process->state() != QProcess::NotRunning) {
-        m_process->kill();
-        m_isExecuting = false;
-        m_currentAsyncCmdIdx = 0;
-        m_asyncCmds.clear();
-        m_currentCmdStdout.clear();
-        m_currentCmdStderr.clear();
-        emit logUpdated(formatRealTimeLog("Execution stopped by user!"), true);
-        emit commandFinished(false, "", "Execution stopped");
+/**
+ * @brief Check whether a queued job shares a build directory with a running job
+ */
+bool CommandExecutor::hasBuildDirConflict(const BuildJob& job) const
+{
+    for (const BuildJob& other : m_jobs)
+    {
+        if (other.status != JobRunning || other.id == job.id) continue;
+        for (const QString& buildDir : job.buildDirs)
+        {
+            if (other.buildDirs.contains(buildDir, Qt::CaseInsensitive)) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Start a queued job (delete tasks run right before its first command)
+ */
+void CommandExecutor::startJob(BuildJob& job)
+{
+    setJobStatus(job, JobRunning);
+    postLog(formatRealTimeLog(QString("🚀 Start executing job: %1").arg(job.name)), false);
+
+    if (!job.delTasks.empty())
+    {
+        executeDelCmds(job.delTasks);
+    }
+
+    restoreCachedArtifacts(job);
+}
+
+/**
+ * @brief Restore cached artifacts of a job
+ * @note A hit marks every node of the producing chain as done, so configure and compile are skipped
+ */
+void CommandExecutor::restoreCachedArtifacts(BuildJob& job)
+{
+    if (!m_artifactCacheEnabled) return;
+
+    for (int nodeIdx = 0; nodeIdx < job.nodes.size(); ++nodeIdx)
+    {
+        const CommandNode& node = job.nodes[nodeIdx];
+        if (node.cacheKey.isEmpty() || node.artifacts.isEmpty()) continue;
+        // Still being stored by an earlier build: a miss, the chain builds again
+        if (m_storingKeys.contains(node.cacheKey)) continue;
+
+        QString errorMsg;
+        qint64 traceStartUs = m_trace.now();
+        bool isRestored = m_artifactCache.restore(node.cacheKey, node.artifacts, errorMsg);
+        m_trace.addSpan(BuildTrace::EXECUTOR_TRACK, "cache " + (node.chain.isEmpty() ? job.name : node.chain), "cache",
+                        traceStartUs, m_trace.now(), QJsonObject{ { "job", job.name }, { "hit", isRestored } });
+        if (!isRestored) continue;
+
+        for (int i = 0; i < job.nodes.size(); ++i)
+        {
+            if (job.nodes[i].chain == node.chain) job.nodeStates[i] = NodeSucceeded;
+        }
+        QString restoreLog = QString("♻️ Artifacts restored from cache (build skipped): %1").arg(node.artifacts.join(", "));
+        postLog(formatRealTimeLog(restoreLog, node.chain), false);
+        saveLog(restoreLog, false);
+        notifyChainIfDone(job, node.chain);
     }
 }
 
 /**
- * @brief Real-time read of stdout (non-blocking)
- * @note Triggered by QProcess::readyReadStandardOutput signal
+ * @brief Store artifacts of a successfully finished node
+ * @note Hashing, copying and the LRU eviction run on the store thread; until the store is done, a restore
+ *       of the node's cache key misses
  */
-void CommandExecutor::onReadyReadStandardOutput()
+void CommandExecutor::storeNodeArtifacts(const BuildJob& job, int nodeIdx)
 {
-    QString content = QString::fromLocal8Bit(m_process->readAllStandardOutput());
-    m_currentCmdStdout += content;
-    emit logUpdated(formatRealTimeLog(content), false);
+    const CommandNode& node = job.nodes[nodeIdx];
+    if (!m_artifactCacheEnabled || node.cacheKey.isEmpty() || node.artifacts.isEmpty()) return;
+
+    QString key = node.cacheKey;
+    QString chain = node.chain;
+    QStringList artifacts = node.artifacts;
+    ArtifactCache cache = m_artifactCache;
+    m_storingKeys[key]++;
+
+    auto* watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, key, chain]() {
+        QString errorMsg = watcher->result();
+        watcher->deleteLater();
+        if (--m_storingKeys[key] == 0) m_storingKeys.remove(key);
+        if (!errorMsg.isEmpty())
+        {
+            postLog(formatRealTimeLog(QString("Artifact cache store failed: %1").arg(errorMsg), chain), true);
+        }
+    });
+    watcher->setFuture(QtConcurrent::run(&m_artifactStorePool, [cache, key, artifacts]() mutable {
+        QString errorMsg;
+        return cache.store(key, artifacts, errorMsg) ? QString() : errorMsg;
+    }));
 }
 
 /**
- * @brief Real-time read of stderr (non-blocking)
- * @note Triggered by QProcess::readyReadStandardError signal
+ * @brief Emit chainSucceeded once the last node of a chain succeeded
  */
-void CommandExecutor::onReadyReadStandardError()
+void CommandExecutor::notifyChainIfDone(const BuildJob& job, const QString& chain)
 {
-    QString content = QString::fromLocal8Bit(m_process->readAllStandardError());
-    m_currentCmdStderr += content;
-    emit logUpdated(formatRealTimeLog(content), true);
+    if (chain.isEmpty()) return;
+
+    for (int i = 0; i < job.nodes.size(); ++i)
+    {
+        if (job.nodes[i].chain == chain && job.nodeStates[i] != NodeSucceeded) return;
+    }
+    emit chainSucceeded(job.id, chain);
 }
 
 /**
- * @brief Format real-time log with timestamp prefix for each line
- * @param content Raw log content from process output
- * @return Formatted log string with standardized timestamp
+ * @brief Kill all running commands of a job and detach their slots
+ * @note Late finished() signals of the killed processes are ignored
  */
-QString CommandExecutor::formatRealTimeLog(const QString& content)
+void CommandExecutor::killJobCommands(BuildJob& job)
 {
-    if (content.isEmpty()) return "";
-    QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
-    QStringList lines = content.split("\n", Qt::SkipEmptyParts);
-    QStringList formattedLines;
-    for (const QString& line : lines)
+    for (int slotIdx = 0; slotIdx < m_slots.size(); ++slotIdx)
     {
-        formattedLines.append(timestamp + " " + line);
+        ProcessSlot& slot = m_slots[slotIdx];
+        if (slot.jobId != job.id || slot.nodeIdx < 0) continue;
+        ResourceUsage usage = slot.monitor.finish();
+        m_batchUsage.add(usage);
+        traceCommand(slotIdx, job, slot.nodeIdx, "killed", usage);
+        slot.nodeIdx = -1;
+        slot.jobId = -1;
+        slot.stdoutCapture.reset();
+        slot.stderrCapture.reset();
+        slot.stdoutScanner.reset();
+        slot.stderrScanner.reset();
+        slot.errorCount = 0;
+        releaseSlotTokens(slot);
+        if (slot.process->state() != QProcess::NotRunning)
+        {
+            // cmake --build leaves the generator's tool and its compilers behind unless the whole tree goes
+            ProcessTree::kill(slot.process->processId());
+            slot.process->kill();
+            // Tokens taken by the killed build's own children are never returned
+            m_jobServerNeedsReset = true;
+        }
+        m_runningCount--;
     }
-    return formattedLines.join("\n") + "\n";
+    job.runningCount = 0;
 }
 
 /**
- * @brief Extract complete error lines from stdout using predefined error keywords
- * @param stdoutContent Full stdout content of current command
- * @return Extracted complete error lines (joined by newlines, one line per error)
- * @note Uses the same error keywords as isCmakeReallyFailed for consistency
+ * @brief Start queued jobs and every ready node while free slots remain (scheduling core)
+ * @note Called on enqueue and after each command finishes
+ * @note After a failure no new nodes of that job are started; the job finishes once its running nodes drain
  */
-QString CommandExecutor::extractErrorsFromStdout(const QString& stdoutContent)
+void CommandExecutor::scheduleReadyCommands()
 {
-    if (stdoutContent.isEmpty()) return "";
+    if (!m_isExecuting) return;
+
+    // Promote queued jobs while job slots are free
+    int runningJobs = 0;
+    for (const BuildJob& job : qAsConst(m_jobs))
+    {
+        if (job.status == JobRunning) runningJobs++;
+    }
+    for (BuildJob& job : m_jobs)
+    {
+        if (runningJobs >= m_maxConcurrentJobs) break;
+        if (job.status != JobQueued) continue;
+        // Jobs sharing a build dir run one after another (later jobs may overtake)
+        if (hasBuildDirConflict(job)) continue;
+        startJob(job);
+        runningJobs++;
+    }
+
+    // Start ready nodes of running jobs (queue order = priority)
+    for (int jobIdx = 0; jobIdx < m_jobs.size(); ++jobIdx)
+    {
+        if (m_jobs[jobIdx].status != JobRunning || m_jobs[jobIdx].hasFailure) continue;
 
-    // Predefined error keywords (matches isCmakeReallyFailed logic)
-    QStringList errorKeywords =
+        for (int nodeIdx = 0; nodeIdx < m_jobs[jobIdx].nodes.size() && m_runningCount < m_maxParallelCommands; ++nodeIdx)
         {
-        "error",          // Generic error (C/C++ compiler)
-        "fatal error",    // Fatal compilation error
-        "c2146",          // Specific syntax error code you mentioned
-        "c2065",          // Undeclared identifier
-        "c2059",          // Syntax error
-        "link : fatal",   // Link error
-        "undefined reference" // Link error (Linux)
-    };
+            BuildJob& job = m_jobs[jobIdx];
+            if (!isNodeReady(job, nodeIdx)) continue;
 
-    // Split content into individual lines (process complete lines only)
-    QStringList lines = stdoutContent.split("\n", Qt::SkipEmptyParts);
-    QStringList errorLines;
+            // Skip empty commands
+            if (job.nodes[nodeIdx].command.trimmed().isEmpty())
+            {
+                job.nodeStates[nodeIdx] = NodeSucceeded;
+                notifyChainIfDone(job, job.nodes[nodeIdx].chain);
+                nodeIdx = -1; // Dependents of the skipped node may be ready now
+                continue;
+            }
 
-    // Iterate each line to check for error keywords (case-insensitive)
-    for (const QString& line : lines)
+            // Skip configure steps whose arguments and toolchain are unchanged
+            if (skipUpToDateConfigure(job, nodeIdx))
+            {
+                job.nodeStates[nodeIdx] = NodeSucceeded;
+                nodeIdx = -1;
+                continue;
+            }
+
+            // Builds wait here until the jobserver hands out a token
+            QString command;
+            QByteArray tokens;
+            if (!prepareBuildCommand(job, nodeIdx, command, tokens))
+            {
+                m_tokenRetryTimer->start();
+                continue;
+            }
+
+            int slotIdx = acquireFreeSlot();
+            startCommandOnSlot(slotIdx, m_jobs[jobIdx], nodeIdx, command, tokens);
+            if (!m_isExecuting) return;
+        }
+    }
+
+    // Finish jobs that have nothing running and nothing more to start
+    for (int jobIdx = 0; jobIdx < m_jobs.size(); ++jobIdx)
     {
-        QString trimmedLine = line.trimmed();
-        QString lowerLine = trimmedLine.toLower(); // Convert to lowercase for case-insensitive match
+        BuildJob& job = m_jobs[jobIdx];
+        if (job.status != JobRunning || job.runningCount > 0) continue;
 
-        // Check if line contains ANY of the error keywords
-        bool isErrorLine = false;
-        for (const QString& keyword : errorKeywords)
+        bool canContinue = false;
+        if (!job.hasFailure)
         {
-            if (lowerLine.contains(keyword.toLower()))
+            for (int nodeIdx = 0; nodeIdx < job.nodes.size(); ++nodeIdx)
             {
-                isErrorLine = true;
-                break; // Stop checking keywords once match found
+                if (job.nodeStates[nodeIdx] == NodePending)
+                {
+                    canContinue = true;
+                    break;
+                }
             }
         }
-
-        // Add to error lines if keyword matched (avoid empty lines)
-        if (isErrorLine && !trimmedLine.isEmpty())
+        // Pending nodes without running ones are waiting for a command slot held by another job
+        if (!canContinue)
         {
-            errorLines.append(trimmedLine);
+            finishJob(job);
+            // A finished job frees a job slot: schedule the next queued job
+            scheduleReadyCommands();
+            return;
         }
     }
 
-    // Remove duplicate error lines (avoid redundant entries)
-    errorLines.removeDuplicates();
-
-    // Join error lines with newlines (one error per line)
-    return errorLines.join("\n");
+    bool hasActiveJob = false;
+    for (const BuildJob& job : qAsConst(m_jobs))
+    {
+        if (job.status == JobQueued || job.status == JobRunning)
+        {
+            hasActiveJob = true;
+            break;
+        }
+    }
+    if (!hasActiveJob)
+    {
+        finishExecution();
+    }
 }
 
 /**
- * @brief Save log content to persistent file (with error/info marking)
- * @param content Log content to save
- * @param isError True = mark as ERROR log, False = mark as INFO log
+ * @brief Start a graph node on the given process slot
+ * @param slotIdx Index of an idle slot
+ * @param job Job owning the node
+ * @param nodeIdx Index of a ready node
+ * @param command Command line to run
+ * @param tokens Jobserver tokens reserved for the command (returned when it finishes)
  */
-void CommandExecutor::saveLog(const QString& content, bool isError)
+void CommandExecutor::startCommandOnSlot(int slotIdx, BuildJob& job, int nodeIdx, const QString& command, const QByteArray& tokens)
 {
-    QFile logFile(m_logFilePath);
-    if (!logFile.open(QIODevice::Append | QIODevice::Text))
+    ProcessSlot& slot = m_slots[slotIdx];
+    const CommandNode& node = job.nodes[nodeIdx];
+    QString currentCmd = command.trimmed();
+
+    // Clear output buffers for the new command
+    slot.stdoutCapture.reset();
+    slot.stderrCapture.reset();
+    slot.stdoutScanner.reset();
+    slot.stderrScanner.reset();
+    slot.errorCount = 0;
+    slot.heldTokens = tokens;
+    slot.jobId = job.id;
+    slot.nodeIdx = nodeIdx;
+    job.nodeStates[nodeIdx] = NodeRunning;
+    job.runningCount++;
+    job.startedCount++;
+    m_runningCount++;
+
+    // Emit progress signal (for UI display)
+    emit commandProgress(job.startedCount, job.nodes.size(), currentCmd, m_batchUsage);
+    postLog(formatRealTimeLog(QString("📝 Executing command (%1/%2): %3").arg(job.startedCount).arg(job.nodes.size()).arg(currentCmd), node.chain), false);
+
+    // Advertise the shared jobserver to make/ninja clients
+    QProcessEnvironment env = m_baseEnvironment;
+    if (m_jobServer.isActive())
     {
-        qWarning() << "Failed to open log file:" << logFile.errorString();
-        emit logUpdated(formatRealTimeLog("Failed to open log file: " + logFile.errorString()), true);
-        return;
+        env.insert("MAKEFLAGS", m_jobServer.makeflags());
     }
+    slot.process->setProcessEnvironment(env);
 
-    QTextStream stream(&logFile);
-    if (isError)
+    // Spawn the program directly; only pipes, redirection, chaining and shell builtins need a shell
+    bool needsShell = false;
+    QStringList args = CommandLine::split(currentCmd, env, &needsShell);
+    QString program = (needsShell || args.isEmpty()) ? QString() : resolveProgram(args.first());
+    if (!program.isEmpty())
+    {
+        args.removeFirst();
+        slot.process->setProgram(program);
+        slot.process->setArguments(args);
+    }
+    // Windows shell commands (via cmd.exe)
+    else if (QOperatingSystemVersion::currentType() == QOperatingSystemVersion::Windows)
     {
-        stream << "[ERROR] " << content << "\n";
+        slot.process->setProgram("cmd.exe");
+        slot.process->setArguments(QStringList() << "/c" << currentCmd);
     }
+    // Linux/macOS shell commands (via bash)
     else
     {
-        stream << "[INFO] " << content << "\n";
+        slot.process->setProgram("bash");
+        slot.process->setArguments(QStringList() << "-c" << currentCmd);
     }
-    logFile.close();
+
+    // Set working directory if valid
+    if (!job.workingDir.isEmpty() && QDir(job.workingDir).exists())
+    {
+        slot.process->setWorkingDirectory(job.workingDir);
+    }
+
+    // Start process (non-blocking - returns immediately)
+    m_trace.nameTrack(BuildTrace::slotTrack(slotIdx), QString("Slot %1").arg(slotIdx + 1), 1 + slotIdx);
+    slot.traceStartUs = m_trace.now();
+    slot.process->start();
+
+    // The pid exists once start() returns (0 = failed to start)
+    slot.monitor.start(slot.process->processId());
+    bool needsSampling = ResourceMonitor::needsSampling() || m_trace.isActive();
+    if (needsSampling && !m_resourceTimer->isActive()) m_resourceTimer->start();
 }
 
 /**
- * @brief Enhanced CMake failure detection (includes compile errors from stdout)
- * @param cmd Executed CMake command
- * @param exitCode Process exit code (0 = success)
- * @param exitStatus Process exit status (NormalExit/CrashExit)
- * @param stderrLog Combined stderr (including extracted errors from stdout)
- * @return True = CMake command failed (process error or compile error)
+ * @brief Extract build directory from a "cmake --build <dir> ..." command
+ * @param cmd Command line
+ * @param buildDir Receives the build directory (as written in the command)
+ * @return True = command is a cmake build command
+ */
+bool CommandExecutor::parseBuildCommand(const QString& cmd, QString& buildDir) const
+{
+    QStringList args = CommandLine::split(cmd, m_baseEnvironment);
+    if (args.size() < 3 || QFileInfo(args[0]).completeBaseName().compare("cmake", Qt::CaseInsensitive) != 0 || args[1] != "--build") return false;
+    buildDir = args[2];
+    return true;
+}
+
+/**
+ * @brief Resolve the program of a directly spawned command
+ * @param program First word of the command line
+ * @return Absolute executable path (empty = not found on PATH, e.g. a shell builtin such as "copy" or "cd")
+ * @note Lookups are cached; paths containing a directory separator are used as written
+ */
+QString CommandExecutor::resolveProgram(const QString& program)
+{
+    if (program.contains('/') || program.contains('\\')) return program;
+
+    auto it = m_programPathCache.constFind(program);
+    if (it != m_programPathCache.constEnd()) return it.value();
+
+    QStringList searchPaths = m_baseEnvironment.value("PATH").split(QDir::listSeparator(), Qt::SkipEmptyParts);
+    QString path = QStandardPaths::findExecutable(program, searchPaths);
+    m_programPathCache.insert(program, path);
+    return path;
+}
+
+/**
+ * @brief Check whether the build tool of a configured build dir takes tokens from the jobserver
+ * @param buildDir Absolute build directory
+ * @return True = Ninja >= 1.13 or GNU make with jobserver support for our auth style
+ * @note Visual Studio/MSBuild ignores MAKEFLAGS, so it only gets a static share
  */
-bool CommandExecutor::isCmakeReallyFailed(const QString& stderrLog)
+bool CommandExecutor::isJobserverAwareBuild(const QString& buildDir)
 {
-    // Check error keywords in combined stderr (including extracted errors)
-    QString lowerStderr = stderrLog.toLower();
+    QFile cacheFile(buildDir + "/CMakeCache.txt");
+    if (!cacheFile.open(QIODevice::ReadOnly | QIODevice::Text)) return false;
 
-    QStringList errorKeywords =
+    QString generator;
+    QString makeProgram;
+    while (!cacheFile.atEnd())
+    {
+        QString line = QString::fromUtf8(cacheFile.readLine()).trimmed();
+        if (line.startsWith("CMAKE_GENERATOR:INTERNAL="))
+        {
+            generator = line.mid(line.indexOf('=') + 1);
+        }
+        else if (line.startsWith("CMAKE_MAKE_PROGRAM:"))
         {
-        "error",          // Generic error (C/C++ compiler)
-        "fatal error",    // Fatal compilation error
-        "c2146",          // Specific syntax error code you mentioned
-        "c2065",          // Undeclared identifier
-        "c2059",          // Syntax error
-        "link : fatal",   // Link error
-        "undefined reference" // Link error (Linux)
-    };
+            makeProgram = line.mid(line.indexOf('=') + 1);
+        }
+    }
+
+    bool isNinja = generator.startsWith("Ninja");
+    bool isMake = generator.endsWith("Makefiles") && !generator.startsWith("NMake");
+    if ((!isNinja && !isMake) || makeProgram.isEmpty()) return false;
 
-    for (const QString& keyword : errorKeywords)
+    auto cached = m_jobserverToolCache.constFind(makeProgram);
+    if (cached != m_jobserverToolCache.constEnd()) return cached.value();
+
+    // Query tool version once (fifo auth needs GNU make 4.4, Ninja needs 1.13)
+    QProcess versionProcess;
+    versionProcess.start(makeProgram, QStringList() << "--version");
+    bool supported = false;
+    if (versionProcess.waitForFinished(3000))
     {
-        if (lowerStderr.contains(keyword) && !lowerStderr.contains("error.cpp")) return true;
+        QString versionText = QString::fromLocal8Bit(versionProcess.readAllStandardOutput());
+        QRegularExpressionMatch match = QRegularExpression(R"((\d+)\.(\d+))").match(versionText);
+        if (match.hasMatch())
+        {
+            int version = match.captured(1).toInt() * 100 + match.captured(2).toInt();
+            if (isNinja)
+            {
+                supported = version >= 113;
+            }
+            else
+            {
+                bool isWindows = QOperatingSystemVersion::currentType() == QOperatingSystemVersion::Windows;
+                supported = versionText.contains("GNU Make") && version >= (isWindows ? 400 : 404);
+            }
+        }
     }
-    return false;
+    m_jobserverToolCache.insert(makeProgram, supported);
+    return supported;
 }
 
 /**
- * @brief Parse CMake arguments to preserve space-containing values (critical for "-G Visual Studio 16 2019")
- * @param cmd Full CMake command string (e.g., "cmake -S. -B build -G Visual Studio 16 2019")
- * @return Properly split argument list (space-containing generator name as single item)
+ * @brief Reserve jobserver tokens for a node and inject matching parallelism flags
+ * @param job Job owning the node
+ * @param nodeIdx Index of a ready node
+ * @param command Receives the command line to run
+ * @param tokens Receives the reserved tokens
+ * @return False = build must wait for a token
  */
-QStringList CommandExecutor::parseCmakeArguments(const QString& cmd)
+bool CommandExecutor::prepareBuildCommand(const BuildJob& job, int nodeIdx, QString& command, QByteArray& tokens)
 {
-    QStringList result;
-    QString trimmedCmd = cmd.trimmed();
-    int pos = 0;
-    int len = trimmedCmd.length();
+    command = job.nodes[nodeIdx].command;
+    tokens.clear();
 
-    while (pos < len)
-    {
-        // Skip consecutive whitespace
-        while (pos < len && trimmedCmd[pos].isSpace()) pos++;
-        if (pos >= len) break;
+    QString buildDir;
+    if (!parseBuildCommand(command, buildDir)) return true;
+
+    // Respect explicit parallelism given by the caller
+    static const QRegularExpression parallelRegex(R"((\s--parallel\b|\s-j\s*\d*\b))");
+    bool hasExplicitParallel = parallelRegex.match(command).hasMatch();
 
-        // Special handling for -G parameter (preserve full generator name with spaces)
-        if (trimmedCmd.mid(pos, 2) == "-G" && (pos + 2 == len || trimmedCmd[pos + 2].isSpace()))
+    QString absBuildDir = QDir::isAbsolutePath(buildDir) ? buildDir : QDir(job.workingDir).filePath(buildDir);
+    bool jobserverAware = m_jobServer.isActive() && isJobserverAwareBuild(absBuildDir);
+
+    // Static share: split the budget across running and ready builds
+    int wanted = 1;
+    if (!jobserverAware)
+    {
+        int activeBuilds = 1;
+        for (const ProcessSlot& slot : qAsConst(m_slots))
         {
-            result << "-G";
-            pos += 2;
-            // Skip whitespace after -G
-            while (pos < len && trimmedCmd[pos].isSpace()) pos++;
-            // Extract full generator name (until next parameter starting with '-')
-            int generatorStart = pos;
-            while (pos < len)
+            if (slot.nodeIdx >= 0 && !slot.heldTokens.isEmpty()) activeBuilds++;
+        }
+        for (const BuildJob& other : qAsConst(m_jobs))
+        {
+            if (other.status != JobRunning || other.hasFailure) continue;
+            for (int i = 0; i < other.nodes.size(); ++i)
             {
-                if (trimmedCmd[pos] == '-' && (pos == 0 || trimmedCmd[pos-1].isSpace())) break;
-                pos++;
+                QString otherDir;
+                if ((&other != &job || i != nodeIdx) && isNodeReady(other, i) && parseBuildCommand(other.nodes[i].command, otherDir)) activeBuilds++;
             }
-            // Add generator name as single argument (trim extra whitespace)
-            QString generator = trimmedCmd.mid(generatorStart, pos - generatorStart).trimmed();
-            result << generator;
         }
-        // Normal parameters (-D/-S/-B etc.) - split by whitespace
-        else
+        wanted = qMax(1, m_cpuBudget / activeBuilds);
+    }
+
+    if (m_jobServer.isActive())
+    {
+        char token;
+        while (tokens.size() < wanted && m_jobServer.tryAcquire(token))
         {
-            int argStart = pos;
-            while (pos < len && !trimmedCmd[pos].isSpace()) pos++;
-            QString arg = trimmedCmd.mid(argStart, pos - argStart);
-            result << arg;
+            tokens.append(token);
         }
+        if (tokens.isEmpty()) return false;
+    }
+
+    if (!jobserverAware && !hasExplicitParallel)
+    {
+        int parallel = tokens.isEmpty() ? wanted : tokens.size();
+        command += QString(" --parallel %1").arg(parallel);
+    }
+    if (m_buildTimingsEnabled)
+    {
+        command = BuildTimings::withPerformanceSummary(command, absBuildDir);
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether a configure node can be skipped
+ * @param job Job owning the node
+ * @param nodeIdx Index of a ready node
+ * @return True = same arguments/generator/toolchain as the last successful configure of its build dir
+ */
+bool CommandExecutor::skipUpToDateConfigure(BuildJob& job, int nodeIdx)
+{
+    const CommandNode& node = job.nodes[nodeIdx];
+    if (!m_configureCacheEnabled || !node.command.trimmed().startsWith("cmake", Qt::CaseInsensitive)) return false;
+
+    QStringList args = CommandLine::split(node.command, m_baseEnvironment);
+    args.removeFirst();
+    QString buildDir;
+    if (!ConfigureCache::parseConfigureCommand(args, job.workingDir, buildDir)) return false;
+
+    QString fingerprint = m_configureCache.fingerprint(args, job.workingDir);
+    if (m_configureCache.isUpToDate(buildDir, fingerprint))
+    {
+        postLog(formatRealTimeLog(QString("⏭️ Configure skipped (arguments and toolchain unchanged): %1").arg(buildDir), node.chain), false);
+        return true;
     }
-    return result;
+
+    job.configureFingerprints.insert(nodeIdx, fingerprint);
+    return false;
 }
 
 /**
- * @brief Start next command in the async list (sequential execution core)
- * @note Only called after current command finishes execution (success/failure)
- * @note Guarantees strict execution order (command N+1 starts only after command N finishes)
+ * @brief Record or invalidate configure fingerprints after a command finished
+ * @param job Job owning the node
+ * @param nodeIdx Index of the finished node
+ * @param success True = command succeeded
  */
-void CommandExecutor::startNextAsyncCommand()
+void CommandExecutor::updateConfigureCache(BuildJob& job, int nodeIdx, bool success)
 {
-    // Clear output buffers for next command
-    m_currentCmdStdout.clear();
-    m_currentCmdStderr.clear();
+    const QString& command = job.nodes[nodeIdx].command;
+    if (!command.trimmed().startsWith("cmake", Qt::CaseInsensitive)) return;
 
-    // All commands executed successfully
-    if (m_currentAsyncCmdIdx >= m_asyncCmds.size())
+    QStringList args = CommandLine::split(command, m_baseEnvironment);
+    args.removeFirst();
+    QString buildDir;
+    if (ConfigureCache::parseConfigureCommand(args, job.workingDir, buildDir))
     {
-        if(executeCopyCmds(m_pendingCopyTasks))
+        if (success && job.configureFingerprints.contains(nodeIdx))
         {
-            emit logUpdated(formatRealTimeLog("✅ All commands executed successfully!"), false);
+            m_configureCache.store(buildDir, job.configureFingerprints.value(nodeIdx));
         }
+        else if (!success)
+        {
+            m_configureCache.invalidate(buildDir);
+        }
+        return;
+    }
+
+    // cmake --build may regenerate the cache (CMakeLists.txt changed) without changing the configuration
+    if (success && parseBuildCommand(command, buildDir))
+    {
+        QString absBuildDir = QDir::cleanPath(QDir::isAbsolutePath(buildDir) ? buildDir : QDir(job.workingDir).filePath(buildDir));
+        m_configureCache.refreshStamp(absBuildDir);
+    }
+}
 
-        m_isExecuting = false;
-        emit commandFinished(true, "", "");
+/**
+ * @brief Return the jobserver tokens held by a slot
+ */
+void CommandExecutor::releaseSlotTokens(ProcessSlot& slot)
+{
+    for (char token : qAsConst(slot.heldTokens))
+    {
+        m_jobServer.release(token);
+    }
+    slot.heldTokens.clear();
+}
 
+/**
+ * @brief Finish a job once no node is running and no further node can start
+ */
+void CommandExecutor::finishJob(BuildJob& job)
+{
+    if (job.hasFailure)
+    {
+        setJobStatus(job, JobFailed);
+        postLog(formatRealTimeLog(QString("❌ Job failed: %1").arg(job.name)), true);
+        flushLog();
+        emit jobFinished(job.id, job.name, false, job.failedStdout, job.failedStderr);
         return;
     }
 
-    // Get current command (by index - preserves execution order)
-    QString currentCmd = m_asyncCmds[m_currentAsyncCmdIdx].trimmed();
-    // Skip empty commands
-    if (currentCmd.isEmpty())
+    m_isRemote = job.isRemote;
+    m_copyRemoteHost = job.remoteHost;
+    m_copyRemotePath = job.remotePath;
+    if(executeCopyCmds(job.copyTasks))
+    {
+        postLog(formatRealTimeLog(QString("✅ All commands of job %1 executed successfully!").arg(job.name)), false);
+    }
+    else
     {
-        m_currentAsyncCmdIdx++;
-        startNextAsyncCommand();
+        // Built but not deployed: the job did not reach its goal
+        job.hasFailure = true;
+        job.failedStderr = "Deployment failed (see copy errors in the log)";
+        setJobStatus(job, JobFailed);
+        postLog(formatRealTimeLog(QString("❌ Job failed: %1").arg(job.name)), true);
+        flushLog();
+        emit jobFinished(job.id, job.name, false, "", job.failedStderr);
         return;
     }
 
-    // Emit progress signal (for UI display)
-    emit commandProgress(m_currentAsyncCmdIdx + 1, m_asyncCmds.size(), currentCmd);
-    emit logUpdated(formatRealTimeLog(QString("📝 Executing command (%1/%2): %3").arg(m_currentAsyncCmdIdx + 1).arg(m_asyncCmds.size()).arg(currentCmd)), false);
+    setJobStatus(job, JobSucceeded);
+    flushLog();
+    emit jobFinished(job.id, job.name, true, "", "");
+}
 
-    // Prepare command execution (platform-specific handling)
-    bool isCmakeCmd = currentCmd.startsWith("cmake", Qt::CaseInsensitive);
-    if (isCmakeCmd)
+/**
+ * @brief Finish execution once the job queue drains
+ * @note Build timing reports still being collected are awaited, then the compiler cache is sampled
+ *       asynchronously; commandFinished follows once its counters arrive
+ */
+void CommandExecutor::finishExecution()
+{
+    // Headless runs exit on commandFinished: the breakdowns of the last builds come first
+    if (m_pendingTimingReports > 0)
     {
-        QStringList cmakeArgs = parseCmakeArguments(currentCmd);
-        QString cmakeProgram = cmakeArgs.takeFirst();
-        // Use cmake.exe explicitly on Windows (ensure executable resolution)
-        if (QOperatingSystemVersion::currentType() == QOperatingSystemVersion::Windows)
-        {
-            cmakeProgram = "cmake.exe";
-        }
-        m_process->setProgram(cmakeProgram);
-        m_process->setArguments(cmakeArgs);
+        m_isWaitingForTimingReports = true;
+        return;
     }
-    // Windows non-CMake commands (via cmd.exe)
-    else if (QOperatingSystemVersion::currentType() == QOperatingSystemVersion::Windows)
+
+    // Cache effectiveness of this batch (counter delta since the first job was queued)
+    if (m_compilerCacheBefore.isValid)
     {
-        m_process->setProgram("cmd.exe");
-        m_process->setArguments(QStringList() << "/c" << currentCmd);
+        if (m_isSamplingCompilerCache) return;
+        m_isSamplingCompilerCache = true;
+        int query = ++m_compilerCacheQuery;
+        CompilerCache::query(m_compilerLauncher, m_baseEnvironment, this, [this, query](const CompilerCache::Stats& after) {
+            if (query != m_compilerCacheQuery) return;
+            m_isSamplingCompilerCache = false;
+            m_compilerCacheSummary = CompilerCache::summary(m_compilerCacheBefore, after, m_batchTimer.elapsed());
+            completeExecution();
+        });
+        return;
     }
-    // Linux/macOS non-CMake commands (via bash)
-    else
+    completeExecution();
+}
+
+/**
+ * @brief Report the drained batch and emit commandFinished
+ */
+void CommandExecutor::completeExecution()
+{
+    m_isExecuting = false;
+
+    bool allSuccess = true;
+    QStringList failedStdout;
+    QStringList failedStderr;
+    for (const BuildJob& job : qAsConst(m_jobs))
     {
-        m_process->setProgram("bash");
-        m_process->setArguments(QStringList() << "-c" << currentCmd);
+        if (job.status == JobSucceeded) continue;
+        allSuccess = false;
+        if (!job.failedStdout.isEmpty()) failedStdout << QString("[%1]\n%2").arg(job.name, job.failedStdout);
+        if (!job.failedStderr.isEmpty()) failedStderr << QString("[%1]\n%2").arg(job.name, job.failedStderr);
     }
 
-    // Set working directory if valid
-    if (!m_asyncWorkingDir.isEmpty() && QDir(m_asyncWorkingDir).exists())
+    if (allSuccess)
     {
-        m_process->setWorkingDirectory(m_asyncWorkingDir);
+        postLog(formatRealTimeLog("✅ All commands executed successfully!"), false);
     }
 
-    // Start process (non-blocking - returns immediately)
-    m_process->start();
+    if (!m_compilerCacheSummary.isEmpty())
+    {
+        QString logLine = formatRealTimeLog("🗃️ " + m_compilerCacheSummary);
+        postLog(logLine, false);
+        saveLog(logLine);
+    }
+    if (m_diagnostics->rowCount() > 0)
+    {
+        QString logLine = formatRealTimeLog("🩺 " + m_diagnostics->summary());
+        postLog(logLine, m_diagnostics->errorCount() > 0);
+        saveLog(logLine);
+    }
+    if (m_batchUsage.commands > 0)
+    {
+        QString logLine = formatRealTimeLog(QString("📊 Resources of %1 command(s): %2").arg(m_batchUsage.commands).arg(m_batchUsage.summary()));
+        postLog(logLine, false);
+        saveLog(logLine);
+    }
+    writeTrace();
+    // The batch log is complete on disk shortly after the queue drains
+    m_logWriter->flush();
+    flushLog();
+    emit commandFinished(allSuccess, failedStdout.join("\n"), failedStderr.join("\n"), m_batchUsage);
 }
 
 /**
  * @brief Callback for single command completion (async execution core)
  * @param exitCode Process exit code (0 = success)
  * @param exitStatus Process exit status (NormalExit/CrashExit)
- * @note Guarantees sequential execution: next command starts only after this callback is triggered
+ * @note Dependents of this command become ready only after this callback marks it as succeeded
  */
 void CommandExecutor::onSingleCommandFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
-    QString currentCmd = m_asyncCmds[m_currentAsyncCmdIdx];
+    handleSlotFinished(slotIndexOf(sender()), exitCode, exitStatus);
+}
+
+/**
+ * @brief Callback for process errors (only FailedToStart needs handling, finished() is not emitted then)
+ * @param error Process error type
+ */
+void CommandExecutor::onProcessErrorOccurred(QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart) return;
+
+    int slotIdx = slotIndexOf(sender());
+    if (slotIdx < 0 || m_slots[slotIdx].nodeIdx < 0) return;
+    m_slots[slotIdx].stderrCapture.append(m_slots[slotIdx].process->errorString());
+    m_slots[slotIdx].stderrScanner.feed(m_slots[slotIdx].process->errorString());
+    handleSlotFinished(slotIdx, -1, QProcess::CrashExit);
+}
+
+/**
+ * @brief Evaluate the result of the command running on a slot and continue scheduling
+ * @param slotIdx Slot index of the finished process
+ * @param exitCode Process exit code (0 = success)
+ * @param exitStatus Process exit status (NormalExit/CrashExit)
+ */
+void CommandExecutor::handleSlotFinished(int slotIdx, int exitCode, QProcess::ExitStatus exitStatus)
+{
+    // Ignore processes detached by stopExecution()/cancelJob()
+    if (slotIdx < 0 || m_slots[slotIdx].nodeIdx < 0) return;
+    int jobIdx = jobIndexOf(m_slots[slotIdx].jobId);
+    if (jobIdx < 0) return;
+
+    ProcessSlot& slot = m_slots[slotIdx];
+    BuildJob& job = m_jobs[jobIdx];
+    int nodeIdx = slot.nodeIdx;
+    QString currentCmd = job.nodes[nodeIdx].command;
+    QString chain = job.nodes[nodeIdx].chain;
+    // Only head and tail are in memory; the log receives the complete output
+    OutputCapture stdoutCapture = slot.stdoutCapture;
+    OutputCapture stderrCapture = slot.stderrCapture;
+    QString cmdStdout = stdoutCapture.text();
+    QString cmdStderr = stderrCapture.text();
+    // Output was scanned while it arrived; only the unterminated last lines are left
+    slot.stdoutScanner.finish();
+    slot.stderrScanner.finish();
+    collectDiagnostics(slot, job.name);
+    ErrorScanner stdoutScanner = slot.stdoutScanner;
+    ErrorScanner stderrScanner = slot.stderrScanner;
+    int errorCount = slot.errorCount;
+    ResourceUsage usage = slot.monitor.finish();
+    m_batchUsage.add(usage);
+    m_commandHistory.append(job.name, currentCmd, exitCode, usage);
+    traceCommand(slotIdx, job, nodeIdx, exitStatus == QProcess::NormalExit ? QString("exit %1").arg(exitCode) : "crashed", usage);
+
+    // Release slot before scheduling further commands
+    slot.nodeIdx = -1;
+    slot.jobId = -1;
+    slot.stdoutCapture.reset();
+    slot.stderrCapture.reset();
+    slot.stdoutScanner.reset();
+    slot.stderrScanner.reset();
+    slot.errorCount = 0;
+    releaseSlotTokens(slot);
+    job.runningCount--;
+    m_runningCount--;
 
     // Merge compile errors from stdout to stderr (for unified error detection)
-    QString errorsFromStdout = extractErrorsFromStdout(m_currentCmdStdout);
+    QString errorsFromStdout = stdoutScanner.errorLines().join("\n");
     if (!errorsFromStdout.isEmpty())
     {
-        if (!m_currentCmdStderr.isEmpty()) m_currentCmdStderr += "\n";
-        m_currentCmdStderr += "[Extracted from stdout] " + errorsFromStdout;
+        if (!cmdStderr.isEmpty()) cmdStderr += "\n";
+        cmdStderr += "[Extracted from stdout] " + errorsFromStdout;
     }
 
     // Save detailed execution log (includes timestamp, exit code, output)
-    QString logContent = QString("[%1] Command: %2\nExitCode: %3\nStdout:\n%4\nStderr:\n%5\n---\n")
-                             .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss"))
-                             .arg(currentCmd)
-                             .arg(exitCode)
-                             .arg(m_currentCmdStdout)
-                             .arg(m_currentCmdStderr);
-    saveLog(logContent, !m_currentCmdStderr.isEmpty());
-
-    // Check if CMake command failed (including compile errors)
+    QString extractedErrors = errorsFromStdout.isEmpty() ? QString() : "[Extracted from stdout] " + errorsFromStdout;
+    saveCommandLog(job.name, currentCmd, QString::number(exitCode), stdoutCapture, stderrCapture,
+                   extractedErrors, usage, !cmdStderr.isEmpty());
+
+    // Check if CMake command failed (including compile errors reported with exit code 0)
     bool isCmakeCmd = currentCmd.startsWith("cmake", Qt::CaseInsensitive);
-    bool CmakeFailed = isCmakeCmd && isCmakeReallyFailed(m_currentCmdStderr);
+    bool CmakeFailed = isCmakeCmd && errorCount > 0;
+    bool processFailed = exitCode != 0 || exitStatus != QProcess::NormalExit;
 
-    // CMake failure: terminate execution immediately
-    if (CmakeFailed)
+    updateConfigureCache(job, nodeIdx, !CmakeFailed && !processFailed);
+
+    QString buildDir;
+    if (m_buildTimingsEnabled && parseBuildCommand(currentCmd, buildDir))
     {
-        m_isExecuting = false;
-        QString errorMsg = QString("❌ CMake failed: %1").arg(m_currentCmdStderr);
-        emit logUpdated(formatRealTimeLog(errorMsg), true);
-        emit cmakeFailed(m_currentCmdStderr, currentCmd);
-        emit commandFinished(false, m_currentCmdStdout, m_currentCmdStderr);
-        return;
+        reportBuildTimings(job, nodeIdx, buildDir, stdoutCapture, usage.wallMs, !processFailed);
     }
 
-    // Non-CMake command failure: terminate execution
-    if (exitCode != 0 || exitStatus != QProcess::NormalExit)
+    if (CmakeFailed || processFailed)
     {
-        m_isExecuting = false;
-        QString errorMsg = QString("❌ Command failed: %1\nError: %2").arg(currentCmd, m_currentCmdStderr);
-        emit logUpdated(formatRealTimeLog(errorMsg), true);
-        emit commandFinished(false, m_currentCmdStdout, m_currentCmdStderr);
+        job.nodeStates[nodeIdx] = NodeFailed;
+        // Report the first failure only (parallel siblings may fail as a consequence)
+        if (!job.hasFailure)
+        {
+            job.hasFailure = true;
+            job.failedStdout = cmdStdout;
+            job.failedStderr = cmdStderr;
+        }
+
+        if (CmakeFailed)
+        {
+            QString errorMsg = QString("❌ CMake failed: %1").arg(cmdStderr);
+            postLog(formatRealTimeLog(errorMsg, chain), true);
+            flushLog();
+            emit cmakeFailed(cmdStderr, currentCmd);
+        }
+        else
+        {
+            QString errorMsg = QString("❌ Command failed: %1\nResources: %2\nError: %3").arg(currentCmd, usage.summary(), cmdStderr);
+            postLog(formatRealTimeLog(errorMsg, chain), true);
+        }
+
+        // No new commands of this job are started; it finishes once running siblings drain
+        scheduleReadyCommands();
         return;
     }
 
-    // Command succeeded: move to next command (preserve execution order)
-    emit logUpdated(formatRealTimeLog(QString("✅ Command (%1/%2) executed successfully").arg(m_currentAsyncCmdIdx + 1).arg(m_asyncCmds.size())), false);
-    m_currentAsyncCmdIdx++; // Increment index (point to next command)
-    startNextAsyncCommand(); // Start next command (only after current finishes)
+    // Command succeeded: unlock dependents
+    job.nodeStates[nodeIdx] = NodeSucceeded;
+    storeNodeArtifacts(job, nodeIdx);
+    postLog(formatRealTimeLog(QString("✅ Command executed successfully: %1 (%2)").arg(currentCmd, usage.summary()), chain), false);
+    notifyChainIfDone(job, chain);
+    scheduleReadyCommands();
 }
 
 /**
- * @brief Public entry point for asynchronous command execution (non-blocking)
+ * @brief Public entry point for asynchronous sequential command execution (non-blocking)
  * @param commands List of commands to execute (in strict execution order)
  * @param Path List of files to copy (in strict execution order)
  * @param Path List of files to delete (in strict execution order)
  * @param workingDir Working directory for command execution
- * @note Ensures commands run sequentially (next starts only after previous finishes)
+ * @note Commands are chained in a linear graph (next starts only after previous finishes)
  * @note UI remains fully responsive during execution
  */
 void CommandExecutor::executeMultiCommandsAsync(const QStringList& commands, QList<QPair<QString, QString>> pendingCopyTasks, QList<QString> pendingDelTasks, const QString& workingDir, bool isRemote)
 {
-    m_isRemote = isRemote;
-    m_pendingCopyTasks = pendingCopyTasks;
+    QList<CommandNode> nodes;
+    for (int i = 0; i < commands.size(); ++i)
+    {
+        CommandNode node;
+        node.id = QString("cmd%1").arg(i);
+        node.command = commands[i];
+        if (i > 0)
+        {
+            node.dependsOn << QString("cmd%1").arg(i - 1);
+        }
+        nodes.append(node);
+    }
+
+    executeCommandGraphAsync(nodes, pendingCopyTasks, pendingDelTasks, workingDir, isRemote);
+}
+
+/**
+ * @brief Public entry point for asynchronous graph execution (non-blocking)
+ * @param nodes Graph nodes (configure -> build edges inside each chain)
+ * @param pendingCopyTasks Files to copy after all nodes succeed
+ * @param pendingDelTasks Directories to delete before execution starts
+ * @param workingDir Working directory for command execution
+ * @param isRemote True = copy tasks are sent to the remote receiver
+ * @note Replaces any ongoing execution; independent chains run concurrently on the process pool
+ */
+void CommandExecutor::executeCommandGraphAsync(const QList<CommandNode>& nodes, QList<QPair<QString, QString>> pendingCopyTasks, QList<QString> pendingDelTasks, const QString& workingDir, bool isRemote)
+{
     // Stop ongoing execution if already running
     if (m_isExecuting)
     {
         stopExecution();
     }
 
-    // Validate command list
-    if (commands.isEmpty())
+    enqueueJob("default", nodes, pendingCopyTasks, pendingDelTasks, workingDir, isRemote);
+}
+
+/**
+ * @brief Add a named job to the queue (non-blocking)
+ * @param name Job name
+ * @param nodes Graph nodes of the job
+ * @param pendingCopyTasks Files to copy after the job succeeds
+ * @param pendingDelTasks Directories to delete right before the job starts
+ * @param workingDir Working directory for the commands of this job
+ * @param isRemote True = copy tasks are sent to the remote receiver
+ * @return Job id (-1 if the job was rejected)
+ * @note Jobs already queued or running are not affected
+ */
+int CommandExecutor::enqueueJob(const QString& name, const QList<CommandNode>& nodes, QList<QPair<QString, QString>> pendingCopyTasks, QList<QString> pendingDelTasks, const QString& workingDir, bool isRemote)
+{
+    // Validate command list (a job without commands may still deploy up-to-date files)
+    if (nodes.isEmpty() && pendingCopyTasks.isEmpty())
+    {
+        postLog(formatRealTimeLog(QString("❌ Command list of job %1 is empty!").arg(name)), true);
+        flushLog();
+        if (!m_isExecuting) emit commandFinished(false, "", "Command list is empty", ResourceUsage());
+        return -1;
+    }
+
+    QString graphError;
+    if (!validateGraph(nodes, graphError))
     {
-        emit logUpdated(formatRealTimeLog("❌ Command list is empty!"), true);
-        emit commandFinished(false, "", "Command list is empty");
-        return;
+        postLog(formatRealTimeLog(QString("❌ Job %1: %2").arg(name, graphError)), true);
+        flushLog();
+        if (!m_isExecuting) emit commandFinished(false, "", graphError, ResourceUsage());
+        return -1;
+    }
+
+    // New batch: forget jobs finished by the previous batch
+    if (!m_isExecuting)
+    {
+        m_jobs.clear();
+        m_batchTimer.start();
+        m_compilerCacheSummary.clear();
+        m_diagnostics->clear();
+        m_batchUsage = ResourceUsage();
+        if (m_traceEnabled) m_trace.start();
+        else m_trace.stop();
+        m_traceCpuMs = 0;
+        m_traceSampleUs = 0;
+        // Sampled in the background; a batch that drains before the counters arrive is not summarised
+        m_compilerCacheBefore = CompilerCache::Stats();
+        int query = ++m_compilerCacheQuery;
+        CompilerCache::query(m_compilerLauncher, m_baseEnvironment, this, [this, query](const CompilerCache::Stats& before) {
+            if (query == m_compilerCacheQuery) m_compilerCacheBefore = before;
+        });
+        // Refill the token pool lost to killed builds
+        if (m_jobServerNeedsReset)
+        {
+            setCpuBudget(m_cpuBudget);
+            m_jobServerNeedsReset = false;
+        }
     }
 
-    if (!pendingDelTasks.empty())
+    BuildJob job;
+    job.id = m_nextJobId++;
+    job.name = name;
+    job.nodes = nodes;
+    job.nodeStates = QVector<NodeState>(nodes.size(), NodePending);
+    job.copyTasks = pendingCopyTasks;
+    job.delTasks = pendingDelTasks;
+    job.workingDir = workingDir;
+    job.isRemote = isRemote;
+    job.remoteHost = m_remoteHost;
+    job.remotePath = m_remotePath;
+    job.failFast = m_failFastEnabled;
+    job.buildDirs = collectBuildDirs(job);
+    job.traceQueuedUs = m_trace.now();
+    m_trace.nameTrack(BuildTrace::jobTrack(job.id), "Job " + name, 1000 + job.id);
+    m_jobs.append(job);
+
+    emit jobStatusChanged(job.id, job.name, JobQueued);
+    postLog(formatRealTimeLog(QString("📥 Job queued: %1 (%2 commands)").arg(name).arg(nodes.size())), false);
+
+    // Queued while the drained batch was being sampled: the job joins it, which is sampled again once it drains
+    if (m_isSamplingCompilerCache)
     {
-        executeDelCmds(pendingDelTasks);
+        m_compilerCacheQuery++;
+        m_isSamplingCompilerCache = false;
     }
+    m_isWaitingForTimingReports = false;
 
-    // Initialize async execution state
-    m_asyncCmds = commands;          // Preserve input order
-    m_asyncWorkingDir = workingDir;
-    m_currentAsyncCmdIdx = 0;        // Start with first command (index 0)
     m_isExecuting = true;
+    // Start the job right away if a job slot is free (non-blocking - returns immediately)
+    scheduleReadyCommands();
+    return job.id;
+}
+
+/**
+ * @brief Cancel a queued or running job
+ * @param jobId Id returned by enqueueJob
+ */
+void CommandExecutor::cancelJob(int jobId)
+{
+    int jobIdx = jobIndexOf(jobId);
+    if (jobIdx < 0) return;
+
+    BuildJob& job = m_jobs[jobIdx];
+    if (job.status != JobQueued && job.status != JobRunning) return;
+
+    killJobCommands(job);
+    setJobStatus(job, JobCancelled);
+    postLog(formatRealTimeLog(QString("Job cancelled: %1").arg(job.name)), true);
+    flushLog();
+    emit jobFinished(job.id, job.name, false, "", "Job cancelled");
+
+    scheduleReadyCommands();
+}
+
+/**
+ * @brief Get current status of a job
+ * @param jobId Id returned by enqueueJob
+ * @return Job status (JobCancelled for unknown ids)
+ */
+CommandExecutor::JobStatus CommandExecutor::jobStatus(int jobId) const
+{
+    int jobIdx = jobIndexOf(jobId);
+    return jobIdx < 0 ? JobCancelled : m_jobs[jobIdx].status;
+}
 
-    emit logUpdated(formatRealTimeLog("🚀 Start executing async commands..."), false);
-    // Start first command (non-blocking - returns immediately)
-    startNextAsyncCommand();
+/**
+ * @brief Wall time of a finished job
+ */
+qint64 CommandExecutor::jobDurationMs(int jobId) const
+{
+    int jobIdx = jobIndexOf(jobId);
+    return jobIdx < 0 ? 0 : m_jobs[jobIdx].durationMs;
 }
 
 bool CommandExecutor::executeCopyCmds(QList<QPair<QString, QString>> pendingCopyTasks)
 {
+    bool allCopied = true;
     for (const auto& task : qAsConst(pendingCopyTasks))
     {
         QString srcFile = task.first;
@@ -432,28 +1849,34 @@ bool CommandExecutor::executeCopyCmds(QList<QPair<QString, QString>> pendingCopy
         QString errorMsg;
 
         QString startLog = QString("📤 Copying file: %1 -> %2").arg(srcFile).arg(targetDir);
-        emit logUpdated(formatRealTimeLog(startLog), false);
+        postLog(formatRealTimeLog(startLog), false);
         saveLog(startLog, false);
         qDebug() << startLog;
 
-        if (!copyFileWithQt(srcFile, targetDir, errorMsg))
+        qint64 traceStartUs = m_trace.now();
+        bool isCopied = copyFileWithQt(srcFile, targetDir, errorMsg);
+        QString category = m_isRemote ? "remote transfer" : "copy";
+        m_trace.addSpan(BuildTrace::EXECUTOR_TRACK, category + " " + QFileInfo(srcFile).fileName(), category, traceStartUs, m_trace.now(),
+                        QJsonObject{ { "source", srcFile }, { "target", targetDir }, { "bytes", QFileInfo(srcFile).size() }, { "success", isCopied } });
+        if (!isCopied)
         {
             QString failLog = QString("❌ Copy failed: %1 (Reason: %2)").arg(srcFile).arg(errorMsg);
-            emit logUpdated(formatRealTimeLog(failLog), true);
+            postLog(formatRealTimeLog(failLog), true);
             saveLog(failLog, true);
             qDebug() << failLog;
+            allCopied = false;
             // Optional
             // break;
         }
         else
         {
             QString successLog = QString("✅ Copy success: %1 -> %2").arg(srcFile).arg(targetDir);
-            emit logUpdated(formatRealTimeLog(successLog), false);
+            postLog(formatRealTimeLog(successLog), false);
             saveLog(successLog, false);
             qDebug() << successLog;
         }
     }
-    return true;
+    return allCopied;
 }
 
 bool CommandExecutor::copyFileWithQt(const QString& srcFile, const QString& targetDir, QString& errorMsg)
@@ -480,17 +1903,17 @@ bool CommandExecutor::copyFileWithQt(const QString& srcFile, const QString& targ
 
     if (m_isRemote)
     {
-        RemoteConfigDialog dlg;
-        if (dlg.sendFileToRemote(m_remoteHost, 9999, srcFile, m_remotePath + "\\" + filename))
+        QString sendError;
+        if (RemoteFileSender::sendFile(m_copyRemoteHost, 9999, srcFile, m_copyRemotePath + "\\" + filename, sendError))
         {
             return true;
         }
         else
         {
-            errorMsg = QString("Qt copy failed: %1 (Source: %2, Target: %3)")
-            .arg(src.errorString())
+            errorMsg = QString("Remote transfer failed: %1 (Source: %2, Target: %3)")
+            .arg(sendError)
                 .arg(srcFile)
-                .arg(m_remotePath);
+                .arg(m_copyRemotePath);
             return false;
         }
     }
@@ -520,14 +1943,18 @@ bool CommandExecutor::executeDelCmds(QList<QString> pendingDelTasks)
     {
         QString errorMsg;
         QString startLog = QString("🗑️ Deleting directory: %1").arg(targetDir);
-        emit logUpdated(formatRealTimeLog(startLog), false);
+        postLog(formatRealTimeLog(startLog), false);
         saveLog(startLog, false);
         qDebug() << startLog;
 
-        if (!deleteFileWithQt(targetDir, errorMsg))
+        qint64 traceStartUs = m_trace.now();
+        bool isDeleted = deleteFileWithQt(targetDir, errorMsg);
+        m_trace.addSpan(BuildTrace::EXECUTOR_TRACK, "delete " + QDir(targetDir).dirName(), "delete", traceStartUs, m_trace.now(),
+                        QJsonObject{ { "path", targetDir }, { "success", isDeleted } });
+        if (!isDeleted)
         {
             QString failLog = QString("❌ Delete failed: %1 (Reason: %2)").arg(targetDir).arg(errorMsg);
-            emit logUpdated(formatRealTimeLog(failLog), true);
+            postLog(formatRealTimeLog(failLog), true);
             saveLog(failLog, true);
             qDebug() << failLog;
             allSuccess = false; // Mark overall status as failed
@@ -536,7 +1963,7 @@ bool CommandExecutor::executeDelCmds(QList<QString> pendingDelTasks)
         else
         {
             QString successLog = QString("✅ Delete success: %1").arg(targetDir);
-            emit logUpdated(formatRealTimeLog(successLog), false);
+            postLog(formatRealTimeLog(successLog), false);
             saveLog(successLog, false);
             qDebug() << successLog;
         }
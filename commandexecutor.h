@@ -9,16 +9,58 @@
 #include <QFile>
 #include <QDateTime>
 #include <QRegularExpression>
+#include <QVector>
+#include <QHash>
+#include <QProcessEnvironment>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include "jobserver.h"
+#include "configurecache.h"
+#include "artifactcache.h"
+#include "compilercache.h"
+#include "errorscanner.h"
+#include "outputcapture.h"
+#include "diagnostics.h"
+#include "logwriter.h"
+#include "resourceusage.h"
+#include "buildtrace.h"
+#include "buildtimings.h"
 
 /**
- * @brief Asynchronous command executor with real-time log output and strict execution order
- * @note Guarantees sequential execution (next command starts only after previous one finishes)
+ * @brief Single node of a command dependency graph
+ * @note A node starts only after every node listed in dependsOn has finished successfully
+ */
+struct CommandNode
+{
+    QString     id;         // Unique node id inside one graph (referenced by dependsOn)
+    QString     command;    // Command line to execute
+    QStringList dependsOn;  // Ids of nodes that must succeed before this node starts
+    QString     chain;      // Chain label used as log prefix (e.g. build directory name)
+    QString     cacheKey;   // Artifact cache key (empty = outputs of this node are not cached)
+    QStringList artifacts;  // Absolute paths of files produced by this node
+};
+
+/**
+ * @brief Asynchronous command executor with real-time log output and dependency-ordered execution
+ * @note Named jobs are queued and run side by side (up to maxConcurrentJobs)
+ * @note Commands of a job form a dependency graph; independent chains run concurrently on a pool of process slots
  * @note Non-blocking execution (UI remains responsive during command execution)
  */
 class CommandExecutor : public QObject
 {
     Q_OBJECT
 public:
+    enum JobStatus
+    {
+        JobQueued,
+        JobRunning,
+        JobSucceeded,
+        JobFailed,
+        JobCancelled,
+    };
+    Q_ENUM(JobStatus)
+
     /**
      * @brief Constructor
      * @param parent Parent QObject pointer
@@ -34,11 +76,158 @@ public:
      */
     void executeMultiCommandsAsync(const QStringList& commands, QList<QPair<QString, QString>> pendingCopyTasks, QList<QString> pendingDelTasks, const QString& workingDir = "", bool isRemote = false);
 
+    /**
+     * @brief Execute a command dependency graph asynchronously (non-blocking)
+     * @param nodes Graph nodes (dependencies reference other node ids)
+     * @param pendingCopyTasks Files to copy after all nodes succeed
+     * @param pendingDelTasks Directories to delete before the first node starts
+     * @param workingDir Working directory for command execution (empty = current directory)
+     * @param isRemote True = copy tasks are sent to the remote receiver
+     * @note Stops any ongoing execution first; use enqueueJob to run several graphs side by side
+     */
+    void executeCommandGraphAsync(const QList<CommandNode>& nodes, QList<QPair<QString, QString>> pendingCopyTasks, QList<QString> pendingDelTasks, const QString& workingDir = "", bool isRemote = false);
+
+    /**
+     * @brief Add a named job to the queue (non-blocking)
+     * @param name Job name (reported by jobStatusChanged/jobFinished)
+     * @param nodes Graph nodes of the job
+     * @param pendingCopyTasks Files to copy after all nodes of the job succeed
+     * @param pendingDelTasks Directories to delete right before the job starts
+     * @param workingDir Working directory for the commands of this job
+     * @param isRemote True = copy tasks are sent to the remote receiver
+     * @return Job id (-1 if the job was rejected)
+     * @note Jobs start in queue order as soon as a job slot is free
+     */
+    int enqueueJob(const QString& name, const QList<CommandNode>& nodes, QList<QPair<QString, QString>> pendingCopyTasks, QList<QString> pendingDelTasks, const QString& workingDir = "", bool isRemote = false);
+
+    /**
+     * @brief Cancel a queued or running job (running commands of the job are killed)
+     * @param jobId Id returned by enqueueJob
+     */
+    void cancelJob(int jobId);
+
+    /**
+     * @brief Get current status of a job
+     * @param jobId Id returned by enqueueJob
+     * @return Job status (JobCancelled for unknown ids)
+     */
+    JobStatus jobStatus(int jobId) const;
+
+    /**
+     * @brief Wall time of a finished job (start of its first command to its end, including deployment)
+     * @param jobId Id returned by enqueueJob
+     * @return Duration in milliseconds (0 = unknown job or never started)
+     */
+    qint64 jobDurationMs(int jobId) const;
+
+    /**
+     * @brief Set maximum number of commands running at the same time (across all jobs)
+     * @param count Number of process slots (minimum 1)
+     */
+    void setMaxParallelCommands(int count) { m_maxParallelCommands = qMax(1, count); }
+
+    /**
+     * @brief Set maximum number of jobs running at the same time
+     * @param count Number of job slots (minimum 1)
+     */
+    void setMaxConcurrentJobs(int count) { m_maxConcurrentJobs = qMax(1, count); }
+    int maxConcurrentJobs() const { return m_maxConcurrentJobs; }
+
+    /**
+     * @brief Set total core budget shared by all parallel cmake --build invocations
+     * @param cores Number of jobserver tokens (minimum 1, default = ideal thread count)
+     * @note Must not be changed while builds are running (tokens held by children would be lost)
+     */
+    void setCpuBudget(int cores);
+    int cpuBudget() const { return m_cpuBudget; }
+
+    /**
+     * @brief Enable/disable skipping of configure steps whose fingerprint is unchanged
+     * @param enabled True = skip redundant configures (default)
+     */
+    void setConfigureCacheEnabled(bool enabled) { m_configureCacheEnabled = enabled; }
+
+    /**
+     * @brief Enable/disable restoring and storing of cached build artifacts
+     * @param enabled True = chains whose artifacts are cached skip configure and build (default)
+     */
+    void setArtifactCacheEnabled(bool enabled) { m_artifactCacheEnabled = enabled; }
+
+    /**
+     * @brief Set the disk budget of the artifact cache (least recently used entries are evicted)
+     * @param budgetBytes Total size of cached artifacts (0 = unlimited)
+     */
+    void setArtifactCacheBudget(qint64 budgetBytes) { m_artifactCache.setBudget(budgetBytes); }
+
+    /**
+     * @brief Enable/disable aborting a job at the first fatal diagnostic in its output
+     * @param enabled True = the first compiler, linker or CMake error parsed from the live output
+     *                kills the command's process tree and its parallel siblings
+     * @note Off by default: the job then fails only after the failing command has exited
+     * @note Applies to jobs queued afterwards (each job keeps the setting it was queued with)
+     */
+    void setFailFastEnabled(bool enabled) { m_failFastEnabled = enabled; }
+
+    /**
+     * @brief Enable/disable the trace file written for every batch
+     * @param enabled True = <log folder>/eazybuild_trace_<time>.json (Chrome trace-event format) is written
+     *                when the batch ends (default); open it in chrome://tracing or ui.perfetto.dev
+     * @note One track per process slot and per job, one for delete/copy/transfer/cache steps, plus CPU and memory counters
+     */
+    void setTraceEnabled(bool enabled) { m_traceEnabled = enabled; }
+
+    /**
+     * @brief Enable/disable the build time breakdown logged after every "cmake --build"
+     * @param enabled True = the slowest targets and translation units of the build dir are ranked from .ninja_log,
+     *                MSBuild's performance summary or -ftime-trace files and compared with the previous run (default)
+     * @note Visual Studio builds get /clp:PerformanceSummary appended while enabled
+     */
+    void setBuildTimingsEnabled(bool enabled) { m_buildTimingsEnabled = enabled; }
+
+    /**
+     * @brief Trace file of the last finished batch (empty = none written)
+     */
+    QString lastTracePath() const { return m_lastTracePath; }
+
+    /**
+     * @brief Set the compiler cache whose counters are sampled around every batch
+     * @param launcher "ccache", "sccache" or a path to either (empty = no statistics)
+     * @note The launcher itself is injected into the configure commands by the planner
+     */
+    void setCompilerLauncher(const QString& launcher) { m_compilerLauncher = launcher; }
+
+    /**
+     * @brief Compiler cache summary of the last finished batch (hits, misses, hit rate, time saved)
+     * @return Empty when no launcher was set or its statistics were unavailable
+     */
+    QString compilerCacheSummary() const { return m_compilerCacheSummary; }
+
+    /**
+     * @brief Compiler/linker diagnostics of the current (or last) batch
+     * @return Table model filled while commands run (deduplicated across jobs, cleared when a new batch starts)
+     */
+    DiagnosticTable* diagnostics() const { return m_diagnostics; }
+
+    bool isExecuting() const { return m_isExecuting; }
+
     /**
      * @brief Set log file path for persistent log storage
      * @param path Full path to log file
      */
-    void setLogFilePath(const QString& path) { m_logFilePath = path; }
+    void setLogFilePath(const QString& path);
+
+    /**
+     * @brief Set log rotation and retention
+     * @param segmentBytes Size at which the log file is rotated and gzip-compressed (0 = never rotate)
+     * @param budgetBytes Disk space kept for this log's files, oldest deleted first (0 = unlimited)
+     * @note The current file always keeps logFilePath(); rotated segments are <name>.NNN.log.gz next to it
+     */
+    void setLogRotation(qint64 segmentBytes, qint64 budgetBytes);
+
+    /**
+     * @brief Block until every queued log entry reached the log file (e.g. before opening it)
+     */
+    void flushLogFile();
 
     /**
      * @brief Set maximum number of log lines (prevent UI lag/memory overflow)
@@ -47,13 +236,18 @@ public:
     void setMaxLogLines(int maxLines) { m_maxLogLines = maxLines; }
 
 
+    /**
+     * @brief Set the remote receiver of remote deployments (jobs queued afterwards keep it)
+     */
     void setRemoteHost(const QString& host) { m_remoteHost = host; }
 
-
+    /**
+     * @brief Set the remote target directory of remote deployments (jobs queued afterwards keep it)
+     */
     void setRemotePath(const QString& path) { m_remotePath = path; }
 
     /**
-     * @brief Stop current command execution immediately
+     * @brief Stop all jobs immediately (running commands are killed, queued jobs are cancelled)
      */
     void stopExecution();
 
@@ -61,12 +255,38 @@ public:
     QString logFileFolder() {return m_logFileFolder;};
 signals:
     /**
-     * @brief Emitted when all commands finish execution
-     * @param success True = all commands executed successfully
-     * @param stdoutLog Combined stdout of all commands
-     * @param stderrLog Combined stderr of all commands (including extracted compile errors)
+     * @brief Emitted when the job queue drains (all jobs finished)
+     * @param success True = all jobs executed successfully
+     * @param stdoutLog Combined stdout of the failed commands
+     * @param stderrLog Combined stderr of the failed commands (including extracted compile errors)
+     * @param usage Resources used by all commands of the batch (CPU, peak memory, I/O)
+     */
+    void commandFinished(bool success, const QString& stdoutLog, const QString& stderrLog, const ResourceUsage& usage);
+
+    /**
+     * @brief Emitted when a single job finishes (success, failure or cancellation)
+     * @param jobId Id returned by enqueueJob
+     * @param jobName Job name
+     * @param success True = all commands and copy tasks of the job succeeded
+     * @param stdoutLog Stdout of the failed command
+     * @param stderrLog Stderr of the failed command
      */
-    void commandFinished(bool success, const QString& stdoutLog, const QString& stderrLog);
+    void jobFinished(int jobId, const QString& jobName, bool success, const QString& stdoutLog, const QString& stderrLog);
+
+    /**
+     * @brief Emitted when the status of a job changes
+     * @param jobId Id returned by enqueueJob
+     * @param jobName Job name
+     * @param status New job status
+     */
+    void jobStatusChanged(int jobId, const QString& jobName, CommandExecutor::JobStatus status);
+
+    /**
+     * @brief Emitted when every command of a chain succeeded (or its artifacts were restored from cache)
+     * @param jobId Id returned by enqueueJob
+     * @param chain Chain label of the finished commands
+     */
+    void chainSucceeded(int jobId, const QString& chain);
 
     /**
      * @brief Emitted when CMake command execution fails (including compile errors)
@@ -79,16 +299,18 @@ signals:
      * @brief Emitted in real-time when new log content is available (for UI display)
      * @param logContent New log content (with timestamp)
      * @param isError True = error log (stderr/compile error), False = normal log (stdout)
+     * @note Delivered in frames (about 30 per second): one emission per run of equally colored lines
      */
     void logUpdated(const QString& logContent, bool isError);
 
     /**
      * @brief Emitted when command execution progress changes
-     * @param current Index of currently executing command (1-based)
+     * @param current Number of commands started so far (1-based)
      * @param total Total number of commands
      * @param cmd Currently executing command string
+     * @param usage Resources used by the commands of the batch finished so far
      */
-    void commandProgress(int current, int total, const QString& cmd);
+    void commandProgress(int current, int total, const QString& cmd, const ResourceUsage& usage);
 
 private slots:
     /**
@@ -110,26 +332,313 @@ private slots:
      */
     void onReadyReadStandardError();
 
+    /**
+     * @brief Callback when a process reports an error (handles FailedToStart)
+     * @param error Process error type
+     */
+    void onProcessErrorOccurred(QProcess::ProcessError error);
+
 private:
+    enum NodeState
+    {
+        NodePending,
+        NodeRunning,
+        NodeSucceeded,
+        NodeFailed,
+    };
+
+    /**
+     * @brief One queued/running job (a command graph with its own copy/delete tasks)
+     */
+    struct BuildJob
+    {
+        int                id = -1;
+        QString            name;
+        QList<CommandNode> nodes;
+        QVector<NodeState> nodeStates;
+        QList<QPair<QString, QString>> copyTasks;
+        QList<QString>     delTasks;
+        QString            workingDir;
+        bool               isRemote = false;
+        QString            remoteHost;         // Remote receiver when the job was queued
+        QString            remotePath;         // Remote target directory when the job was queued
+        bool               failFast = false;   // Fail-fast setting when the job was queued
+        JobStatus          status = JobQueued;
+        int                startedCount = 0;   // Number of nodes started
+        int                runningCount = 0;   // Number of nodes currently running
+        bool               hasFailure = false; // True = a node failed, no further nodes are started
+        QString            failedStdout;       // Stdout of the first failed command
+        QString            failedStderr;       // Stderr of the first failed command
+        QHash<int, QString> configureFingerprints; // Node index -> fingerprint recorded on success
+        QStringList        buildDirs;          // Absolute build dirs written by the job (jobs sharing one never run together)
+        QElapsedTimer      timer;              // Started when the job starts running
+        qint64             durationMs = 0;     // Wall time from start to finish
+        qint64             traceQueuedUs = 0;  // Trace time of enqueueing
+        qint64             traceStartUs = 0;   // Trace time of the start
+    };
+
+    /**
+     * @brief One reusable process slot of the execution pool
+     */
+    struct ProcessSlot
+    {
+        QProcess* process = nullptr;  // Process instance owned by the executor
+        int       jobId = -1;         // Id of the job owning the running command
+        int       nodeIdx = -1;       // Index of the node running on this slot (-1 = idle)
+        OutputCapture stdoutCapture;  // Stdout of the running command (bounded head/tail, spooled to disk)
+        OutputCapture stderrCapture;  // Stderr of the running command (bounded head/tail, spooled to disk)
+        ErrorScanner stdoutScanner;   // Error keywords of stdout, scanned while the command runs
+        ErrorScanner stderrScanner;   // Error keywords of stderr, scanned while the command runs
+        int       errorCount = 0;     // Diagnostic::Error records parsed from the running command
+        QByteArray heldTokens;        // Jobserver tokens reserved for the running command
+        ResourceMonitor monitor;      // CPU, memory and I/O of the running command's process tree
+        qint64    traceStartUs = 0;   // Trace time the running command started
+    };
+
+    /**
+     * @brief Start queued jobs while job slots are free, then start every ready node
+     * @note Finishes jobs once nothing of them is running and nothing more can start
+     */
+    void scheduleReadyCommands();
+
+    /**
+     * @brief Start a graph node on the given process slot
+     * @param slotIdx Index of an idle slot
+     * @param job Job owning the node
+     * @param nodeIdx Index of a ready node
+     * @param command Command line to run (node command with injected parallelism flags)
+     * @param tokens Jobserver tokens reserved for the command
+     */
+    void startCommandOnSlot(int slotIdx, BuildJob& job, int nodeIdx, const QString& command, const QByteArray& tokens);
+
+    /**
+     * @brief Reserve jobserver tokens for a node and inject matching parallelism flags
+     * @param job Job owning the node
+     * @param nodeIdx Index of a ready node
+     * @param command Receives the command line to run
+     * @param tokens Receives the reserved tokens
+     * @return False = no token available yet (node must wait)
+     * @note Jobserver-aware generators (Ninja >= 1.13, GNU make) get one token and MAKEFLAGS;
+     *       other generators (MSBuild) get a static share of the budget via --parallel
+     */
+    bool prepareBuildCommand(const BuildJob& job, int nodeIdx, QString& command, QByteArray& tokens);
+
     /**
-     * @brief Start next command in the async command list (sequential execution)
-     * @note Only called after current command finishes execution
+     * @brief Check whether a configure node can be skipped (same fingerprint as last successful configure)
+     * @param job Job owning the node (remembers the fingerprint of non-skipped configures)
+     * @param nodeIdx Index of a ready node
+     * @return True = node is a configure step whose build dir is up to date
      */
-    void startNextAsyncCommand();
+    bool skipUpToDateConfigure(BuildJob& job, int nodeIdx);
 
     /**
-     * @brief Extract compile errors (e.g., error C2146) from stdout to stderr
-     * @param stdoutContent Full stdout content of current command
-     * @return Extracted error messages (empty if no errors)
+     * @brief Update configure fingerprints after a command finished
+     * @param job Job owning the node
+     * @param nodeIdx Index of the finished node
+     * @param success True = command succeeded
      */
-    QString extractErrorsFromStdout(const QString& stdoutContent);
+    void updateConfigureCache(BuildJob& job, int nodeIdx, bool success);
+
+    /**
+     * @brief Return the jobserver tokens held by a slot
+     */
+    void releaseSlotTokens(ProcessSlot& slot);
+
+    /**
+     * @brief Extract build directory from a "cmake --build <dir>" command
+     * @return True = command is a cmake build command
+     */
+    bool parseBuildCommand(const QString& cmd, QString& buildDir) const;
+
+    /**
+     * @brief Resolve the program of a directly spawned command via PATH
+     * @return Absolute executable path (empty = not an executable, the command needs the shell)
+     */
+    QString resolveProgram(const QString& program);
+
+    /**
+     * @brief Check whether the build tool of a configured build dir is a jobserver client
+     * @param buildDir Absolute build directory (reads CMakeCache.txt)
+     */
+    bool isJobserverAwareBuild(const QString& buildDir);
+
+    /**
+     * @brief Get an idle slot (creates a new process slot if all existing ones are busy)
+     * @return Slot index
+     */
+    int acquireFreeSlot();
+
+    /**
+     * @brief Evaluate the command result of a slot and schedule further commands
+     * @param slotIdx Slot index of the finished process
+     * @param exitCode Process exit code (0 = success)
+     * @param exitStatus Process exit status (NormalExit/CrashExit)
+     */
+    void handleSlotFinished(int slotIdx, int exitCode, QProcess::ExitStatus exitStatus);
+
+    /**
+     * @brief Find the slot owning a process
+     * @param process Process instance (usually sender())
+     * @return Slot index or -1 if not found
+     */
+    int slotIndexOf(const QObject* process) const;
+
+    /**
+     * @brief Check whether all dependencies of a pending node have succeeded
+     */
+    bool isNodeReady(const BuildJob& job, int nodeIdx) const;
+
+    /**
+     * @brief Find a job by id
+     * @return Job index in m_jobs or -1 if not found
+     */
+    int jobIndexOf(int jobId) const;
+
+    /**
+     * @brief Start a queued job (runs its delete tasks)
+     */
+    void startJob(BuildJob& job);
+
+    /**
+     * @brief Collect the build directories a job writes (configure -B dirs, --build dirs, deleted dirs)
+     */
+    QStringList collectBuildDirs(const BuildJob& job);
+
+    /**
+     * @brief Check whether a queued job shares a build directory with a running job
+     */
+    bool hasBuildDirConflict(const BuildJob& job) const;
+
+    /**
+     * @brief Restore cached artifacts of a job (chains with a hit are marked as done)
+     */
+    void restoreCachedArtifacts(BuildJob& job);
+
+    /**
+     * @brief Store artifacts of a successfully finished node in the artifact cache
+     */
+    void storeNodeArtifacts(const BuildJob& job, int nodeIdx);
+
+    /**
+     * @brief Emit chainSucceeded if every node of the chain succeeded
+     */
+    void notifyChainIfDone(const BuildJob& job, const QString& chain);
+
+    /**
+     * @brief Fail the job of a slot right away (kills the command and its parallel siblings)
+     * @param slotIdx Slot whose output contained the diagnostic
+     * @param diagnostic Fatal diagnostic line reported as the job error
+     */
+    void abortOnFatalDiagnostic(int slotIdx, const QString& diagnostic);
+
+    /**
+     * @brief Parse the diagnostic candidates scanned on a slot into the diagnostics table
+     * @param slot Slot whose scanners received output
+     * @param jobName Job owning the running command
+     * @return First line parsed as an error (empty = none)
+     */
+    QString collectDiagnostics(ProcessSlot& slot, const QString& jobName);
+
+    /**
+     * @brief Sample the process trees of all running commands (stops itself once nothing runs)
+     * @note Linux reads /proc on the thread pool; the trace counters follow once the samples are back
+     */
+    void sampleResourceUsage();
+
+    /**
+     * @brief Add the CPU, memory and running-command counters of the trace
+     */
+    void traceResourceUsage();
+
+    /**
+     * @brief Add the span of a command that finished or was killed on a slot to the trace
+     */
+    void traceCommand(int slotIdx, const BuildJob& job, int nodeIdx, const QString& result, const ResourceUsage& usage);
+
+    /**
+     * @brief Write the trace of the ending batch on the thread pool (no-op when tracing is off)
+     */
+    void writeTrace();
+
+    /**
+     * @brief Log the build time breakdown of a finished "cmake --build" command
+     * @param buildDir Build directory as written in the command
+     * @param buildOutput Stdout of the build (MSBuild prints its performance summary there)
+     * @param success True = remember the durations for the comparison with the next run
+     * @note Collected on the thread pool; the report reaches the log shortly after the command's result
+     */
+    void reportBuildTimings(const BuildJob& job, int nodeIdx, const QString& buildDir, const OutputCapture& buildOutput,
+                            qint64 wallMs, bool success);
+
+    /**
+     * @brief Kill all running commands of a job (whole process trees) and detach their slots
+     */
+    void killJobCommands(BuildJob& job);
+
+    /**
+     * @brief Update job status and emit jobStatusChanged
+     */
+    void setJobStatus(BuildJob& job, JobStatus status);
+
+    /**
+     * @brief Validate graph (unique ids, known dependencies, no cycles)
+     * @param errorMsg Filled with a description when validation fails
+     * @return True = graph can be executed
+     */
+    bool validateGraph(const QList<CommandNode>& nodes, QString& errorMsg) const;
+
+    /**
+     * @brief Finish a job: run copy tasks on success and emit jobFinished
+     */
+    void finishJob(BuildJob& job);
+
+    /**
+     * @brief Finish execution when the queue drains: await the build timing reports, sample the compiler cache,
+     *        then completeExecution()
+     * @note Both are asynchronous; a job queued meanwhile extends the batch
+     */
+    void finishExecution();
+
+    /**
+     * @brief Log the batch summaries, write the trace and emit commandFinished
+     */
+    void completeExecution();
 
     /**
      * @brief Format real-time log with timestamp
      * @param content Raw log content from process output
+     * @param tag Optional chain label inserted after the timestamp
      * @return Formatted log string with timestamp prefix
      */
-    QString formatRealTimeLog(const QString& content);
+    QString formatRealTimeLog(const QString& content, const QString& tag = "");
+
+    /**
+     * @brief One pending piece of a log frame
+     */
+    struct LogEntry
+    {
+        QString text;
+        QString tag;            // Chain label (raw entries only)
+        bool    isError = false;
+        bool    isRaw = false;  // True = process output, timestamped when the frame is flushed
+    };
+
+    /**
+     * @brief Queue formatted log content for the next log frame
+     */
+    void postLog(const QString& content, bool isError);
+
+    /**
+     * @brief Queue raw process output for the next log frame (joined with the previous chunk of the same stream)
+     */
+    void postOutput(const QString& content, const QString& tag, bool isError);
+
+    void appendLogEntry(const LogEntry& entry);
+
+    /**
+     * @brief Emit the pending log frame (a few logUpdated signals instead of one per read)
+     */
+    void flushLog();
 
     /**
      * @brief Save log content to file (persistent storage)
@@ -139,21 +648,20 @@ private:
     void saveLog(const QString& content, bool isError = false);
 
     /**
-     * @brief Check if CMake command actually failed (including compile errors)
-     * @param cmd Executed CMake command
-     * @param exitCode Process exit code
-     * @param exitStatus Process exit status
-     * @param stderrLog Combined stderr (including extracted errors from stdout)
-     * @return True = CMake command failed
+     * @brief Hand the rotation settings and the budget's file pattern for the current log path to the writer
      */
-    bool isCmakeReallyFailed(const QString& stderrLog);
+    void applyLogRotation();
 
     /**
-     * @brief Parse CMake arguments to preserve space-containing values (e.g., "-G Visual Studio 16 2019")
-     * @param cmd Full CMake command string
-     * @return Properly split argument list (space-containing values as single items)
+     * @brief Save the record of a finished command (output streamed from its captures)
+     * @param stderrSuffix Text appended to stderr (e.g. errors extracted from stdout)
+     * @param usage Resources used by the command's process tree
+     * @param isError True = mark as error log
      */
-    QStringList parseCmakeArguments(const QString& cmd);
+    void saveCommandLog(const QString& jobName, const QString& command, const QString& exitCode,
+                        const OutputCapture& stdoutCapture, const OutputCapture& stderrCapture,
+                        const QString& stderrSuffix, const ResourceUsage& usage, bool isError);
+
 
     bool copyFileWithQt(const QString &srcFile, const QString &targetDir, QString &errorMsg);
 
@@ -165,20 +673,60 @@ private:
 
     bool executeDelCmds(QList<QString> pendingDelTasks);
 
-    QProcess* m_process;          // Single process instance (only one command runs at a time)
+    QList<ProcessSlot> m_slots;   // Process pool (grows up to m_maxParallelCommands busy slots)
+    QList<BuildJob> m_jobs;       // Jobs of the current batch (in queue order)
     QString m_logFilePath;        // Path to persistent log file
+    LogWriter* m_logWriter;       // Writes the log file on its own thread
+    qint64 m_logSegmentBytes;     // Rotation size of the log file (0 = never rotate)
+    qint64 m_logBudgetBytes;      // Disk budget of the log files (0 = unlimited)
     QString m_logFileFolder;
-    QString m_currentCmdStdout;   // Stdout buffer for current command
-    QString m_currentCmdStderr;   // Stderr buffer for current command
-    QString m_asyncWorkingDir;    // Working directory for command execution
-    QStringList m_asyncCmds;      // List of commands to execute (preserves input order)
     QString m_remoteHost;         // Remote host
     QString m_remotePath;         // Remote target path
-    int m_currentAsyncCmdIdx;     // Index of currently executing command (0-based)
+    int m_nextJobId;              // Id assigned to the next enqueued job
+    int m_runningCount;           // Number of commands currently running (all jobs)
+    int m_maxParallelCommands;    // Maximum number of concurrently running commands
+    int m_maxConcurrentJobs;      // Maximum number of concurrently running jobs
     int m_maxLogLines;            // Maximum log lines (prevent UI/memory issues)
-    bool m_isExecuting;           // Execution state flag (prevent concurrent execution)
-    bool m_isRemote;
-    QList<QPair<QString, QString>> m_pendingCopyTasks;
+    int m_cpuBudget;              // Total core budget shared by all child builds
+    bool m_jobServerNeedsReset;   // True = a killed build may have leaked tokens
+    JobServer m_jobServer;        // Token pool handed to child builds via MAKEFLAGS
+    QTimer* m_tokenRetryTimer;    // Retries scheduling while builds wait for tokens
+    QList<LogEntry> m_logFrame;   // Log output not yet delivered
+    int m_logFrameChars;          // Characters in m_logFrame
+    QTimer* m_logFlushTimer;      // Delivers m_logFrame (frame rate limit)
+    QProcessEnvironment m_baseEnvironment;  // Environment passed to child processes
+    QHash<QString, bool> m_jobserverToolCache; // Build tool path -> jobserver support
+    QHash<QString, QString> m_programPathCache; // Program name -> resolved executable (empty = shell builtin)
+    ConfigureCache m_configureCache; // Configure fingerprints per build dir
+    bool m_configureCacheEnabled; // True = skip redundant configure steps
+    ArtifactCache m_artifactCache; // Content-addressed artifact store
+    bool m_artifactCacheEnabled;  // True = restore/store chain artifacts
+    QThreadPool m_artifactStorePool; // Single thread storing artifacts; waits for pending stores when destroyed
+    QHash<QString, int> m_storingKeys; // Cache key -> stores in flight (restores of these keys miss)
+    bool m_failFastEnabled;       // True = abort jobs at the first fatal diagnostic in live output
+    QString m_compilerLauncher;   // ccache/sccache sampled around batches (empty = off)
+    CompilerCache::Stats m_compilerCacheBefore; // Counters when the current batch started
+    QString m_compilerCacheSummary; // Summary of the last finished batch
+    int m_compilerCacheQuery;     // Serial of the latest counter query (results of older ones are dropped)
+    bool m_isSamplingCompilerCache; // Drained batch waits for the compiler cache counters
+    QElapsedTimer m_batchTimer;   // Wall time of the current batch
+    ResourceUsage m_batchUsage;   // Resources of the commands of the current batch finished so far
+    QTimer* m_resourceTimer;      // Samples running process trees (platforms without exact accounting)
+    bool m_isSamplingResources;   // A /proc snapshot is being read on the thread pool
+    CommandHistory m_commandHistory; // Persistent per-command resource usage
+    BuildTrace m_trace;           // Timeline of the current batch
+    bool m_traceEnabled;          // True = write a trace file per batch
+    QString m_lastTracePath;      // Trace file of the last batch
+    qint64 m_traceCpuMs;          // CPU time of the batch at the last counter sample
+    qint64 m_traceSampleUs;       // Trace time of the last counter sample
+    bool m_buildTimingsEnabled;   // True = log the build time breakdown of every build command
+    int m_pendingTimingReports;   // Build time breakdowns still being collected on the thread pool
+    bool m_isWaitingForTimingReports; // Drained batch waits for the pending breakdowns
+    DiagnosticTable* m_diagnostics; // Diagnostics of the current batch
+    bool m_isExecuting;           // Execution state flag (true while any job is queued or running)
+    bool m_isRemote;              // Remote flag of the job currently copying files
+    QString m_copyRemoteHost;     // Remote receiver of the job currently copying files
+    QString m_copyRemotePath;     // Remote target directory of the job currently copying files
 };
 
 #endif // COMMANDEXECUTOR_H
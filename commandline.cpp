@@ -0,0 +1,300 @@
+#include "commandline.h"
+#include <QRegularExpression>
+
+// Unquoted characters that only a shell can interpret
+static const QString POSIX_SHELL_CHARS   = "|&;<>()`*?[";
+static const QString WINDOWS_SHELL_CHARS = "|&<>^()";
+
+static bool isVariableStart(QChar c)
+{
+    return c.isLetter() || c == '_';
+}
+
+static bool isVariableChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == '_';
+}
+
+QStringList CommandLine::split(const QString& command, const QProcessEnvironment& env, bool* needsShell)
+{
+    QProcessEnvironment environment = env.isEmpty() ? QProcessEnvironment::systemEnvironment() : env;
+    bool isShellNeeded = false;
+#ifdef Q_OS_WIN
+    QStringList args = splitWindows(command, environment, isShellNeeded);
+#else
+    QStringList args = splitPosix(command, environment, isShellNeeded);
+#endif
+    if (needsShell) *needsShell = isShellNeeded;
+    return args;
+}
+
+QStringList CommandLine::splitPosix(const QString& command, const QProcessEnvironment& env, bool& needsShell)
+{
+    enum QuoteState { Plain, Single, Double };
+
+    QStringList args;
+    QString     word;
+    bool        hasWord = false;  // True = a quote opened the word (keeps "" as an empty argument)
+    QuoteState  state   = Plain;
+    int         len     = command.length();
+    int         pos     = 0;
+
+    while (pos < len)
+    {
+        QChar c = command[pos];
+
+        if (state == Single)
+        {
+            if (c == '\'') state = Plain;
+            else word += c;
+            pos++;
+            continue;
+        }
+
+        if (state == Double)
+        {
+            if (c == '"')
+            {
+                state = Plain;
+                pos++;
+            }
+            else if (c == '\\' && pos + 1 < len && QString("$`\"\\\n").contains(command[pos + 1]))
+            {
+                word += command[pos + 1];
+                pos += 2;
+            }
+            else if (c == '$')
+            {
+                pos = expandPosixVariable(command, pos, env, word, needsShell);
+            }
+            else
+            {
+                if (c == '`') needsShell = true;
+                word += c;
+                pos++;
+            }
+            continue;
+        }
+
+        if (c.isSpace())
+        {
+            if (hasWord || !word.isEmpty()) args << word;
+            word.clear();
+            hasWord = false;
+            pos++;
+        }
+        else if (c == '\\')
+        {
+            if (pos + 1 < len && command[pos + 1] != '\n') word += command[pos + 1];
+            hasWord = true;
+            pos += 2;
+        }
+        else if (c == '\'' || c == '"')
+        {
+            state   = c == '\'' ? Single : Double;
+            hasWord = true;
+            pos++;
+        }
+        else if (c == '$')
+        {
+            // Unquoted empty expansion produces no argument, like the shell
+            pos = expandPosixVariable(command, pos, env, word, needsShell);
+        }
+        else
+        {
+            if (POSIX_SHELL_CHARS.contains(c)) needsShell = true;
+            if ((c == '~' || c == '#') && word.isEmpty() && !hasWord) needsShell = true;
+            word += c;
+            pos++;
+        }
+    }
+
+    // Unterminated quote: let the shell report it
+    if (state != Plain) needsShell = true;
+    if (hasWord || !word.isEmpty()) args << word;
+    return args;
+}
+
+// Expand $NAME / ${NAME} at pos (pointing at '$'); returns the position after the reference
+int CommandLine::expandPosixVariable(const QString& command, int pos, const QProcessEnvironment& env, QString& word, bool& needsShell)
+{
+    int len = command.length();
+    if (pos + 1 >= len)
+    {
+        word += '$';
+        return pos + 1;
+    }
+
+    QChar next = command[pos + 1];
+    if (next == '{')
+    {
+        int close = command.indexOf('}', pos + 2);
+        QString name = close < 0 ? QString() : command.mid(pos + 2, close - pos - 2);
+        bool isPlainName = !name.isEmpty() && isVariableStart(name[0]);
+        for (int i = 1; isPlainName && i < name.length(); ++i)
+        {
+            isPlainName = isVariableChar(name[i]);
+        }
+        if (isPlainName)
+        {
+            word += env.value(name);
+            return close + 1;
+        }
+        // ${x:-default}, ${#x}, ...
+        needsShell = true;
+    }
+    else if (isVariableStart(next))
+    {
+        int end = pos + 1;
+        while (end < len && isVariableChar(command[end])) end++;
+        word += env.value(command.mid(pos + 1, end - pos - 1));
+        return end;
+    }
+    else if (next == '(' || next.isDigit() || QString("?$!#@*-").contains(next))
+    {
+        // Command substitution, arithmetic and special parameters
+        needsShell = true;
+    }
+
+    word += '$';
+    return pos + 1;
+}
+
+QStringList CommandLine::splitWindows(const QString& command, const QProcessEnvironment& env, bool& needsShell)
+{
+    QStringList args;
+    QString     word;
+    bool        hasWord = false;
+    bool        inQuote = false;
+    int         len     = command.length();
+    int         pos     = 0;
+
+    while (pos < len)
+    {
+        QChar c = command[pos];
+
+        if (c == '\\')
+        {
+            // 2n backslashes + quote -> n backslashes, quote toggles; 2n+1 -> n backslashes + literal quote
+            int count = 0;
+            while (pos + count < len && command[pos + count] == '\\') count++;
+            if (pos + count < len && command[pos + count] == '"')
+            {
+                word += QString(count / 2, '\\');
+                if (count % 2 == 1)
+                {
+                    word += '"';
+                    pos += count + 1;
+                }
+                else
+                {
+                    pos += count;
+                }
+            }
+            else
+            {
+                word += QString(count, '\\');
+                pos += count;
+            }
+            hasWord = true;
+        }
+        else if (c == '"')
+        {
+            inQuote = !inQuote;
+            hasWord = true;
+            pos++;
+        }
+        else if (!inQuote && c.isSpace())
+        {
+            if (hasWord || !word.isEmpty()) args << word;
+            word.clear();
+            hasWord = false;
+            pos++;
+        }
+        else if (c == '%' && pos + 1 < len && command[pos + 1] == '%')
+        {
+            // %% is a literal % (batch file escape, produced by quote())
+            word += c;
+            pos += 2;
+        }
+        else if (c == '%')
+        {
+            // %NAME% is expanded like cmd.exe does (also inside quotes); unknown names stay literal
+            int close = command.indexOf('%', pos + 1);
+            QString name = close < 0 ? QString() : command.mid(pos + 1, close - pos - 1);
+            if (!name.isEmpty() && env.contains(name))
+            {
+                word += env.value(name);
+                pos = close + 1;
+            }
+            else
+            {
+                word += c;
+                pos++;
+            }
+        }
+        else
+        {
+            if (!inQuote && WINDOWS_SHELL_CHARS.contains(c)) needsShell = true;
+            word += c;
+            pos++;
+        }
+    }
+
+    if (inQuote) needsShell = true;
+    if (hasWord || !word.isEmpty()) args << word;
+    return args;
+}
+
+QString CommandLine::quote(const QString& arg)
+{
+#ifdef Q_OS_WIN
+    if (!arg.isEmpty() && !arg.contains(QRegularExpression(R"([\s"%|&<>^()])"))) return arg;
+
+    // Backslashes are literal unless they precede a quote (or the closing quote)
+    QString quoted = "\"";
+    int backslashes = 0;
+    for (QChar c : arg)
+    {
+        if (c == '\\')
+        {
+            backslashes++;
+            continue;
+        }
+        if (c == '"')
+        {
+            quoted += QString(backslashes * 2 + 1, '\\');
+        }
+        else if (c == '%')
+        {
+            // Doubled: quotes do not stop %NAME% expansion
+            quoted += QString(backslashes, '\\');
+            quoted += c;
+        }
+        else
+        {
+            quoted += QString(backslashes, '\\');
+        }
+        backslashes = 0;
+        quoted += c;
+    }
+    quoted += QString(backslashes * 2, '\\');
+    quoted += "\"";
+    return quoted;
+#else
+    if (!arg.isEmpty() && !arg.contains(QRegularExpression(R"([\s'"\\$`|&;<>()*?\[#~])"))) return arg;
+    QString escaped = arg;
+    escaped.replace("'", "'\\''");
+    return "'" + escaped + "'";
+#endif
+}
+
+QString CommandLine::join(const QStringList& args)
+{
+    QStringList quoted;
+    for (const QString& arg : args)
+    {
+        if (!arg.isEmpty()) quoted << quote(arg);
+    }
+    return quoted.join(' ');
+}
@@ -0,0 +1,34 @@
+#ifndef COMMANDLINE_H
+#define COMMANDLINE_H
+
+#include <QString>
+#include <QStringList>
+#include <QProcessEnvironment>
+
+// Shell-word tokenizer used to launch commands without an intermediate shell
+// POSIX: '...', "..." and backslash escapes, $VAR / ${VAR} expansion
+// Windows: CommandLineToArgvW quoting rules (backslashes only escape quotes), %VAR% expansion, %% = literal %
+class CommandLine
+{
+public:
+    // Split a command line into program + arguments
+    // env: variables used for expansion (empty = environment of this process)
+    // needsShell: set when the line uses pipes, redirection, command chaining, globs or command substitution
+    //             (argv is then only an approximation; the caller must hand the line to the shell)
+    static QStringList split(const QString& command, const QProcessEnvironment& env = QProcessEnvironment(),
+                             bool* needsShell = nullptr);
+
+    // Quote one argument so split() returns it unchanged (plain words are returned as is)
+    // Windows: % is doubled, so the result only round-trips through split(), not through cmd.exe
+    static QString quote(const QString& arg);
+
+    // Quote and join arguments; empty arguments are dropped (planners use them as "option off" placeholders)
+    static QString join(const QStringList& args);
+
+private:
+    static QStringList splitPosix(const QString& command, const QProcessEnvironment& env, bool& needsShell);
+    static QStringList splitWindows(const QString& command, const QProcessEnvironment& env, bool& needsShell);
+    static int expandPosixVariable(const QString& command, int pos, const QProcessEnvironment& env, QString& word, bool& needsShell);
+};
+
+#endif // COMMANDLINE_H
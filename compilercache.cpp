@@ -0,0 +1,157 @@
+#include "compilercache.h"
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QTimer>
+
+// Stats queries are quick; a hung cache server must not hold back the end of a batch for long
+static const int QUERY_TIMEOUT_MS = 5000;
+
+bool CompilerCache::isSccache(const QString& launcher)
+{
+    return QFileInfo(launcher).completeBaseName().compare("sccache", Qt::CaseInsensitive) == 0;
+}
+
+void CompilerCache::query(const QString& launcher, const QProcessEnvironment& env, QObject* context, const Callback& done)
+{
+    if (launcher.isEmpty())
+    {
+        done(Stats());
+        return;
+    }
+
+    if (isSccache(launcher))
+    {
+        runLauncher(launcher, QStringList() << "--show-stats" << "--stats-format=json", env, context, [done](bool ok, const QString& output) {
+            Stats stats;
+            if (ok) stats.isValid = parseSccacheStats(output.toUtf8(), stats);
+            done(stats);
+        });
+        return;
+    }
+
+    // ccache >= 4 prints machine-readable counters; 3.x only has the human-readable summary
+    runLauncher(launcher, QStringList() << "--print-stats", env, context, [launcher, env, context, done](bool ok, const QString& output) {
+        Stats stats;
+        if (ok && parseCcacheStats(output, stats))
+        {
+            stats.isValid = true;
+            done(stats);
+            return;
+        }
+        runLauncher(launcher, QStringList() << "-s", env, context, [done](bool ok, const QString& output) {
+            Stats stats;
+            if (ok) stats.isValid = parseCcacheSummary(output, stats);
+            done(stats);
+        });
+    });
+}
+
+void CompilerCache::runLauncher(const QString& launcher, const QStringList& args, const QProcessEnvironment& env,
+                                QObject* context, const OutputCallback& done)
+{
+    // Owned by context: a pending query dies with it
+    QProcess* process = new QProcess(context);
+    process->setProcessEnvironment(env);
+    QObject::connect(process, &QProcess::finished, context, [process, done](int exitCode, QProcess::ExitStatus exitStatus) {
+        bool ok = exitStatus == QProcess::NormalExit && exitCode == 0;
+        process->deleteLater();
+        done(ok, ok ? QString::fromUtf8(process->readAllStandardOutput()) : QString());
+    });
+    // finished() is not emitted when the launcher cannot be started
+    QObject::connect(process, &QProcess::errorOccurred, context, [process, done](QProcess::ProcessError error) {
+        if (error != QProcess::FailedToStart) return;
+        process->deleteLater();
+        done(false, QString());
+    });
+    QTimer::singleShot(QUERY_TIMEOUT_MS, process, &QProcess::kill);
+    process->start(launcher, args);
+}
+
+// "<counter>\t<value>" lines
+bool CompilerCache::parseCcacheStats(const QString& output, Stats& stats)
+{
+    bool hasCounters = false;
+    const QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+    for (const QString& line : lines)
+    {
+        QStringList fields = line.trimmed().split('\t');
+        if (fields.size() != 2) continue;
+        qint64 value = fields[1].toLongLong();
+        if (fields[0] == "direct_cache_hit" || fields[0] == "preprocessed_cache_hit")
+        {
+            stats.hits += value;
+            hasCounters = true;
+        }
+        else if (fields[0] == "cache_miss")
+        {
+            stats.misses += value;
+            hasCounters = true;
+        }
+    }
+    return hasCounters;
+}
+
+// "cache hit (direct)   12" / "cache miss   3"
+bool CompilerCache::parseCcacheSummary(const QString& output, Stats& stats)
+{
+    static const QRegularExpression hitRegex(R"(^cache hit \((?:direct|preprocessed)\)\s+(\d+))", QRegularExpression::MultilineOption);
+    static const QRegularExpression missRegex(R"(^cache miss\s+(\d+))", QRegularExpression::MultilineOption);
+
+    bool hasCounters = false;
+    QRegularExpressionMatchIterator it = hitRegex.globalMatch(output);
+    while (it.hasNext())
+    {
+        stats.hits += it.next().captured(1).toLongLong();
+        hasCounters = true;
+    }
+    QRegularExpressionMatch missMatch = missRegex.match(output);
+    if (missMatch.hasMatch())
+    {
+        stats.misses = missMatch.captured(1).toLongLong();
+        hasCounters = true;
+    }
+    return hasCounters;
+}
+
+// {"stats": {"cache_hits": {"counts": {"C/C++": n}}, "cache_misses": {"counts": {...}}}}
+bool CompilerCache::parseSccacheStats(const QByteArray& output, Stats& stats)
+{
+    QJsonObject root = QJsonDocument::fromJson(output).object().value("stats").toObject();
+    if (root.isEmpty()) return false;
+
+    auto sumCounts = [&root](const QString& key) {
+        qint64 total = 0;
+        const QJsonObject counts = root.value(key).toObject().value("counts").toObject();
+        for (auto it = counts.constBegin(); it != counts.constEnd(); ++it)
+        {
+            total += it.value().toVariant().toLongLong();
+        }
+        return total;
+    };
+    stats.hits   = sumCounts("cache_hits");
+    stats.misses = sumCounts("cache_misses");
+    return true;
+}
+
+QString CompilerCache::summary(const Stats& before, const Stats& after, qint64 wallMs)
+{
+    if (!before.isValid || !after.isValid) return QString();
+
+    // Counters drop when the cache is zeroed during the build; nothing meaningful to report then
+    qint64 hits   = after.hits - before.hits;
+    qint64 misses = after.misses - before.misses;
+    if (hits < 0 || misses < 0) return QString();
+    if (hits + misses == 0) return "Compiler cache: no compilations";
+
+    QString text = QString("Compiler cache: %1 hits / %2 misses (%3% hit rate)")
+                       .arg(hits).arg(misses).arg(100.0 * hits / (hits + misses), 0, 'f', 1);
+    if (misses > 0 && hits > 0)
+    {
+        qint64 savedSeconds = hits * wallMs / misses / 1000;
+        text += QString(", ~%1m %2s saved (estimate)").arg(savedSeconds / 60).arg(savedSeconds % 60, 2, 10, QChar('0'));
+    }
+    return text;
+}
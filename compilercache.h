@@ -0,0 +1,44 @@
+#ifndef COMPILERCACHE_H
+#define COMPILERCACHE_H
+
+#include <QString>
+#include <QProcessEnvironment>
+#include <functional>
+
+class QObject;
+
+// Counters of the compiler cache used as CMAKE_<LANG>_COMPILER_LAUNCHER (ccache or sccache)
+// Counters are cache-wide: builds running outside EazyBuild at the same time are counted too
+class CompilerCache
+{
+public:
+    struct Stats
+    {
+        qint64 hits    = 0;
+        qint64 misses  = 0;
+        bool   isValid = false;  // False = launcher missing or its output not understood
+    };
+
+    using Callback = std::function<void(const Stats&)>;
+
+    // Query cumulative counters ("ccache", "sccache" or a path to either) without blocking
+    // done runs on context's thread once the launcher exited (right away for an empty launcher);
+    // it is dropped when context is destroyed first
+    static void query(const QString& launcher, const QProcessEnvironment& env, QObject* context, const Callback& done);
+
+    // One log line for a build: hits, misses, hit rate and estimated wall time saved
+    // Time saved = hits x (wall time / misses), i.e. every hit is assumed to cost as much as a miss of this build
+    static QString summary(const Stats& before, const Stats& after, qint64 wallMs);
+
+    static bool isSccache(const QString& launcher);
+
+private:
+    static bool parseCcacheStats(const QString& output, Stats& stats);
+    static bool parseCcacheSummary(const QString& output, Stats& stats);
+    static bool parseSccacheStats(const QByteArray& output, Stats& stats);
+    using OutputCallback = std::function<void(bool ok, const QString& output)>;
+    static void runLauncher(const QString& launcher, const QStringList& args, const QProcessEnvironment& env,
+                            QObject* context, const OutputCallback& done);
+};
+
+#endif // COMPILERCACHE_H
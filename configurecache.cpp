@@ -0,0 +1,155 @@
+#include "configurecache.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+
+// Record file written next to CMakeCache.txt
+static const char* const RECORD_FILE_NAME = "EazyBuildConfigure.json";
+
+// Check whether cmake arguments describe a configure step and resolve its build dir
+bool ConfigureCache::parseConfigureCommand(const QStringList& args, const QString& workingDir, QString& buildDir)
+{
+    QString dir;
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const QString& arg = args[i];
+        if (arg == "--build" || arg == "--install" || arg == "-E" || arg == "-P") return false;
+        if (arg == "-B" && i + 1 < args.size())
+        {
+            dir = args[++i];
+        }
+        else if (arg.startsWith("-B") && arg.size() > 2)
+        {
+            dir = arg.mid(2);
+        }
+    }
+    if (dir.isEmpty()) return false;
+
+    buildDir = QDir::cleanPath(QDir::isAbsolutePath(dir) ? dir : QDir(workingDir).filePath(dir));
+    return true;
+}
+
+// Fingerprint = working dir + non-empty arguments + toolchain signature + toolchain file content
+QString ConfigureCache::fingerprint(const QStringList& args, const QString& workingDir)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QDir::cleanPath(workingDir).toUtf8());
+    hash.addData("\n", 1);
+
+    for (const QString& arg : args)
+    {
+        if (arg.isEmpty()) continue;
+        hash.addData(arg.toUtf8());
+        hash.addData("\n", 1);
+
+        // Toolchain file content is part of the configuration
+        int toolchainPos = arg.indexOf("CMAKE_TOOLCHAIN_FILE");
+        if (toolchainPos >= 0 && arg.contains('='))
+        {
+            QString toolchainPath = arg.mid(arg.indexOf('=') + 1);
+            QFile toolchainFile(QDir::isAbsolutePath(toolchainPath) ? toolchainPath : QDir(workingDir).filePath(toolchainPath));
+            if (toolchainFile.open(QIODevice::ReadOnly))
+            {
+                hash.addData(toolchainFile.readAll());
+            }
+        }
+    }
+
+    hash.addData(toolchainSignature().toUtf8());
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+// Compare pending fingerprint with the record of the build dir
+bool ConfigureCache::isUpToDate(const QString& buildDir, const QString& fingerprint)
+{
+    QString stamp = cmakeCacheStamp(buildDir);
+    if (stamp.isEmpty()) return false; // Never configured (or deleted)
+
+    if (!m_records.contains(buildDir))
+    {
+        // Load on-disk record (survives application restarts)
+        QFile recordFile(QDir(buildDir).filePath(RECORD_FILE_NAME));
+        if (!recordFile.open(QIODevice::ReadOnly)) return false;
+        QJsonObject obj = QJsonDocument::fromJson(recordFile.readAll()).object();
+        Record record;
+        record.fingerprint = obj.value("fingerprint").toString();
+        record.cacheStamp = obj.value("cacheStamp").toString();
+        m_records.insert(buildDir, record);
+    }
+
+    const Record& record = m_records[buildDir];
+    return record.fingerprint == fingerprint && record.cacheStamp == stamp;
+}
+
+// Record successful configure (memory + build dir)
+void ConfigureCache::store(const QString& buildDir, const QString& fingerprint)
+{
+    Record record;
+    record.fingerprint = fingerprint;
+    record.cacheStamp = cmakeCacheStamp(buildDir);
+    if (record.cacheStamp.isEmpty()) return;
+    m_records.insert(buildDir, record);
+
+    QJsonObject obj;
+    obj.insert("fingerprint", record.fingerprint);
+    obj.insert("cacheStamp", record.cacheStamp);
+    QFile recordFile(QDir(buildDir).filePath(RECORD_FILE_NAME));
+    if (recordFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        recordFile.write(QJsonDocument(obj).toJson(QJsonDocument::Compact));
+    }
+}
+
+// Forget fingerprint of a build dir
+void ConfigureCache::invalidate(const QString& buildDir)
+{
+    m_records.remove(buildDir);
+    QFile::remove(QDir(buildDir).filePath(RECORD_FILE_NAME));
+}
+
+// Re-stamp record of a build dir whose configuration is still current
+void ConfigureCache::refreshStamp(const QString& buildDir)
+{
+    QString stamp = cmakeCacheStamp(buildDir);
+    auto it = m_records.find(buildDir);
+    if (it == m_records.end() || it->cacheStamp == stamp) return;
+    store(buildDir, it->fingerprint);
+}
+
+// cmake version + compiler related environment
+QString ConfigureCache::toolchainSignature()
+{
+    if (!m_toolchainSignature.isEmpty()) return m_toolchainSignature;
+
+    QProcess versionProcess;
+    versionProcess.start("cmake", QStringList() << "--version");
+    if (versionProcess.waitForFinished(5000))
+    {
+        m_toolchainSignature = QString::fromLocal8Bit(versionProcess.readAllStandardOutput()).section('\n', 0, 0);
+    }
+
+    // Variables that change the compiler CMake detects
+    static const char* const TOOLCHAIN_VARS[] = {
+        "CC", "CXX", "CFLAGS", "CXXFLAGS", "LDFLAGS", "CMAKE_GENERATOR", "CMAKE_TOOLCHAIN_FILE",
+        "VCToolsVersion", "VCINSTALLDIR", "WindowsSDKVersion",
+    };
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    for (const char* name : TOOLCHAIN_VARS)
+    {
+        m_toolchainSignature += QString("\n%1=%2").arg(QString::fromLatin1(name), env.value(QString::fromLatin1(name)));
+    }
+    return m_toolchainSignature;
+}
+
+// CMakeCache.txt size + mtime (empty if the build dir was never configured)
+QString ConfigureCache::cmakeCacheStamp(const QString& buildDir)
+{
+    QFileInfo cacheInfo(QDir(buildDir).filePath("CMakeCache.txt"));
+    if (!cacheInfo.exists()) return "";
+    return QString("%1:%2").arg(cacheInfo.size()).arg(cacheInfo.lastModified().toMSecsSinceEpoch());
+}
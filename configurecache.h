@@ -0,0 +1,76 @@
+#ifndef CONFIGURECACHE_H
+#define CONFIGURECACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+/**
+ * @brief Per build directory fingerprint of the last successful cmake configure
+ * @note Fingerprint = configure arguments + generator + toolchain (cmake version, compiler environment)
+ * @note A configure step is redundant when the fingerprint matches and CMakeCache.txt was not touched since
+ */
+class ConfigureCache
+{
+public:
+    ConfigureCache() = default;
+
+    /**
+     * @brief Check whether cmake arguments describe a configure step ("-B <dir>" without "--build")
+     * @param args Arguments without the cmake program
+     * @param workingDir Working directory of the command (resolves relative paths)
+     * @param buildDir Receives the absolute build directory
+     * @return True = configure command
+     */
+    static bool parseConfigureCommand(const QStringList& args, const QString& workingDir, QString& buildDir);
+
+    /**
+     * @brief Compute fingerprint of a configure command
+     * @param args Arguments without the cmake program
+     * @param workingDir Working directory of the command
+     * @return Hex SHA-1 fingerprint
+     */
+    QString fingerprint(const QStringList& args, const QString& workingDir);
+
+    /**
+     * @brief Check whether a build dir was configured with the same fingerprint
+     * @param buildDir Absolute build directory
+     * @param fingerprint Fingerprint of the pending configure command
+     * @return True = configure can be skipped
+     */
+    bool isUpToDate(const QString& buildDir, const QString& fingerprint);
+
+    /**
+     * @brief Record a successful configure
+     */
+    void store(const QString& buildDir, const QString& fingerprint);
+
+    /**
+     * @brief Forget the fingerprint of a build dir (failed or interrupted configure)
+     */
+    void invalidate(const QString& buildDir);
+
+    /**
+     * @brief Re-stamp a record after cmake --build (the build may regenerate CMakeCache.txt)
+     * @param buildDir Absolute build directory
+     */
+    void refreshStamp(const QString& buildDir);
+
+private:
+    // cmake version + compiler related environment (queried once per session)
+    QString toolchainSignature();
+
+    // CMakeCache.txt size + mtime, detects configures done outside EazyBuild
+    static QString cmakeCacheStamp(const QString& buildDir);
+
+    struct Record
+    {
+        QString fingerprint;
+        QString cacheStamp;
+    };
+
+    QHash<QString, Record> m_records;     // Warm copy of the on-disk records
+    QString m_toolchainSignature;
+};
+
+#endif // CONFIGURECACHE_H
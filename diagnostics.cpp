@@ -0,0 +1,216 @@
+#include "diagnostics.h"
+#include <QDir>
+#include <QRegularExpression>
+
+bool DiagnosticParser::parse(const QString& line, Diagnostic& diagnostic)
+{
+    // MSVC/MSBuild and clang-cl: [N>]a.cpp(12[,5]): [fatal ]error C2065: message [proj.vcxproj]
+    static const QRegularExpression msvcRegex(
+        R"(^(?:\d+>)?\s*(.+?)\((\d+)(?:,(\d+))?(?:,\d+,\d+)?\)\s*:\s*(?:fatal )?(error|warning)(?:\s+([A-Za-z]+\d+))?\s*:\s*(.*)$)",
+        QRegularExpression::CaseInsensitiveOption);
+    // GCC/Clang: a.cpp:12[:5]: [fatal ]error: message [-Wflag]
+    static const QRegularExpression gccRegex(
+        R"(^(.+?):(\d+):(?:(\d+):)?\s*(?:fatal )?(error|warning):\s*(.*?)(?:\s+\[(-W[^\]\s]+)\])?$)");
+    // MSVC without location: LINK : fatal error LNK1104: ..., foo.obj : error LNK2019: ...
+    static const QRegularExpression msvcNoLocationRegex(
+        R"(^(?:\d+>)?\s*(.+?)\s*:\s*(?:fatal )?(error|warning)\s+([A-Za-z]+\d+)\s*:\s*(.*)$)",
+        QRegularExpression::CaseInsensitiveOption);
+    // Compiler drivers and linkers: clang: error: ..., collect2: error: ..., ld.lld: error: ...
+    static const QRegularExpression toolRegex(R"(^([\w.+-]+):\s*(?:fatal )?(error|warning):\s*(.*)$)");
+    // GNU ld: main.o:main.c:(.text+0x5): undefined reference to `foo'
+    static const QRegularExpression undefinedReferenceRegex(R"(^(.+?):(?:(\d+):)?(?:\([^)]*\):)?\s*(undefined reference to .*)$)");
+    // CMake: CMake Error at CMakeLists.txt:12 (message):, CMake Error: The source directory ... does not exist
+    static const QRegularExpression cmakeRegex(R"(^CMake (Error|Warning)(?: \(dev\))?(?: at (.+?):(\d+) \((\w+)\))?:\s*(.*)$)");
+    // MSBuild appends the project to every diagnostic
+    static const QRegularExpression projectSuffixRegex(R"(\s+\[[^\[\]]+\.\w*proj\]$)");
+
+    QString text = line.trimmed();
+    if (text.isEmpty()) return false;
+
+    diagnostic = Diagnostic();
+    QRegularExpressionMatch match = msvcRegex.match(text);
+    if (match.hasMatch())
+    {
+        diagnostic.file     = match.captured(1).trimmed();
+        diagnostic.line     = match.captured(2).toInt();
+        diagnostic.column   = match.captured(3).toInt();
+        diagnostic.severity = match.captured(4).compare("warning", Qt::CaseInsensitive) == 0 ? Diagnostic::Warning : Diagnostic::Error;
+        diagnostic.code     = match.captured(5).toUpper();
+        diagnostic.message  = match.captured(6).remove(projectSuffixRegex);
+        return true;
+    }
+
+    match = gccRegex.match(text);
+    if (match.hasMatch())
+    {
+        diagnostic.file     = match.captured(1).trimmed();
+        diagnostic.line     = match.captured(2).toInt();
+        diagnostic.column   = match.captured(3).toInt();
+        diagnostic.severity = match.captured(4) == "warning" ? Diagnostic::Warning : Diagnostic::Error;
+        diagnostic.message  = match.captured(5);
+        diagnostic.code     = match.captured(6);
+        return true;
+    }
+
+    match = msvcNoLocationRegex.match(text);
+    if (match.hasMatch())
+    {
+        // Tool names (LINK, cl, MSBUILD) are no location
+        QString source = match.captured(1).trimmed();
+        bool isFile = source.contains('.') || source.contains('/') || source.contains('\\');
+        diagnostic.file     = isFile ? source : QString();
+        diagnostic.severity = match.captured(2).compare("warning", Qt::CaseInsensitive) == 0 ? Diagnostic::Warning : Diagnostic::Error;
+        diagnostic.code     = match.captured(3).toUpper();
+        diagnostic.message  = match.captured(4).remove(projectSuffixRegex);
+        if (!isFile) diagnostic.message = source + ": " + diagnostic.message;
+        return true;
+    }
+
+    match = toolRegex.match(text);
+    if (match.hasMatch())
+    {
+        diagnostic.severity = match.captured(2) == "warning" ? Diagnostic::Warning : Diagnostic::Error;
+        diagnostic.message  = match.captured(1) + ": " + match.captured(3);
+        return true;
+    }
+
+    // The message of a located CMake diagnostic follows on the next lines: the failing command stands in
+    match = cmakeRegex.match(text);
+    if (match.hasMatch())
+    {
+        diagnostic.file     = match.captured(2);
+        diagnostic.line     = match.captured(3).toInt();
+        diagnostic.severity = match.captured(1) == "Warning" ? Diagnostic::Warning : Diagnostic::Error;
+        diagnostic.code     = "CMake";
+        diagnostic.message  = match.captured(5).isEmpty() ? match.captured(4) + "()" : match.captured(5);
+        return true;
+    }
+
+    match = undefinedReferenceRegex.match(text);
+    if (match.hasMatch())
+    {
+        diagnostic.file     = match.captured(1).trimmed();
+        diagnostic.line     = match.captured(2).toInt();
+        diagnostic.severity = Diagnostic::Error;
+        diagnostic.message  = match.captured(3);
+        return true;
+    }
+
+    return false;
+}
+
+DiagnosticTable::DiagnosticTable(QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_errorCount(0)
+    , m_warningCount(0)
+    , m_repeatCount(0)
+{
+}
+
+// Same severity, location, code and message; paths compared case-insensitively and separator-agnostic
+QString DiagnosticTable::keyOf(const Diagnostic& diagnostic)
+{
+    return QString("%1|%2|%3|%4|%5|%6")
+        .arg(int(diagnostic.severity))
+        .arg(QDir::cleanPath(QDir::fromNativeSeparators(diagnostic.file)).toLower())
+        .arg(diagnostic.line)
+        .arg(diagnostic.column)
+        .arg(diagnostic.code, diagnostic.message);
+}
+
+void DiagnosticTable::add(const Diagnostic& diagnostic)
+{
+    QString key = keyOf(diagnostic);
+    auto existing = m_rowByKey.constFind(key);
+    if (existing != m_rowByKey.constEnd())
+    {
+        int row = existing.value();
+        m_rows[row].count++;
+        m_repeatCount++;
+        QModelIndex countIndex = index(row, CountColumn);
+        emit dataChanged(countIndex, countIndex);
+        return;
+    }
+
+    int row = m_rows.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_rows.append(diagnostic);
+    m_rows.last().count = 1;
+    m_rowByKey.insert(key, row);
+    if (diagnostic.severity == Diagnostic::Error) m_errorCount++;
+    else m_warningCount++;
+    endInsertRows();
+}
+
+void DiagnosticTable::clear()
+{
+    beginResetModel();
+    m_rows.clear();
+    m_rowByKey.clear();
+    m_errorCount = 0;
+    m_warningCount = 0;
+    m_repeatCount = 0;
+    endResetModel();
+}
+
+QString DiagnosticTable::summary() const
+{
+    QString text = QString("Diagnostics: %1 error(s), %2 warning(s)").arg(m_errorCount).arg(m_warningCount);
+    if (m_repeatCount > 0) text += QString(", %1 repeated report(s) folded").arg(m_repeatCount);
+    return text;
+}
+
+QString DiagnosticTable::severityName(Diagnostic::Severity severity)
+{
+    return severity == Diagnostic::Warning ? "warning" : "error";
+}
+
+int DiagnosticTable::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int DiagnosticTable::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant DiagnosticTable::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size()) return QVariant();
+    const Diagnostic& diagnostic = m_rows[index.row()];
+
+    if (role == Qt::ToolTipRole && index.column() == MessageColumn) return diagnostic.message;
+    if (role != Qt::DisplayRole) return QVariant();
+
+    switch (index.column())
+    {
+    case SeverityColumn: return severityName(diagnostic.severity);
+    case CodeColumn:     return diagnostic.code;
+    case FileColumn:     return diagnostic.file;
+    case LineColumn:     return diagnostic.line > 0 ? QVariant(diagnostic.line) : QVariant();
+    case ColumnColumn:   return diagnostic.column > 0 ? QVariant(diagnostic.column) : QVariant();
+    case MessageColumn:  return diagnostic.message;
+    case JobColumn:      return diagnostic.job;
+    case CountColumn:    return diagnostic.count;
+    default:             return QVariant();
+    }
+}
+
+QVariant DiagnosticTable::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+
+    switch (section)
+    {
+    case SeverityColumn: return "Severity";
+    case CodeColumn:     return "Code";
+    case FileColumn:     return "File";
+    case LineColumn:     return "Line";
+    case ColumnColumn:   return "Column";
+    case MessageColumn:  return "Message";
+    case JobColumn:      return "Job";
+    case CountColumn:    return "Count";
+    default:             return QVariant();
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+// One compiler, linker or CMake diagnostic
+struct Diagnostic
+{
+    enum Severity
+    {
+        Error,
+        Warning,
+    };
+
+    Severity severity = Error;
+    QString  file;          // Empty for diagnostics without a location (e.g. LINK : fatal error LNK1104)
+    int      line = 0;      // 0 = unknown
+    int      column = 0;    // 0 = unknown
+    QString  code;          // C2065, LNK2019, -Wunused-variable, ... (empty = none)
+    QString  message;
+    QString  job;           // Job that reported it first
+    int      count = 1;     // Reports of the same diagnostic (parallel jobs, headers included many times)
+};
+
+// Parses single output lines of MSVC/MSBuild, GCC, Clang, GNU ld/collect2 and CMake
+class DiagnosticParser
+{
+public:
+    // False = the line is no diagnostic
+    static bool parse(const QString& line, Diagnostic& diagnostic);
+};
+
+// Deduplicated diagnostics of one build batch, as a sortable table for views
+// Columns hold plain values (numbers for line/column/count), so QSortFilterProxyModel sorts them correctly
+class DiagnosticTable : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column
+    {
+        SeverityColumn,
+        CodeColumn,
+        FileColumn,
+        LineColumn,
+        ColumnColumn,
+        MessageColumn,
+        JobColumn,
+        CountColumn,
+        ColumnCount,
+    };
+
+    explicit DiagnosticTable(QObject* parent = nullptr);
+
+    // Add a diagnostic or count it again when it was already reported
+    void add(const Diagnostic& diagnostic);
+    void clear();
+
+    const QList<Diagnostic>& diagnostics() const { return m_rows; }
+    int errorCount() const { return m_errorCount; }
+    int warningCount() const { return m_warningCount; }
+
+    // "N error(s), M warning(s)" (unique, plus the number of folded repeats)
+    QString summary() const;
+
+    static QString severityName(Diagnostic::Severity severity);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    static QString keyOf(const Diagnostic& diagnostic);
+
+    QList<Diagnostic>   m_rows;
+    QHash<QString, int> m_rowByKey;     // Dedup key -> row
+    int                 m_errorCount;   // Unique errors
+    int                 m_warningCount; // Unique warnings
+    int                 m_repeatCount;  // Reports folded into an existing row
+};
+
+#endif // DIAGNOSTICS_H
@@ -0,0 +1,157 @@
+#include "errorscanner.h"
+#include <QPair>
+#include <QQueue>
+
+// Lines without a line break (progress output) are kept up to this length only
+static const int MAX_LINE_LENGTH = 64 * 1024;
+
+ErrorScanner::ErrorScanner()
+    : m_state(0)
+    , m_lineMatched(false)
+    , m_lineIsDiagnostic(false)
+{
+}
+
+// Built once: the keyword set is fixed
+const ErrorScanner::Automaton& ErrorScanner::automaton()
+{
+    static const Automaton instance = [] {
+        // Lowercase keywords; "error" already covers "fatal error", the rest are kept for clarity
+        const QList<QPair<QByteArray, uchar>> patterns =
+            {
+            {"error",               KeywordMatch},      // Generic error (C/C++ compiler)
+            {"fatal error",         KeywordMatch},      // Fatal compilation error
+            {"c2146",               KeywordMatch},      // Syntax error: missing token before identifier
+            {"c2065",               KeywordMatch},      // Undeclared identifier
+            {"c2059",               KeywordMatch},      // Syntax error
+            {"link : fatal",        KeywordMatch},      // Link error
+            {"undefined reference", KeywordMatch},      // Link error (Linux)
+            {"warning",             WarningMatch},      // Diagnostic candidate only, never an error
+        };
+
+        // Trie
+        QVector<QVector<int>> children(1, QVector<int>(128, -1));
+        QVector<uchar> output(1, 0);
+        for (const auto& pattern : patterns)
+        {
+            int state = 0;
+            for (char c : pattern.first)
+            {
+                if (children[state][c] < 0)
+                {
+                    children[state][c] = children.size();
+                    children.append(QVector<int>(128, -1));
+                    output.append(0);
+                }
+                state = children[state][c];
+            }
+            output[state] |= pattern.second;
+        }
+
+        // Breadth-first: failure links become DFA transitions, outputs of suffixes are merged
+        Automaton dfa;
+        dfa.next.resize(children.size() * 128);
+        QVector<int> failure(children.size(), 0);
+        QQueue<int> queue;
+        for (int c = 0; c < 128; ++c)
+        {
+            int child = children[0][c];
+            dfa.next[c] = child < 0 ? 0 : child;
+            if (child > 0) queue.enqueue(child);
+        }
+        while (!queue.isEmpty())
+        {
+            int state = queue.dequeue();
+            output[state] |= output[failure[state]];
+            for (int c = 0; c < 128; ++c)
+            {
+                int child = children[state][c];
+                if (child < 0)
+                {
+                    dfa.next[state * 128 + c] = dfa.next[failure[state] * 128 + c];
+                    continue;
+                }
+                failure[child] = dfa.next[failure[state] * 128 + c];
+                dfa.next[state * 128 + c] = child;
+                queue.enqueue(child);
+            }
+        }
+        dfa.output = output;
+        return dfa;
+    }();
+    return instance;
+}
+
+void ErrorScanner::feed(const QString& chunk)
+{
+    const Automaton& dfa = automaton();
+    const QChar* data = chunk.constData();
+    const int size = chunk.size();
+    int lineStart = 0;
+
+    for (int i = 0; i < size; ++i)
+    {
+        ushort c = data[i].unicode();
+        if (c == '\n')
+        {
+            if (m_lineMatched || m_lineIsDiagnostic)
+            {
+                addLine(m_partial + chunk.mid(lineStart, i - lineStart));
+            }
+            m_partial.clear();
+            m_lineMatched = false;
+            m_lineIsDiagnostic = false;
+            m_state = 0;
+            lineStart = i + 1;
+            continue;
+        }
+
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        m_state = c < 128 ? dfa.next[m_state * 128 + c] : 0;
+        uchar match = dfa.output[m_state];
+        if (match & KeywordMatch) m_lineMatched = true;
+        if (match & (KeywordMatch | WarningMatch)) m_lineIsDiagnostic = true;
+    }
+
+    if (lineStart < size && m_partial.size() < MAX_LINE_LENGTH)
+    {
+        m_partial += chunk.mid(lineStart, qMin(size - lineStart, MAX_LINE_LENGTH - m_partial.size()));
+    }
+}
+
+void ErrorScanner::finish()
+{
+    if (m_lineMatched || m_lineIsDiagnostic) addLine(m_partial);
+    m_partial.clear();
+    m_lineMatched = false;
+    m_lineIsDiagnostic = false;
+    m_state = 0;
+}
+
+void ErrorScanner::reset()
+{
+    m_state = 0;
+    m_lineMatched = false;
+    m_lineIsDiagnostic = false;
+    m_partial.clear();
+    m_errorLines.clear();
+    m_seenLines.clear();
+    m_diagnosticLines.clear();
+}
+
+QStringList ErrorScanner::takeDiagnosticLines()
+{
+    QStringList lines;
+    lines.swap(m_diagnosticLines);
+    return lines;
+}
+
+void ErrorScanner::addLine(const QString& line)
+{
+    QString trimmedLine = line.trimmed();
+    if (trimmedLine.isEmpty()) return;
+    m_diagnosticLines.append(trimmedLine);
+    if (!m_lineMatched || m_seenLines.contains(trimmedLine)) return;
+    m_seenLines.insert(trimmedLine);
+    m_errorLines.append(trimmedLine);
+}
@@ -0,0 +1,61 @@
+#ifndef ERRORSCANNER_H
+#define ERRORSCANNER_H
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Incremental error keyword scanner for the output of one running command
+// Chunks are fed as they are read; unterminated lines are carried over to the next chunk
+// All keywords are matched in a single pass (Aho-Corasick DFA, ASCII case folded on the fly),
+// so the cost is linear in the output size and no lowercase copies are allocated
+class ErrorScanner
+{
+public:
+    ErrorScanner();
+
+    // Scan a new output chunk
+    void feed(const QString& chunk);
+
+    // Flush the unterminated last line (call once the command has exited)
+    void finish();
+
+    // Forget everything (a new command starts on the slot)
+    void reset();
+
+    // Trimmed output lines containing an error keyword (deduplicated, in order of appearance)
+    const QStringList& errorLines() const { return m_errorLines; }
+
+    // Lines completed since the last call that may be compiler/linker diagnostics
+    // (error keyword or "warning"; not deduplicated, DiagnosticParser decides)
+    QStringList takeDiagnosticLines();
+
+private:
+    // Output bits of an automaton state
+    enum Match
+    {
+        KeywordMatch = 0x1,
+        WarningMatch = 0x2,
+    };
+
+    // Keyword DFA over folded ASCII (non-ASCII characters go back to the root state)
+    struct Automaton
+    {
+        QVector<int>   next;     // state * 128 + character -> state
+        QVector<uchar> output;   // state -> Match bits
+    };
+
+    static const Automaton& automaton();
+    void addLine(const QString& line);
+
+    int         m_state;
+    bool        m_lineMatched;          // Current (unterminated) line contains a keyword
+    bool        m_lineIsDiagnostic;     // Current line contains a keyword or "warning"
+    QString     m_partial;              // Unterminated line of the previous chunks
+    QStringList m_errorLines;
+    QSet<QString> m_seenLines;
+    QStringList m_diagnosticLines;      // Not yet taken by takeDiagnosticLines()
+};
+
+#endif // ERRORSCANNER_H
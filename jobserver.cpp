@@ -0,0 +1,132 @@
+#include "jobserver.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+JobServer::~JobServer()
+{
+    stop();
+}
+
+// Create token pool (one token per core)
+bool JobServer::start(int tokenCount, QString& errorMsg)
+{
+    stop();
+    if (tokenCount < 1)
+    {
+        errorMsg = "Jobserver needs at least one token";
+        return false;
+    }
+
+#ifdef Q_OS_WIN
+    m_authName = QString("eazybuild_jobserver_%1").arg(QCoreApplication::applicationPid());
+    HANDLE semaphore = CreateSemaphoreW(nullptr, tokenCount, tokenCount, reinterpret_cast<LPCWSTR>(m_authName.utf16()));
+    if (semaphore == nullptr)
+    {
+        errorMsg = QString("CreateSemaphore failed (error %1)").arg(GetLastError());
+        return false;
+    }
+    m_semaphore = semaphore;
+#else
+    m_authName = QDir::tempPath() + QString("/eazybuild_jobserver_%1").arg(QCoreApplication::applicationPid());
+    QByteArray fifoPath = QFile::encodeName(m_authName);
+    ::unlink(fifoPath.constData());
+    if (::mkfifo(fifoPath.constData(), 0600) != 0)
+    {
+        errorMsg = QString("mkfifo %1 failed: %2").arg(m_authName, QString::fromLocal8Bit(strerror(errno)));
+        return false;
+    }
+    // O_RDWR keeps the FIFO open without a peer; O_NONBLOCK makes tryAcquire non-blocking
+    m_fifoFd = ::open(fifoPath.constData(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (m_fifoFd < 0)
+    {
+        errorMsg = QString("open %1 failed: %2").arg(m_authName, QString::fromLocal8Bit(strerror(errno)));
+        ::unlink(fifoPath.constData());
+        return false;
+    }
+    QByteArray tokens(tokenCount, '+');
+    if (::write(m_fifoFd, tokens.constData(), tokens.size()) != tokens.size())
+    {
+        errorMsg = QString("Failed to fill jobserver: %1").arg(QString::fromLocal8Bit(strerror(errno)));
+        ::close(m_fifoFd);
+        m_fifoFd = -1;
+        ::unlink(fifoPath.constData());
+        return false;
+    }
+#endif
+
+    m_tokenCount = tokenCount;
+    return true;
+}
+
+// Destroy token pool
+void JobServer::stop()
+{
+#ifdef Q_OS_WIN
+    if (m_semaphore != nullptr)
+    {
+        CloseHandle(static_cast<HANDLE>(m_semaphore));
+        m_semaphore = nullptr;
+    }
+#else
+    if (m_fifoFd >= 0)
+    {
+        ::close(m_fifoFd);
+        m_fifoFd = -1;
+        ::unlink(QFile::encodeName(m_authName).constData());
+    }
+#endif
+    m_tokenCount = 0;
+}
+
+// Take one token without blocking
+bool JobServer::tryAcquire(char& token)
+{
+    if (!isActive()) return false;
+
+#ifdef Q_OS_WIN
+    token = '+';
+    return WaitForSingleObject(static_cast<HANDLE>(m_semaphore), 0) == WAIT_OBJECT_0;
+#else
+    return ::read(m_fifoFd, &token, 1) == 1;
+#endif
+}
+
+// Return a token to the pool
+void JobServer::release(char token)
+{
+    if (!isActive()) return;
+
+#ifdef Q_OS_WIN
+    Q_UNUSED(token);
+    ReleaseSemaphore(static_cast<HANDLE>(m_semaphore), 1, nullptr);
+#else
+    // A single byte write to a FIFO is atomic and cannot block with free tokens < PIPE_BUF
+    if (::write(m_fifoFd, &token, 1) != 1)
+    {
+        qWarning("Failed to return jobserver token");
+    }
+#endif
+}
+
+// MAKEFLAGS understood by GNU make and Ninja jobserver clients
+QString JobServer::makeflags() const
+{
+    if (!isActive()) return "";
+
+#ifdef Q_OS_WIN
+    return QString("-j%1 --jobserver-auth=%2").arg(m_tokenCount).arg(m_authName);
+#else
+    return QString("-j%1 --jobserver-auth=fifo:%2").arg(m_tokenCount).arg(m_authName);
+#endif
+}
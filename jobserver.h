@@ -0,0 +1,67 @@
+#ifndef JOBSERVER_H
+#define JOBSERVER_H
+
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @brief GNU-make-compatible jobserver shared by all child builds of the executor
+ * @note Linux/macOS: named FIFO ("--jobserver-auth=fifo:PATH", GNU make >= 4.4, Ninja >= 1.13)
+ * @note Windows: named semaphore ("--jobserver-auth=NAME", GNU make and Ninja >= 1.13)
+ * @note The pool holds one token per core; the executor takes a token for the implicit job slot
+ *       of every child build, jobserver-aware children take further tokens on their own
+ */
+class JobServer
+{
+public:
+    JobServer() = default;
+    ~JobServer();
+
+    JobServer(const JobServer&) = delete;
+    JobServer& operator=(const JobServer&) = delete;
+
+    /**
+     * @brief Create the token pool
+     * @param tokenCount Number of tokens (total core budget)
+     * @param errorMsg Filled with a description when creation fails
+     * @return True = jobserver is active
+     */
+    bool start(int tokenCount, QString& errorMsg);
+
+    /**
+     * @brief Destroy the token pool (children still holding tokens are unaffected)
+     */
+    void stop();
+
+    bool isActive() const { return m_tokenCount > 0; }
+    int tokenCount() const { return m_tokenCount; }
+
+    /**
+     * @brief Take one token without blocking
+     * @param token Receives the token byte (must be handed back to release)
+     * @return True = token acquired
+     */
+    bool tryAcquire(char& token);
+
+    /**
+     * @brief Return a token to the pool
+     * @param token Token byte obtained by tryAcquire
+     */
+    void release(char token);
+
+    /**
+     * @brief MAKEFLAGS value advertising the jobserver to child builds
+     */
+    QString makeflags() const;
+
+private:
+    int      m_tokenCount = 0;
+    QString  m_authName;            // FIFO path (Unix) or semaphore name (Windows)
+#ifdef Q_OS_WIN
+    void*    m_semaphore = nullptr; // Semaphore HANDLE
+#else
+    int      m_fifoFd = -1;         // FIFO opened read/write and non-blocking
+#endif
+};
+
+#endif // JOBSERVER_H
@@ -0,0 +1,167 @@
+#include "logarchive.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+
+bool LogArchive::compressSegment(const QString& path, QString& errorMsg)
+{
+    QFile segment(path);
+    if (!segment.open(QIODevice::ReadOnly))
+    {
+        errorMsg = QString("Cannot read log segment %1: %2").arg(path, segment.errorString());
+        return false;
+    }
+    QByteArray compressed = gzip(segment.readAll());
+    segment.close();
+    if (compressed.isEmpty())
+    {
+        errorMsg = QString("Cannot compress log segment %1").arg(path);
+        return false;
+    }
+
+    // Written under a temporary name: a half-written .gz never replaces the segment
+    QSaveFile archive(path + ".gz");
+    if (!archive.open(QIODevice::WriteOnly) || archive.write(compressed) != compressed.size() || !archive.commit())
+    {
+        errorMsg = QString("Cannot write %1.gz: %2").arg(path, archive.errorString());
+        return false;
+    }
+    QFile::remove(path);
+    return true;
+}
+
+int LogArchive::enforceBudget(const QString& dir, const QString& nameFilter, qint64 budgetBytes, const QString& activePath)
+{
+    if (budgetBytes <= 0) return 0;
+
+    // Newest first: everything past the budget goes
+    QFileInfoList files = QDir(dir).entryInfoList(QStringList() << nameFilter, QDir::Files, QDir::Time);
+    QString activeFile = QFileInfo(activePath).absoluteFilePath();
+    qint64 total = 0;
+    int deleted = 0;
+    for (const QFileInfo& file : qAsConst(files))
+    {
+        total += file.size();
+        if (total <= budgetBytes || file.absoluteFilePath() == activeFile) continue;
+        if (QFile::remove(file.absoluteFilePath()))
+        {
+            total -= file.size();
+            deleted++;
+        }
+    }
+    return deleted;
+}
+
+// Extra field subfield holding the Adler-32 of the contents (big-endian, as in a zlib stream)
+static const char ADLER_SUBFIELD[2] = { 'E', 'Z' };
+
+// zlib stream from qCompress re-wrapped as gzip: same deflate data, different header and checksum
+QByteArray LogArchive::gzip(const QByteArray& data)
+{
+    // qCompress: 4-byte big-endian length, 2-byte zlib header, deflate data, 4-byte Adler-32
+    QByteArray zlib = qCompress(data, 6);
+    if (zlib.size() < 4 + 2 + 4) return QByteArray();
+
+    QByteArray result;
+    result.reserve(zlib.size() + 30);
+    // FLG.FEXTRA: XLEN 8 = one subfield (SI1 SI2, LEN 4, Adler-32)
+    const char header[12] = { '\x1f', '\x8b', 8, 4, 0, 0, 0, 0, 0, '\xff', 8, 0 };
+    result.append(header, sizeof(header));
+    result.append(ADLER_SUBFIELD, 2);
+    result.append("\x04\x00", 2);
+    result.append(zlib.constData() + zlib.size() - 4, 4);
+    result.append(zlib.constData() + 6, zlib.size() - 6 - 4);
+
+    quint32 trailer[2] = { crc32(data), quint32(data.size()) };
+    for (quint32 value : trailer)
+    {
+        for (int i = 0; i < 4; ++i) result.append(char((value >> (8 * i)) & 0xff));
+    }
+    return result;
+}
+
+// Reverses gzip(): the deflate data is wrapped in a zlib stream again
+bool LogArchive::gunzip(const QByteArray& member, QByteArray& data, QString& errorMsg)
+{
+    auto byteAt = [&member](int pos) { return quint8(member[pos]); };
+    auto littleEndian = [&byteAt](int pos, int bytes) {
+        quint32 value = 0;
+        for (int i = bytes - 1; i >= 0; --i) value = (value << 8) | byteAt(pos + i);
+        return value;
+    };
+
+    if (member.size() < 10 + 8 || byteAt(0) != 0x1f || byteAt(1) != 0x8b || byteAt(2) != 8)
+    {
+        errorMsg = "not a gzip file";
+        return false;
+    }
+
+    // Header: the Adler-32 subfield is required, name/comment/header CRC are skipped
+    quint8 flags = byteAt(3);
+    int pos = 10;
+    QByteArray adler;
+    if (flags & 0x04)
+    {
+        int extraEnd = pos + 2 + int(littleEndian(pos, 2));
+        pos += 2;
+        while (pos + 4 <= extraEnd && extraEnd <= member.size())
+        {
+            int length = int(littleEndian(pos + 2, 2));
+            if (member.mid(pos, 2) == QByteArray(ADLER_SUBFIELD, 2) && length == 4) adler = member.mid(pos + 4, 4);
+            pos += 4 + length;
+        }
+        pos = extraEnd;
+    }
+    if (flags & 0x08) pos = member.indexOf('\0', pos) + 1;
+    if (flags & 0x10) pos = member.indexOf('\0', pos) + 1;
+    if (flags & 0x02) pos += 2;
+    if (adler.size() != 4)
+    {
+        errorMsg = "compressed by another tool (decompress it with gzip first)";
+        return false;
+    }
+    if (pos <= 0 || pos > member.size() - 8)
+    {
+        errorMsg = "truncated gzip header";
+        return false;
+    }
+
+    // qUncompress: 4-byte big-endian length, zlib header, deflate data, Adler-32
+    quint32 expectedCrc = littleEndian(member.size() - 8, 4);
+    quint32 size = littleEndian(member.size() - 4, 4);
+    QByteArray zlib;
+    zlib.reserve(member.size() - pos + 2);
+    for (int shift = 24; shift >= 0; shift -= 8) zlib.append(char((size >> shift) & 0xff));
+    zlib.append("\x78\x9c", 2);
+    zlib.append(member.constData() + pos, member.size() - pos - 8);
+    zlib.append(adler);
+
+    data = qUncompress(zlib);
+    if (quint32(data.size()) != size || crc32(data) != expectedCrc)
+    {
+        data.clear();
+        errorMsg = "corrupt gzip data";
+        return false;
+    }
+    return true;
+}
+
+quint32 LogArchive::crc32(const QByteArray& data)
+{
+    static const QVector<quint32> table = [] {
+        QVector<quint32> values(256);
+        for (quint32 n = 0; n < 256; ++n)
+        {
+            quint32 c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            values[int(n)] = c;
+        }
+        return values;
+    }();
+
+    quint32 crc = 0xffffffffu;
+    for (char byte : data) crc = table[int((crc ^ quint8(byte)) & 0xff)] ^ (crc >> 8);
+    return crc ^ 0xffffffffu;
+}
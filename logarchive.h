@@ -0,0 +1,30 @@
+#ifndef LOGARCHIVE_H
+#define LOGARCHIVE_H
+
+#include <QByteArray>
+#include <QString>
+
+// Closed log segments: gzip compression and the disk budget of a log folder
+// All functions block; LogWriter runs them on the global thread pool
+class LogArchive
+{
+public:
+    // Compress a closed segment to <path>.gz and remove the original (false = original kept)
+    static bool compressSegment(const QString& path, QString& errorMsg);
+
+    // Delete the oldest files of dir matching nameFilter until they fit into budgetBytes
+    // The active segment is never deleted; returns the number of deleted files
+    static int enforceBudget(const QString& dir, const QString& nameFilter, qint64 budgetBytes, const QString& activePath);
+
+    // gzip member (RFC 1952) of data, readable by gzip/zcat/7-Zip (empty on failure)
+    // The Adler-32 of data travels in an extra header field, so gunzip() can hand the stream to qUncompress
+    static QByteArray gzip(const QByteArray& data);
+
+    // Contents of a member written by gzip() (false = other gzip writers, or the data is corrupt)
+    static bool gunzip(const QByteArray& member, QByteArray& data, QString& errorMsg);
+
+private:
+    static quint32 crc32(const QByteArray& data);
+};
+
+#endif // LOGARCHIVE_H
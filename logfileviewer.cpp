@@ -0,0 +1,829 @@
+#include "logfileviewer.h"
+#include "diagnostics.h"
+#include "logarchive.h"
+#include <QApplication>
+#include <QBrush>
+#include <QClipboard>
+#include <QComboBox>
+#include <QDesktopServices>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFontDatabase>
+#include <QGridLayout>
+#include <QHash>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QPushButton>
+#include <QShortcut>
+#include <QUrl>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+// Background threads publish progress at most this often
+static const int PUBLISH_INTERVAL_MS = 250;
+// A search stops collecting after this many matching lines
+static const int MAX_SEARCH_MATCHES = 1000000;
+// Longer lines are cut in the view (copying a line still gives all of it)
+static const int MAX_DISPLAY_BYTES = 4096;
+// Longer lines are not checked for diagnostics (same limit as ErrorScanner)
+static const int MAX_DIAGNOSTIC_LINE = 64 * 1024;
+
+// Next line of a buffer: returns its length without the line break, pos moves past the break
+static qint64 nextLine(const char* data, qint64 size, qint64& pos, const char*& line)
+{
+    line = data + pos;
+    const char* newline = static_cast<const char*>(memchr(line, '\n', size_t(size - pos)));
+    qint64 length = newline ? newline - line : size - pos;
+    pos += length + 1;
+    if (length > 0 && line[length - 1] == '\r') length--;
+    return length;
+}
+
+// ASCII case-insensitive search of a lower-case keyword
+static bool containsKeyword(const char* text, qint64 length, const char* keyword)
+{
+    const qint64 keywordLength = qint64(strlen(keyword));
+    for (qint64 i = 0; i + keywordLength <= length; ++i)
+    {
+        qint64 k = 0;
+        while (k < keywordLength && (text[i + k] | 0x20) == keyword[k]) ++k;
+        if (k == keywordLength) return true;
+    }
+    return false;
+}
+
+MappedLogFile::MappedLogFile(const QString& path)
+    : m_file(path)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_isValid(false)
+{
+    // Rotated segments are gzip members written by LogArchive
+    if (path.endsWith(".gz", Qt::CaseInsensitive))
+    {
+        if (!m_file.open(QIODevice::ReadOnly))
+        {
+            m_errorString = m_file.errorString();
+            return;
+        }
+        QByteArray member = m_file.readAll();
+        m_file.close();
+        if (!LogArchive::gunzip(member, m_contents, m_errorString)) return;
+        m_data = m_contents.isEmpty() ? nullptr : m_contents.constData();
+        m_size = m_contents.size();
+        m_isValid = true;
+        return;
+    }
+
+#ifdef Q_OS_WIN
+    // QFile::map() would hold the file without FILE_SHARE_DELETE, so rotating the viewed log would fail
+    HANDLE file = CreateFileW(reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(path).utf16()), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        m_errorString = qt_error_string(int(GetLastError()));
+        return;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        m_errorString = qt_error_string(int(GetLastError()));
+        CloseHandle(file);
+        return;
+    }
+
+    // An empty file cannot be mapped, but is a valid log without lines
+    m_size = size.QuadPart;
+    if (m_size > 0)
+    {
+        m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = m_mapping ? MapViewOfFile(static_cast<HANDLE>(m_mapping), FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr)
+        {
+            m_errorString = qt_error_string(int(GetLastError()));
+            m_size = 0;
+            CloseHandle(file);
+            return;
+        }
+        m_data = static_cast<const char*>(view);
+    }
+    // The mapping keeps its own reference to the file
+    CloseHandle(file);
+    m_isValid = true;
+#else
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        m_errorString = m_file.errorString();
+        return;
+    }
+
+    // An empty file cannot be mapped, but is a valid log without lines
+    m_size = m_file.size();
+    if (m_size > 0)
+    {
+        uchar* map = m_file.map(0, m_size);
+        if (map == nullptr)
+        {
+            m_errorString = m_file.errorString();
+            m_size = 0;
+            return;
+        }
+        m_data = reinterpret_cast<const char*>(map);
+    }
+    m_isValid = true;
+#endif
+}
+
+MappedLogFile::~MappedLogFile()
+{
+    if (!m_contents.isEmpty()) return;
+#ifdef Q_OS_WIN
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+#else
+    if (m_data) m_file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(m_data)));
+#endif
+}
+
+LogFileIndexer::LogFileIndexer(QSharedPointer<MappedLogFile> file, QObject* parent)
+    : QThread(parent)
+    , m_file(file)
+    , m_percent(0)
+{
+}
+
+LogFileIndexer::~LogFileIndexer()
+{
+    requestInterruption();
+    wait();
+}
+
+LogFileIndex LogFileIndexer::snapshot(int& percent) const
+{
+    QMutexLocker locker(&m_mutex);
+    percent = m_percent;
+    return m_snapshot;
+}
+
+void LogFileIndexer::publish(const LogFileIndex& index, int percent)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_snapshot = index;
+        m_percent = percent;
+    }
+    emit indexUpdated();
+}
+
+void LogFileIndexer::run()
+{
+    const char* data = m_file->data();
+    const qint64 size = m_file->size();
+
+    LogFileIndex index;
+    QHash<QByteArray, int> commandIds;
+    QByteArray job;             // Job of the record header on the previous line
+    bool isHeaderLine = false;
+    int recordFirstLine = 0;
+    int openRange = -1;         // Range of the command record being read
+    QElapsedTimer timer;
+    timer.start();
+
+    qint64 pos = 0;
+    while (pos < size)
+    {
+        if (isInterruptionRequested()) return;
+
+        if (index.lineCount % LogFileIndex::LINE_CHECKPOINT == 0) index.checkpoints.append(pos);
+        const char* line = nullptr;
+        qint64 length = nextLine(data, size, pos, line);
+        const int number = index.lineCount++;
+        QByteArray bytes = QByteArray::fromRawData(line, int(qMin<qint64>(length, INT_MAX)));
+
+        // Records of CommandExecutor::saveCommandLog(): "[INFO] [<time>] Job: <job>", "Command: <command>", output, "---"
+        bool wasHeaderLine = isHeaderLine;
+        isHeaderLine = false;
+        if (bytes.startsWith("[INFO] [") || bytes.startsWith("[ERROR] ["))
+        {
+            int jobPos = bytes.indexOf("] Job: ");
+            if (jobPos >= 0)
+            {
+                job = bytes.mid(jobPos + 7);
+                isHeaderLine = true;
+                recordFirstLine = number;
+                openRange = -1;
+            }
+        }
+        else if (wasHeaderLine && bytes.startsWith("Command: "))
+        {
+            QByteArray key = job + ": " + bytes.mid(9);
+            auto it = commandIds.constFind(key);
+            if (it == commandIds.constEnd())
+            {
+                it = commandIds.insert(key, index.commands.size());
+                index.commands << QString::fromUtf8(key);
+            }
+            LogFileIndex::CommandRange range;
+            range.command = it.value();
+            range.firstLine = recordFirstLine;
+            index.commandRanges.append(range);
+            openRange = index.commandRanges.size() - 1;
+        }
+        if (openRange >= 0)
+        {
+            index.commandRanges[openRange].lastLine = number;
+            if (bytes == "---") openRange = -1;
+        }
+
+        // Severity: error entries of the executor, then compiler/linker diagnostics
+        // (the cheap keyword test keeps the parser away from ordinary lines)
+        if (bytes.startsWith("[ERROR]"))
+        {
+            index.errorLines.append(number);
+        }
+        else if (length <= MAX_DIAGNOSTIC_LINE
+                 && (containsKeyword(line, length, "error") || containsKeyword(line, length, "warning")))
+        {
+            Diagnostic diagnostic;
+            if (DiagnosticParser::parse(QString::fromUtf8(line, int(length)), diagnostic))
+            {
+                if (diagnostic.severity == Diagnostic::Error)
+                {
+                    index.errorLines.append(number);
+                }
+                else
+                {
+                    index.warningLines.append(number);
+                }
+            }
+        }
+
+        if (timer.elapsed() >= PUBLISH_INTERVAL_MS)
+        {
+            publish(index, int(qMin<qint64>(99, pos * 100 / size)));
+            timer.restart();
+        }
+    }
+    publish(index, 100);
+}
+
+LogFileSearcher::LogFileSearcher(QSharedPointer<MappedLogFile> file, const QRegularExpression& expression, QObject* parent)
+    : QThread(parent)
+    , m_file(file)
+    , m_expression(expression)
+    , m_isComplete(false)
+{
+}
+
+LogFileSearcher::~LogFileSearcher()
+{
+    requestInterruption();
+    wait();
+}
+
+bool LogFileSearcher::takeMatches(QVector<int>& matches)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_isComplete) return false;
+    matches.swap(m_matches);
+    return true;
+}
+
+void LogFileSearcher::run()
+{
+    const char* data = m_file->data();
+    const qint64 size = m_file->size();
+    m_expression.optimize();
+
+    QVector<int> matches;
+    QElapsedTimer timer;
+    timer.start();
+    qint64 pos = 0;
+    for (int number = 0; pos < size && matches.size() < MAX_SEARCH_MATCHES; ++number)
+    {
+        if (isInterruptionRequested()) return;
+
+        const char* line = nullptr;
+        qint64 length = nextLine(data, size, pos, line);
+        if (m_expression.match(QString::fromUtf8(line, int(qMin<qint64>(length, INT_MAX)))).hasMatch())
+        {
+            matches.append(number);
+        }
+
+        if (timer.elapsed() >= PUBLISH_INTERVAL_MS)
+        {
+            emit searchProgress(int(qMin<qint64>(99, pos * 100 / size)));
+            timer.restart();
+        }
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_matches = matches;
+        m_isComplete = true;
+    }
+    emit searchFinished(matches.size());
+}
+
+LogFileModel::LogFileModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_indexer(nullptr)
+    , m_searcher(nullptr)
+    , m_commandFilter(-1)
+    , m_rowCount(0)
+{
+}
+
+LogFileModel::~LogFileModel()
+{
+    // The threads read the mapping: stop them before it goes
+    delete m_indexer;
+    delete m_searcher;
+}
+
+bool LogFileModel::open(const QString& path, QString& errorMsg)
+{
+    close();
+
+    QSharedPointer<MappedLogFile> file(new MappedLogFile(path));
+    if (!file->isValid())
+    {
+        errorMsg = QString("Cannot open log file %1: %2").arg(path, file->errorString());
+        return false;
+    }
+    m_file = file;
+    m_filePath = path;
+
+    m_indexer = new LogFileIndexer(m_file, this);
+    connect(m_indexer, &LogFileIndexer::indexUpdated, this, &LogFileModel::applyIndex);
+    m_indexer->start(QThread::LowPriority);
+    return true;
+}
+
+void LogFileModel::close()
+{
+    beginResetModel();
+    delete m_indexer;
+    m_indexer = nullptr;
+    delete m_searcher;
+    m_searcher = nullptr;
+    m_file.reset();
+    m_filePath.clear();
+    m_index = LogFileIndex();
+    m_matches.clear();
+    m_commandFilter = -1;
+    rebuildFilter();
+    m_rowCount = 0;
+    endResetModel();
+}
+
+// Lines and command records are only ever appended, so rows already shown keep their lines
+void LogFileModel::applyIndex()
+{
+    // Notifications of a closed file may still be queued
+    if (m_indexer == nullptr) return;
+
+    int percent = 0;
+    int commandCount = m_index.commands.size();
+    m_index = m_indexer->snapshot(percent);
+    rebuildFilter();
+
+    int rows = visibleRowCount();
+    if (rows > m_rowCount)
+    {
+        beginInsertRows(QModelIndex(), m_rowCount, rows - 1);
+        m_rowCount = rows;
+        endInsertRows();
+    }
+    if (m_index.commands.size() != commandCount) emit commandsChanged();
+    emit indexProgress(percent);
+}
+
+void LogFileModel::applyMatches(const QVector<int>& matches)
+{
+    m_matches = matches;
+    if (m_rowCount > 0) emit dataChanged(index(0), index(m_rowCount - 1), QVector<int>() << Qt::BackgroundRole);
+}
+
+void LogFileModel::rebuildFilter()
+{
+    m_filterFirst.clear();
+    m_filterLast.clear();
+    m_filterRowStart.clear();
+    if (m_commandFilter < 0) return;
+
+    int rows = 0;
+    for (const LogFileIndex::CommandRange& range : qAsConst(m_index.commandRanges))
+    {
+        if (range.command != m_commandFilter) continue;
+        m_filterFirst << range.firstLine;
+        m_filterLast << range.lastLine;
+        m_filterRowStart << rows;
+        rows += range.lastLine - range.firstLine + 1;
+    }
+    m_filterRowStart << rows;
+}
+
+int LogFileModel::visibleRowCount() const
+{
+    return m_commandFilter < 0 ? m_index.lineCount : m_filterRowStart.last();
+}
+
+void LogFileModel::setCommandFilter(int command)
+{
+    if (command >= m_index.commands.size()) command = -1;
+    if (command == m_commandFilter) return;
+
+    beginResetModel();
+    m_commandFilter = command;
+    rebuildFilter();
+    m_rowCount = visibleRowCount();
+    endResetModel();
+}
+
+int LogFileModel::lineAt(int row) const
+{
+    if (row < 0 || row >= m_rowCount) return -1;
+    if (m_commandFilter < 0) return row;
+
+    int range = int(std::upper_bound(m_filterRowStart.begin(), m_filterRowStart.end() - 1, row) - m_filterRowStart.begin()) - 1;
+    return m_filterFirst[range] + row - m_filterRowStart[range];
+}
+
+int LogFileModel::rowOf(int line) const
+{
+    if (line < 0) return -1;
+    if (m_commandFilter < 0) return line < m_rowCount ? line : -1;
+
+    // Ranges do not overlap, so their last lines ascend too
+    int range = int(std::lower_bound(m_filterLast.begin(), m_filterLast.end(), line) - m_filterLast.begin());
+    if (range >= m_filterLast.size()) return -1;
+    int row = m_filterRowStart[range] + qMax(0, line - m_filterFirst[range]);
+    return row < m_rowCount ? row : -1;
+}
+
+bool LogFileModel::isLineVisible(int line) const
+{
+    int row = rowOf(line);
+    return row >= 0 && lineAt(row) == line;
+}
+
+int LogFileModel::findIn(const QVector<int>& lines, int fromLine, bool forward) const
+{
+    if (forward)
+    {
+        for (auto it = std::upper_bound(lines.begin(), lines.end(), fromLine); it != lines.end(); ++it)
+        {
+            if (isLineVisible(*it)) return *it;
+        }
+    }
+    else
+    {
+        for (auto it = std::lower_bound(lines.begin(), lines.end(), fromLine); it != lines.begin();)
+        {
+            --it;
+            if (isLineVisible(*it)) return *it;
+        }
+    }
+    return -1;
+}
+
+int LogFileModel::findLine(Severity severity, int fromLine, bool forward) const
+{
+    if (severity == Error) return findIn(m_index.errorLines, fromLine, forward);
+    if (severity == Warning) return findIn(m_index.warningLines, fromLine, forward);
+    return -1;
+}
+
+int LogFileModel::findMatch(int fromLine, bool forward) const
+{
+    return findIn(m_matches, fromLine, forward);
+}
+
+void LogFileModel::search(const QRegularExpression& expression)
+{
+    delete m_searcher;
+    m_searcher = nullptr;
+    applyMatches(QVector<int>());
+    if (!m_file || expression.pattern().isEmpty() || !expression.isValid()) return;
+
+    LogFileSearcher* searcher = new LogFileSearcher(m_file, expression, this);
+    m_searcher = searcher;
+    connect(searcher, &LogFileSearcher::searchProgress, this, [this, searcher](int percent) {
+        if (searcher == m_searcher) emit searchProgress(percent);
+    });
+    connect(searcher, &LogFileSearcher::searchFinished, this, [this, searcher]() {
+        QVector<int> matches;
+        if (searcher != m_searcher || !searcher->takeMatches(matches)) return;
+        applyMatches(matches);
+        emit searchFinished(matches.size());
+    });
+    searcher->start(QThread::LowPriority);
+}
+
+LogFileModel::Severity LogFileModel::severityOf(int line) const
+{
+    if (std::binary_search(m_index.errorLines.begin(), m_index.errorLines.end(), line)) return Error;
+    if (std::binary_search(m_index.warningLines.begin(), m_index.warningLines.end(), line)) return Warning;
+    return Normal;
+}
+
+// Start of a line in the mapping: the nearest checkpoint, then at most LINE_CHECKPOINT - 1 line breaks
+const char* LogFileModel::linePointer(int line, qint64& length) const
+{
+    length = 0;
+    if (!m_file || line < 0 || line >= m_index.lineCount) return nullptr;
+
+    const char* data = m_file->data();
+    const qint64 size = m_file->size();
+    qint64 pos = m_index.checkpoints[line / LogFileIndex::LINE_CHECKPOINT];
+    const char* start = nullptr;
+    for (int skip = line % LogFileIndex::LINE_CHECKPOINT; skip > 0; --skip) nextLine(data, size, pos, start);
+    length = nextLine(data, size, pos, start);
+    return start;
+}
+
+QString LogFileModel::lineText(int line) const
+{
+    qint64 length = 0;
+    const char* start = linePointer(line, length);
+    return start ? QString::fromUtf8(start, int(qMin<qint64>(length, INT_MAX))) : QString();
+}
+
+QString LogFileModel::text(const QList<int>& rows) const
+{
+    QStringList lines;
+    for (int row : rows)
+    {
+        if (row >= 0 && row < m_rowCount) lines << lineText(lineAt(row));
+    }
+    return lines.join('\n');
+}
+
+int LogFileModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+QVariant LogFileModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rowCount) return QVariant();
+
+    int line = lineAt(index.row());
+    if (role == Qt::DisplayRole)
+    {
+        qint64 length = 0;
+        const char* start = linePointer(line, length);
+        if (start == nullptr) return QVariant();
+        if (length <= MAX_DISPLAY_BYTES) return QString::fromUtf8(start, int(length));
+        return QString::fromUtf8(start, MAX_DISPLAY_BYTES) + QString(" ... [%1 bytes]").arg(length);
+    }
+    // Color coding: red = error, dark yellow = warning, black = normal; search matches highlighted
+    if (role == Qt::ForegroundRole)
+    {
+        Severity severity = severityOf(line);
+        return QBrush(severity == Error ? Qt::red : severity == Warning ? Qt::darkYellow : Qt::black);
+    }
+    if (role == Qt::BackgroundRole && std::binary_search(m_matches.begin(), m_matches.end(), line))
+    {
+        return QBrush(QColor(255, 240, 150));
+    }
+    return QVariant();
+}
+
+LogFileViewer::LogFileViewer(QWidget* parent)
+    : QDialog(parent)
+    , m_model(new LogFileModel(this))
+    , m_indexPercent(0)
+    , m_searchPercent(-1)
+{
+    // 1. UI Layout initialization
+    setWindowTitle("Log Viewer");
+    setWindowFlags(windowFlags() | Qt::WindowMinMaxButtonsHint);
+    resize(1100, 700);
+    QGridLayout* layout = new QGridLayout(this);
+
+    // Enter in the search field must not trigger a button
+    auto createButton = [this](const QString& text) {
+        QPushButton* button = new QPushButton(text, this);
+        button->setAutoDefault(false);
+        return button;
+    };
+    QPushButton* btnOpen = createButton("Open...");
+    QPushButton* btnReload = createButton("Reload");
+    QPushButton* btnExternal = createButton("Open Externally");
+    QPushButton* btnPrevError = createButton("Previous Error");
+    QPushButton* btnNextError = createButton("Next Error");
+    QPushButton* btnNextWarning = createButton("Next Warning");
+    QPushButton* btnPrevMatch = createButton("Previous Match");
+    QPushButton* btnNextMatch = createButton("Next Match");
+
+    m_labPath = new QLabel(this);
+    m_labPath->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    m_cbCommand = new QComboBox(this);
+    m_cbCommand->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
+    m_cbCommand->setMinimumContentsLength(40);
+    m_cbCommand->addItem("All commands");
+    m_leSearch = new QLineEdit(this);
+    m_leSearch->setPlaceholderText("Regular expression, case-insensitive (Enter = search the whole file)");
+    m_labStatus = new QLabel(this);
+
+    // Same virtualization as the live log: only visible rows are decoded and painted
+    m_view = new QListView(this);
+    m_view->setModel(m_model);
+    m_view->setUniformItemSizes(true);
+    m_view->setLayoutMode(QListView::Batched);
+    m_view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_view->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    layout->addWidget(new QLabel("File:"), 0, 0);
+    layout->addWidget(m_labPath, 0, 1, 1, 4);
+    layout->addWidget(btnOpen, 0, 5);
+    layout->addWidget(btnReload, 0, 6);
+    layout->addWidget(btnExternal, 0, 7);
+    layout->addWidget(new QLabel("Command:"), 1, 0);
+    layout->addWidget(m_cbCommand, 1, 1, 1, 4);
+    layout->addWidget(btnPrevError, 1, 5);
+    layout->addWidget(btnNextError, 1, 6);
+    layout->addWidget(btnNextWarning, 1, 7);
+    layout->addWidget(new QLabel("Search:"), 2, 0);
+    layout->addWidget(m_leSearch, 2, 1, 1, 5);
+    layout->addWidget(btnPrevMatch, 2, 6);
+    layout->addWidget(btnNextMatch, 2, 7);
+    layout->addWidget(m_view, 3, 0, 1, 8);
+    layout->addWidget(m_labStatus, 4, 0, 1, 8);
+    layout->setColumnStretch(1, 1);
+    layout->setRowStretch(3, 1);
+
+    // 2. Signal-slot connections
+    connect(btnOpen, &QPushButton::clicked, this, [=]() {
+        QString path = QFileDialog::getOpenFileName(this, "Open Log File", QFileInfo(m_model->filePath()).absolutePath(),
+                                                    "Log files (*.log *.log.gz);;All files (*)");
+        if (!path.isEmpty()) openFile(path);
+    });
+    connect(btnReload, &QPushButton::clicked, this, [=]() {
+        if (!m_model->filePath().isEmpty()) openFile(m_model->filePath());
+    });
+    connect(btnExternal, &QPushButton::clicked, this, [=]() {
+        if (!m_model->filePath().isEmpty()) QDesktopServices::openUrl(QUrl::fromLocalFile(m_model->filePath()));
+    });
+    connect(m_cbCommand, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [=](int index) {
+        // Keep the current line in view when it is part of the new selection
+        int line = currentLine();
+        m_model->setCommandFilter(index - 1);
+        int row = m_model->rowOf(line);
+        if (row >= 0) m_view->scrollTo(m_model->index(row), QAbstractItemView::PositionAtCenter);
+        updateStatus();
+    });
+    connect(btnPrevError, &QPushButton::clicked, this, [=]() { findSeverity(LogFileModel::Error, false); });
+    connect(btnNextError, &QPushButton::clicked, this, [=]() { findSeverity(LogFileModel::Error, true); });
+    connect(btnNextWarning, &QPushButton::clicked, this, [=]() { findSeverity(LogFileModel::Warning, true); });
+    connect(btnPrevMatch, &QPushButton::clicked, this, [=]() { findMatch(false); });
+    connect(btnNextMatch, &QPushButton::clicked, this, [=]() { findMatch(true); });
+    connect(m_leSearch, &QLineEdit::returnPressed, this, &LogFileViewer::startSearch);
+
+    connect(m_model, &LogFileModel::indexProgress, this, [=](int percent) {
+        m_indexPercent = percent;
+        updateStatus();
+    });
+    connect(m_model, &LogFileModel::commandsChanged, this, &LogFileViewer::updateCommands);
+    connect(m_model, &LogFileModel::searchProgress, this, [=](int percent) {
+        m_searchPercent = percent;
+        updateStatus();
+    });
+    connect(m_model, &LogFileModel::searchFinished, this, [=](int matchCount) {
+        m_searchPercent = -1;
+        if (matchCount > 0) findMatch(true);
+        m_notice = matchCount >= MAX_SEARCH_MATCHES ? QString("First %1 matching lines").arg(matchCount)
+                                                    : QString("%1 matching line(s)").arg(matchCount);
+        updateStatus();
+    });
+
+    // 3. Shortcuts: F3 = matches, F8 = errors (Shift = backwards), Ctrl+C = selected lines
+    QShortcut* nextMatch = new QShortcut(QKeySequence(Qt::Key_F3), this);
+    connect(nextMatch, &QShortcut::activated, this, [=]() { findMatch(true); });
+    QShortcut* prevMatch = new QShortcut(QKeySequence(Qt::SHIFT | Qt::Key_F3), this);
+    connect(prevMatch, &QShortcut::activated, this, [=]() { findMatch(false); });
+    QShortcut* nextError = new QShortcut(QKeySequence(Qt::Key_F8), this);
+    connect(nextError, &QShortcut::activated, this, [=]() { findSeverity(LogFileModel::Error, true); });
+    QShortcut* prevError = new QShortcut(QKeySequence(Qt::SHIFT | Qt::Key_F8), this);
+    connect(prevError, &QShortcut::activated, this, [=]() { findSeverity(LogFileModel::Error, false); });
+    QShortcut* copy = new QShortcut(QKeySequence::Copy, m_view);
+    copy->setContext(Qt::WidgetShortcut);
+    connect(copy, &QShortcut::activated, this, [=]() {
+        QList<int> rows;
+        const QModelIndexList selected = m_view->selectionModel()->selectedIndexes();
+        for (const QModelIndex& index : selected) rows << index.row();
+        std::sort(rows.begin(), rows.end());
+        QApplication::clipboard()->setText(m_model->text(rows));
+    });
+
+    updateStatus();
+}
+
+bool LogFileViewer::openFile(const QString& path)
+{
+    // Commands are re-read from the new index
+    m_cbCommand->blockSignals(true);
+    m_cbCommand->clear();
+    m_cbCommand->addItem("All commands");
+    m_cbCommand->blockSignals(false);
+
+    m_indexPercent = 0;
+    m_searchPercent = -1;
+    m_notice.clear();
+    m_labPath->setText(QDir::toNativeSeparators(path));
+
+    QString errorMsg;
+    bool isOpened = m_model->open(path, errorMsg);
+    if (!isOpened) m_notice = errorMsg;
+    updateStatus();
+    return isOpened;
+}
+
+int LogFileViewer::currentLine() const
+{
+    QModelIndex index = m_view->currentIndex();
+    return index.isValid() ? m_model->lineAt(index.row()) : -1;
+}
+
+void LogFileViewer::jumpTo(int line, const QString& notFound)
+{
+    int row = m_model->rowOf(line);
+    if (line < 0 || row < 0)
+    {
+        m_notice = notFound;
+        updateStatus();
+        return;
+    }
+
+    QModelIndex index = m_model->index(row);
+    m_view->setCurrentIndex(index);
+    m_view->scrollTo(index, QAbstractItemView::PositionAtCenter);
+    m_notice = QString("Line %1").arg(line + 1);
+    updateStatus();
+}
+
+void LogFileViewer::findSeverity(LogFileModel::Severity severity, bool forward)
+{
+    // Without a current line, search from the start (forward) or the end (backward)
+    int line = currentLine();
+    if (line < 0 && !forward) line = m_model->lineCount();
+    jumpTo(m_model->findLine(severity, line, forward), severity == LogFileModel::Error ? "No more errors" : "No more warnings");
+}
+
+void LogFileViewer::findMatch(bool forward)
+{
+    int line = currentLine();
+    if (line < 0 && !forward) line = m_model->lineCount();
+    jumpTo(m_model->findMatch(line, forward), m_model->matchCount() > 0 ? "No more matches" : "No matches");
+}
+
+void LogFileViewer::startSearch()
+{
+    QRegularExpression expression(m_leSearch->text(), QRegularExpression::CaseInsensitiveOption);
+    if (!expression.isValid())
+    {
+        m_notice = "Invalid expression: " + expression.errorString();
+        updateStatus();
+        return;
+    }
+
+    m_notice.clear();
+    m_searchPercent = m_leSearch->text().isEmpty() ? -1 : 0;
+    m_model->search(expression);
+    updateStatus();
+}
+
+void LogFileViewer::updateCommands()
+{
+    // Commands only ever get appended while indexing runs
+    const QStringList& commands = m_model->commands();
+    for (int i = m_cbCommand->count() - 1; i < commands.size(); ++i)
+    {
+        QString text = commands[i].size() > 160 ? commands[i].left(157) + "..." : commands[i];
+        m_cbCommand->addItem(text);
+        m_cbCommand->setItemData(m_cbCommand->count() - 1, commands[i], Qt::ToolTipRole);
+    }
+}
+
+void LogFileViewer::updateStatus()
+{
+    QStringList parts;
+    parts << QString("%1 lines, %2 error(s), %3 warning(s)")
+                 .arg(m_model->lineCount()).arg(m_model->errorCount()).arg(m_model->warningCount());
+    if (m_model->commandFilter() >= 0) parts << QString("%1 lines of the selected command").arg(m_model->rowCount());
+    if (!m_model->filePath().isEmpty() && m_indexPercent < 100) parts << QString("Indexing %1%").arg(m_indexPercent);
+    if (m_searchPercent >= 0) parts << QString("Searching %1%").arg(m_searchPercent);
+    if (!m_notice.isEmpty()) parts << m_notice;
+    m_labStatus->setText(parts.join("  |  "));
+}
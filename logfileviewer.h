@@ -0,0 +1,228 @@
+#ifndef LOGFILEVIEWER_H
+#define LOGFILEVIEWER_H
+
+#include <QAbstractListModel>
+#include <QDialog>
+#include <QFile>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QListView;
+
+// Read-only memory mapping of a log file (the whole file, as it was when mapped)
+// Shared by the model and its background threads, so the mapping outlives whoever finishes last
+// Compressed segments (*.NNN.log.gz) are decompressed into memory instead; on Windows the mapping
+// does not keep LogWriter from renaming the active log when it rotates
+class MappedLogFile
+{
+public:
+    explicit MappedLogFile(const QString& path);
+    ~MappedLogFile();
+
+    bool isValid() const { return m_isValid; }
+    QString errorString() const { return m_errorString; }
+    const char* data() const { return m_data; }
+    qint64 size() const { return m_size; }
+
+private:
+    QFile       m_file;
+    QByteArray  m_contents;     // Decompressed segment (empty = m_data is a mapping)
+#ifdef Q_OS_WIN
+    void*       m_mapping = nullptr; // File mapping HANDLE
+#endif
+    const char* m_data;
+    qint64      m_size;
+    bool        m_isValid;
+    QString     m_errorString;
+};
+
+// Line offsets, severities and command records of a log file
+// Only every LINE_CHECKPOINT-th line offset is stored; lines in between are found with memchr
+struct LogFileIndex
+{
+    static const int LINE_CHECKPOINT = 64;
+
+    struct CommandRange
+    {
+        int command = 0;    // Index into commands
+        int firstLine = 0;  // Record header ("[INFO] [...] Job: ...")
+        int lastLine = 0;   // Record end ("---")
+    };
+
+    QVector<qint64>       checkpoints;   // Offset of line k * LINE_CHECKPOINT
+    int                   lineCount = 0;
+    QVector<int>          errorLines;    // Ascending
+    QVector<int>          warningLines;  // Ascending
+    QStringList           commands;      // "<job>: <command>", each once
+    QVector<CommandRange> commandRanges; // Ascending by line
+};
+
+// Builds the index of a mapped log file; snapshots are published while it runs
+class LogFileIndexer : public QThread
+{
+    Q_OBJECT
+public:
+    explicit LogFileIndexer(QSharedPointer<MappedLogFile> file, QObject* parent = nullptr);
+    ~LogFileIndexer() override;
+
+    // Index so far and how much of the file it covers (100 = complete)
+    LogFileIndex snapshot(int& percent) const;
+
+signals:
+    // A new snapshot is available
+    void indexUpdated();
+
+protected:
+    void run() override;
+
+private:
+    void publish(const LogFileIndex& index, int percent);
+
+    QSharedPointer<MappedLogFile> m_file;
+    mutable QMutex                m_mutex;
+    LogFileIndex                  m_snapshot;
+    int                           m_percent;
+};
+
+// Regex search over every line of a mapped log file (lines are decoded one at a time)
+class LogFileSearcher : public QThread
+{
+    Q_OBJECT
+public:
+    LogFileSearcher(QSharedPointer<MappedLogFile> file, const QRegularExpression& expression, QObject* parent = nullptr);
+    ~LogFileSearcher() override;
+
+    // Matching lines (ascending); false = search still running
+    bool takeMatches(QVector<int>& matches);
+
+signals:
+    void searchProgress(int percent);
+    void searchFinished(int matchCount);
+
+protected:
+    void run() override;
+
+private:
+    QSharedPointer<MappedLogFile> m_file;
+    QRegularExpression            m_expression;
+    mutable QMutex                m_mutex;
+    QVector<int>                  m_matches;
+    bool                          m_isComplete;
+};
+
+// Lines of a memory-mapped log file; text is decoded only for the rows a view asks for
+// Rows are all lines, or only the lines of one command's records when a command filter is set
+class LogFileModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Severity
+    {
+        Normal,
+        Warning,
+        Error,
+    };
+
+    explicit LogFileModel(QObject* parent = nullptr);
+    ~LogFileModel() override;
+
+    // Map the file and start indexing it in the background (false = errorMsg set, model empty)
+    bool open(const QString& path, QString& errorMsg);
+    void close();
+    QString filePath() const { return m_filePath; }
+
+    int lineCount() const { return m_index.lineCount; }
+    const QStringList& commands() const { return m_index.commands; }
+    int errorCount() const { return m_index.errorLines.size(); }
+    int warningCount() const { return m_index.warningLines.size(); }
+
+    // -1 = all lines
+    void setCommandFilter(int command);
+    int commandFilter() const { return m_commandFilter; }
+
+    int lineAt(int row) const;
+    // Row showing line, or the next row after it (-1 = none)
+    int rowOf(int line) const;
+
+    // Next/previous line with that severity (or search match) after/before fromLine among the rows (-1 = none)
+    int findLine(Severity severity, int fromLine, bool forward) const;
+    int findMatch(int fromLine, bool forward) const;
+
+    // Search the whole file in the background (results replace the previous search)
+    void search(const QRegularExpression& expression);
+    int matchCount() const { return m_matches.size(); }
+
+    QString lineText(int line) const;
+    // Plain text of the given rows, one per line
+    QString text(const QList<int>& rows) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+signals:
+    void indexProgress(int percent);
+    void commandsChanged();
+    void searchProgress(int percent);
+    void searchFinished(int matchCount);
+
+private:
+    void applyIndex();
+    void applyMatches(const QVector<int>& matches);
+    void rebuildFilter();
+    int visibleRowCount() const;
+    bool isLineVisible(int line) const;
+    int findIn(const QVector<int>& lines, int fromLine, bool forward) const;
+    Severity severityOf(int line) const;
+    const char* linePointer(int line, qint64& length) const;
+
+    QSharedPointer<MappedLogFile> m_file;
+    QString           m_filePath;
+    LogFileIndexer*   m_indexer;
+    LogFileSearcher*  m_searcher;
+    LogFileIndex      m_index;          // Latest snapshot of the indexer
+    QVector<int>      m_matches;        // Lines of the last search
+    int               m_commandFilter;
+    QVector<int>      m_filterFirst;    // Visible ranges when filtered: first line
+    QVector<int>      m_filterLast;     // ... last line
+    QVector<int>      m_filterRowStart; // ... first row (prefix sums, plus the total row count)
+    int               m_rowCount;
+};
+
+// In-app viewer for execution logs of any size: jump to errors, regex search, filter by command
+class LogFileViewer : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit LogFileViewer(QWidget* parent = nullptr);
+
+    bool openFile(const QString& path);
+
+private:
+    void jumpTo(int line, const QString& notFound);
+    // Line of the current row (-1 = none)
+    int currentLine() const;
+    void findSeverity(LogFileModel::Severity severity, bool forward);
+    void findMatch(bool forward);
+    void startSearch();
+    void updateCommands();
+    void updateStatus();
+
+    LogFileModel* m_model;
+    QListView*    m_view;
+    QLabel*       m_labPath;
+    QComboBox*    m_cbCommand;
+    QLineEdit*    m_leSearch;
+    QLabel*       m_labStatus;
+    int           m_indexPercent;
+    int           m_searchPercent;  // -1 = no search running
+    QString       m_notice;         // Last jump/search message
+};
+
+#endif // LOGFILEVIEWER_H
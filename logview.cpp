@@ -0,0 +1,150 @@
+#include "logview.h"
+#include <QApplication>
+#include <QBrush>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QScrollBar>
+#include <algorithm>
+
+LogLineModel::LogLineModel(int capacity, QObject* parent)
+    : QAbstractListModel(parent)
+    , m_capacity(qMax(1, capacity))
+    , m_start(0)
+    , m_count(0)
+{
+}
+
+void LogLineModel::appendText(const QString& text, bool isError)
+{
+    QStringList lines = text.split('\n', Qt::SkipEmptyParts);
+    for (QString& line : lines)
+    {
+        if (line.endsWith('\r')) line.chop(1);
+    }
+    lines.removeAll(QString());
+    if (lines.isEmpty()) return;
+
+    // More lines than the ring holds: keep the newest ones only
+    if (lines.size() >= m_capacity)
+    {
+        beginResetModel();
+        m_lines.clear();
+        m_start = 0;
+        m_count = 0;
+        for (int i = lines.size() - m_capacity; i < lines.size(); ++i)
+        {
+            LogLine line;
+            line.text = lines[i];
+            line.isError = isError;
+            m_lines.append(line);
+        }
+        m_count = m_lines.size();
+        endResetModel();
+        return;
+    }
+
+    // Drop the oldest rows to make room (their ring entries are overwritten below)
+    int overflow = m_count + lines.size() - m_capacity;
+    if (overflow > 0)
+    {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        m_start = (m_start + overflow) % m_capacity;
+        m_count -= overflow;
+        endRemoveRows();
+    }
+
+    // While the ring is still growing, m_start + m_count == m_lines.size()
+    beginInsertRows(QModelIndex(), m_count, m_count + lines.size() - 1);
+    for (const QString& text : qAsConst(lines))
+    {
+        LogLine line;
+        line.text = text;
+        line.isError = isError;
+        if (m_lines.size() < m_capacity)
+        {
+            m_lines.append(line);
+        }
+        else
+        {
+            m_lines[(m_start + m_count) % m_capacity] = line;
+        }
+        m_count++;
+    }
+    endInsertRows();
+}
+
+void LogLineModel::clear()
+{
+    beginResetModel();
+    m_lines.clear();
+    m_start = 0;
+    m_count = 0;
+    endResetModel();
+}
+
+QString LogLineModel::text(const QList<int>& rows) const
+{
+    QStringList lines;
+    for (int row : rows)
+    {
+        if (row >= 0 && row < m_count) lines << lineAt(row).text;
+    }
+    return lines.join('\n');
+}
+
+int LogLineModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_count;
+}
+
+QVariant LogLineModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_count) return QVariant();
+
+    const LogLine& line = lineAt(index.row());
+    if (role == Qt::DisplayRole) return line.text;
+    // Color coding: red = error, black = normal
+    if (role == Qt::ForegroundRole) return QBrush(line.isError ? Qt::red : Qt::black);
+    return QVariant();
+}
+
+LogView::LogView(QWidget* parent)
+    : QListView(parent)
+    , m_model(new LogLineModel(1000000, this))
+{
+    setModel(m_model);
+    // Every row has the height of the first one: scrolling and layout stay O(1)
+    setUniformItemSizes(true);
+    setLayoutMode(QListView::Batched);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setSelectionMode(QAbstractItemView::ExtendedSelection);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+}
+
+void LogView::appendLog(const QString& text, bool isError)
+{
+    // Follow new lines only while the user looks at the end of the log
+    QScrollBar* scrollBar = verticalScrollBar();
+    bool isAtBottom = scrollBar->value() >= scrollBar->maximum();
+    m_model->appendText(text, isError);
+    if (isAtBottom) scrollToBottom();
+}
+
+void LogView::clearLog()
+{
+    m_model->clear();
+}
+
+void LogView::keyPressEvent(QKeyEvent* event)
+{
+    if (event->matches(QKeySequence::Copy))
+    {
+        QList<int> rows;
+        const QModelIndexList selected = selectionModel()->selectedIndexes();
+        for (const QModelIndex& index : selected) rows << index.row();
+        std::sort(rows.begin(), rows.end());
+        QApplication::clipboard()->setText(m_model->text(rows));
+        return;
+    }
+    QListView::keyPressEvent(event);
+}
@@ -0,0 +1,60 @@
+#ifndef LOGVIEW_H
+#define LOGVIEW_H
+
+#include <QAbstractListModel>
+#include <QListView>
+#include <QString>
+#include <QVector>
+
+// Log lines in a fixed-capacity ring: appending past the capacity drops the oldest lines in O(1)
+class LogLineModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    explicit LogLineModel(int capacity = 1000000, QObject* parent = nullptr);
+
+    // Append text (split into lines, empty lines skipped) with one severity for all of its lines
+    void appendText(const QString& text, bool isError);
+    void clear();
+
+    int capacity() const { return m_capacity; }
+    // Plain text of the given rows, one per line
+    QString text(const QList<int>& rows) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+private:
+    struct LogLine
+    {
+        QString text;
+        bool    isError = false;
+    };
+
+    const LogLine& lineAt(int row) const { return m_lines[(m_start + row) % m_lines.size()]; }
+
+    QVector<LogLine> m_lines;   // Grows up to m_capacity, then wraps around
+    int m_capacity;
+    int m_start;                // Physical index of row 0
+    int m_count;                // Rows in the model
+};
+
+// Virtualized log view: only visible rows are laid out and painted (uniform row height),
+// follows new lines while scrolled to the bottom, Ctrl+C copies the selected lines
+class LogView : public QListView
+{
+    Q_OBJECT
+public:
+    explicit LogView(QWidget* parent = nullptr);
+
+    void appendLog(const QString& text, bool isError);
+    void clearLog();
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override;
+
+private:
+    LogLineModel* m_model;
+};
+
+#endif // LOGVIEW_H
@@ -0,0 +1,252 @@
+#include "logwriter.h"
+#include "logarchive.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QThreadPool>
+
+// Queued records before write() has to wait for the writer (power of two)
+static const int QUEUE_CAPACITY = 4096;
+// Encoded bytes collected before they are written
+static const int BUFFER_LIMIT = 1024 * 1024;
+// Buffered data reaches the file after this much idle time
+static const int IDLE_FLUSH_MS = 500;
+// A failed rotation (file held open elsewhere) is retried after this long at the latest
+static const int ROTATE_RETRY_MS = 60 * 1000;
+
+LogWriter::LogWriter(QObject* parent)
+    : QThread(parent)
+    , m_ring(QUEUE_CAPACITY, nullptr)
+    , m_head(0)
+    , m_tail(0)
+{
+    m_buffer.reserve(BUFFER_LIMIT + 64 * 1024);
+    start(QThread::LowPriority);
+}
+
+LogWriter::~LogWriter()
+{
+    if (isRunning())
+    {
+        Record* record = new Record;
+        record->kind = Record::Stop;
+        push(record);
+        wait();
+    }
+
+    // Records queued after the thread ended are dropped
+    while (Record* record = pop()) delete record;
+}
+
+void LogWriter::write(const QString& filePath, const QString& text)
+{
+    Part part;
+    part.text = text;
+    write(filePath, QVector<Part>() << part);
+}
+
+void LogWriter::write(const QString& filePath, const QVector<Part>& parts)
+{
+    Record* record = new Record;
+    record->filePath = filePath;
+    record->parts = parts;
+    push(record);
+}
+
+void LogWriter::flush(bool wait)
+{
+    Record* record = new Record;
+    record->kind = Record::Flush;
+    QSemaphore done;
+    if (wait) record->done = &done;
+    push(record);
+    if (wait) done.acquire();
+}
+
+void LogWriter::setRotation(qint64 maxSegmentBytes, qint64 budgetBytes, const QString& nameFilter, const QString& activePath)
+{
+    Record* record = new Record;
+    record->kind = Record::Configure;
+    record->filePath = activePath;
+    record->maxSegmentBytes = maxSegmentBytes;
+    record->budgetBytes = budgetBytes;
+    record->nameFilter = nameFilter;
+    push(record);
+}
+
+// Producer side: the ring is full only when the disk cannot keep up
+void LogWriter::push(Record* record)
+{
+    quint64 head = m_head.load(std::memory_order_relaxed);
+    while (head - m_tail.load(std::memory_order_acquire) >= quint64(QUEUE_CAPACITY))
+    {
+        QThread::yieldCurrentThread();
+    }
+    m_ring[int(head & (QUEUE_CAPACITY - 1))] = record;
+    m_head.store(head + 1, std::memory_order_release);
+    m_pending.release();
+}
+
+// Consumer side
+LogWriter::Record* LogWriter::pop()
+{
+    quint64 tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) return nullptr;
+    Record* record = m_ring[int(tail & (QUEUE_CAPACITY - 1))];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return record;
+}
+
+void LogWriter::run()
+{
+    forever
+    {
+        if (!m_pending.tryAcquire(1, IDLE_FLUSH_MS))
+        {
+            writeBuffer();
+            continue;
+        }
+
+        Record* record = pop();
+        if (record == nullptr) continue;
+
+        switch (record->kind)
+        {
+        case Record::Write:
+            writeRecord(*record);
+            break;
+        case Record::Flush:
+            writeBuffer();
+            if (record->done) record->done->release();
+            break;
+        case Record::Configure:
+            m_maxSegmentBytes = record->maxSegmentBytes;
+            m_budgetBytes = record->budgetBytes;
+            m_nameFilter = record->nameFilter;
+            if (!m_file.isOpen()) m_file.setFileName(record->filePath);
+            startRetention(QString());
+            break;
+        case Record::Stop:
+            writeBuffer();
+            m_file.close();
+            delete record;
+            return;
+        }
+        delete record;
+    }
+}
+
+void LogWriter::writeRecord(const Record& record)
+{
+    if (m_file.fileName() != record.filePath || !m_file.isOpen())
+    {
+        writeBuffer();
+        m_file.close();
+        if (m_file.fileName() != record.filePath) m_rotateRetryBytes = 0;
+        m_file.setFileName(record.filePath);
+        if (!m_file.open(QIODevice::Append | QIODevice::Text))
+        {
+            qWarning() << "Failed to open log file:" << m_file.errorString();
+            emit writeFailed("Failed to open log file: " + m_file.errorString());
+            return;
+        }
+        m_fileBytes = m_file.size();
+    }
+
+    auto append = [this](const QString& text) {
+        m_buffer += text.toUtf8();
+        if (m_buffer.size() >= BUFFER_LIMIT) writeBuffer();
+    };
+    for (const Part& part : record.parts)
+    {
+        if (part.isCapture)
+        {
+            part.capture.writeTo(append);
+        }
+        else
+        {
+            append(part.text);
+        }
+    }
+
+    // Entries are never split across segments
+    qint64 size = m_fileBytes + m_buffer.size();
+    if (m_maxSegmentBytes <= 0 || size < m_maxSegmentBytes) return;
+    // After a failed rotation: retry once another segment was written or the retry interval elapsed
+    if (m_rotateRetryBytes > 0 && size < m_rotateRetryBytes && m_rotateRetryTimer.elapsed() < ROTATE_RETRY_MS) return;
+    rotate();
+}
+
+// Close the full active file and archive it; the next entry reopens the active path empty
+void LogWriter::rotate()
+{
+    writeBuffer();
+    QString activePath = m_file.fileName();
+    m_file.close();
+    m_fileBytes = 0;
+
+    // First free number: <name>.001.log, <name>.002.log, ... (compressed ones count too)
+    QFileInfo active(activePath);
+    QString segmentPath;
+    for (int number = 1; ; ++number)
+    {
+        segmentPath = QString("%1/%2.%3.%4").arg(active.path(), active.completeBaseName())
+                          .arg(number, 3, 10, QChar('0')).arg(active.suffix());
+        if (!QFile::exists(segmentPath) && !QFile::exists(segmentPath + ".gz")) break;
+    }
+
+    if (!QFile::rename(activePath, segmentPath))
+    {
+        // Keep appending to the oversized file rather than losing entries; report once until a rotation succeeds
+        if (m_rotateRetryBytes == 0)
+        {
+            emit writeFailed(QString("Failed to rotate log file %1 (retrying later)").arg(activePath));
+        }
+        m_rotateRetryBytes = QFileInfo(activePath).size() + m_maxSegmentBytes;
+        m_rotateRetryTimer.start();
+        return;
+    }
+    m_rotateRetryBytes = 0;
+    startRetention(segmentPath);
+}
+
+// Compression and budget run on the thread pool: the writer keeps draining the queue meanwhile
+void LogWriter::startRetention(const QString& segmentPath)
+{
+    QString activePath = m_file.fileName();
+    QString nameFilter = m_nameFilter;
+    qint64 budgetBytes = m_budgetBytes;
+    if (activePath.isEmpty() || (segmentPath.isEmpty() && budgetBytes <= 0)) return;
+
+    QThreadPool::globalInstance()->start([segmentPath, activePath, nameFilter, budgetBytes]() {
+        QString errorMsg;
+        if (!segmentPath.isEmpty() && !LogArchive::compressSegment(segmentPath, errorMsg))
+        {
+            qWarning() << errorMsg;
+        }
+        if (!nameFilter.isEmpty())
+        {
+            LogArchive::enforceBudget(QFileInfo(activePath).absolutePath(), nameFilter, budgetBytes, activePath);
+        }
+    });
+}
+
+// One large write instead of one per entry
+void LogWriter::writeBuffer()
+{
+    if (m_buffer.isEmpty() || !m_file.isOpen())
+    {
+        m_buffer.resize(0);
+        return;
+    }
+
+    qint64 written = m_file.write(m_buffer);
+    if (written != m_buffer.size())
+    {
+        emit writeFailed("Failed to write log file: " + m_file.errorString());
+    }
+    m_fileBytes += qMax<qint64>(0, written);
+    m_file.flush();
+    // Keeps the reserved capacity
+    m_buffer.resize(0);
+}
@@ -0,0 +1,127 @@
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSemaphore>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+#include "outputcapture.h"
+
+/**
+ * @brief Background writer of the persistent execution log
+ * @note Entries are handed over through a lock-free single-producer/single-consumer ring:
+ *       only the thread owning the writer (the executor's thread) may call write()/flush()
+ * @note The log file stays open and entries are collected in a large buffer, written when it fills up,
+ *       when the writer has been idle for a moment, on flush() and when the writer stops
+ * @note Rotation: a full file is renamed to <name>.NNN.<suffix> and gzip-compressed on the global thread pool,
+ *       the active file keeps its path; the oldest log files are then deleted down to the disk budget
+ * @note A failed rename (e.g. a viewer holding the file on Windows) is reported once and retried after
+ *       another segment was written or a minute passed
+ */
+class LogWriter : public QThread
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief One piece of an entry: literal text or the complete output of a capture
+     */
+    struct Part
+    {
+        QString       text;
+        OutputCapture capture;
+        bool          isCapture = false;
+    };
+
+    explicit LogWriter(QObject* parent = nullptr);
+
+    /**
+     * @brief Flush pending entries and stop the thread
+     */
+    ~LogWriter() override;
+
+    /**
+     * @brief Queue text for the log file
+     * @param filePath Log file (entries may target different files)
+     * @param text Text appended as is
+     */
+    void write(const QString& filePath, const QString& text);
+
+    /**
+     * @brief Queue an entry made of several parts (captures are streamed from their spool files)
+     */
+    void write(const QString& filePath, const QVector<Part>& parts);
+
+    /**
+     * @brief Write everything queued so far to disk
+     * @param wait True = return only once the data reached the file
+     */
+    void flush(bool wait = false);
+
+    /**
+     * @brief Configure rotation and retention
+     * @param maxSegmentBytes Size at which the active file is closed and compressed (0 = never rotate)
+     * @param budgetBytes Disk budget of all files matching nameFilter in the folder of activePath (0 = unlimited)
+     * @param nameFilter Wildcard selecting the log files covered by the budget (segments included)
+     * @param activePath Log file currently written (never deleted)
+     * @note The budget is also enforced right away, so logs of earlier sessions are trimmed at startup
+     */
+    void setRotation(qint64 maxSegmentBytes, qint64 budgetBytes, const QString& nameFilter, const QString& activePath);
+
+signals:
+    /**
+     * @brief Emitted (from the writer thread) when the log file cannot be opened or written
+     */
+    void writeFailed(const QString& errorMsg);
+
+protected:
+    void run() override;
+
+private:
+    struct Record
+    {
+        enum Kind
+        {
+            Write,
+            Flush,
+            Configure,
+            Stop,
+        };
+
+        Kind           kind = Write;
+        QString        filePath;
+        qint64         maxSegmentBytes = 0; // Configure only
+        qint64         budgetBytes = 0;     // Configure only
+        QString        nameFilter;          // Configure only
+        QVector<Part>  parts;
+        QSemaphore*    done = nullptr;  // Released once a Flush record was handled
+    };
+
+    void push(Record* record);
+    Record* pop();
+
+    void writeRecord(const Record& record);
+    void writeBuffer();
+    void rotate();
+    void startRetention(const QString& segmentPath);
+
+    QVector<Record*>       m_ring;          // Fixed size (power of two)
+    std::atomic<quint64>   m_head;          // Next slot written by the producer
+    std::atomic<quint64>   m_tail;          // Next slot read by the writer thread
+    QSemaphore             m_pending;       // One resource per queued record (wakes the writer)
+
+    // Writer thread only
+    QFile      m_file;
+    QByteArray m_buffer;                    // Encoded text not yet written
+    qint64     m_fileBytes = 0;             // Size of the active file including written buffers
+    qint64     m_maxSegmentBytes = 0;
+    qint64     m_budgetBytes = 0;
+    QString    m_nameFilter;
+    qint64     m_rotateRetryBytes = 0;      // Size at which a failed rotation is retried (0 = last one succeeded)
+    QElapsedTimer m_rotateRetryTimer;       // Time since the last failed rotation
+};
+
+#endif // LOGWRITER_H
@@ -1,9 +1,17 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "QMessageBox.h"
-#include <QScrollBar>
 #include <QThread>
 #include <QDesktopServices>
+#include <QDateTime>
+#include <QSettings>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include "commandline.h"
+#include "logfileviewer.h"
+#include "builddaemon.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -24,6 +32,7 @@ MainWindow::~MainWindow()
 void MainWindow::initUI()
 {
     m_executor            = new CommandExecutor(this);
+    m_defaultConcurrentJobs = m_executor->maxConcurrentJobs();
     m_projectpathselector = new FilePathSelector("ProjectPath", ui->cbProjectPath, ui->bProjectPathBrowser, this);
     m_targetpathselector  = new FilePathSelector("TargetPath", ui->cbTargetPath, ui->bTargetPathBrowser, this);
 
@@ -39,43 +48,111 @@ void MainWindow::initUI()
     ui->labRemoteStatus->hide();
 
     ui->bRemoteConfig->setEnabled(false);
+
+    // Generator is part of the build profile (combo order = CMakeGenerator::Kind)
+    QSettings buildSettings("EazyBuild", "Build");
+    CMakeGenerator::fromOptionName(buildSettings.value("Generator", CMakeGenerator::optionName(m_generator)).toString(), m_generator);
+    ui->cbGenerator->setCurrentIndex(m_generator);
+    m_compilerLauncher = buildSettings.value("CompilerLauncher").toString();
+    ui->cbCompilerLauncher->setCurrentIndex(qMax(0, ui->cbCompilerLauncher->findText(m_compilerLauncher)));
+    ui->cbUseDaemon->setChecked(buildSettings.value("UseDaemon", false).toBool());
+
+    // Component subtrees relative to the project root (changes elsewhere rebuild every component)
+    QSettings trackerSettings("EazyBuild", "ChangeTracker");
+    m_changeTracker = new SourceChangeTracker(this);
+    m_changeTracker->setComponentPaths("UMD", trackerSettings.value("UMD", QStringList() << "umd").toStringList());
+    m_changeTracker->setComponentPaths("KMD", trackerSettings.value("KMD", QStringList() << "kmd").toStringList());
+    m_changeTracker->setComponentPaths("Panel", trackerSettings.value("Panel", QStringList() << "tools/fantasypanel").toStringList());
+
+    // Watch mode waits for edits to settle (a save usually touches several files) before building
+    QSettings watchSettings("EazyBuild", "Watch");
+    m_watchTimer = new QTimer(this);
+    m_watchTimer->setSingleShot(true);
+    m_watchTimer->setInterval(watchSettings.value("DebounceMs", 1500).toInt());
+
+    // Log rotation: segment size and the disk budget of all session logs
+    QSettings logSettings("EazyBuild", "Log");
+    m_executor->setLogRotation(logSettings.value("SegmentMB", 64).toLongLong() * 1024 * 1024,
+                               logSettings.value("BudgetMB", 2048).toLongLong() * 1024 * 1024);
+    // Build trace (Chrome trace-event JSON) written next to the log after every batch
+    m_executor->setTraceEnabled(logSettings.value("Trace", true).toBool());
+
+    // Artifact cache size; least recently restored entries go first
+    QSettings cacheSettings("EazyBuild", "ArtifactCache");
+    m_executor->setArtifactCacheBudget(cacheSettings.value("BudgetMB", 10240).toLongLong() * 1024 * 1024);
+
+    // Diagnostics of the running batch: severity combo, then free-text filter, sortable by any column
+    m_diagSeverityFilter = new QSortFilterProxyModel(this);
+    m_diagSeverityFilter->setSourceModel(m_executor->diagnostics());
+    m_diagSeverityFilter->setFilterKeyColumn(DiagnosticTable::SeverityColumn);
+    m_diagTextFilter = new QSortFilterProxyModel(this);
+    m_diagTextFilter->setSourceModel(m_diagSeverityFilter);
+    m_diagTextFilter->setFilterKeyColumn(-1);
+    m_diagTextFilter->setFilterCaseSensitivity(Qt::CaseInsensitive);
+    ui->tvDiagnostics->setModel(m_diagTextFilter);
+    ui->tvDiagnostics->horizontalHeader()->setStretchLastSection(false);
+    ui->tvDiagnostics->horizontalHeader()->setSectionResizeMode(DiagnosticTable::MessageColumn, QHeaderView::Stretch);
+    ui->tvDiagnostics->verticalHeader()->hide();
+    ui->tvDiagnostics->sortByColumn(DiagnosticTable::SeverityColumn, Qt::AscendingOrder);
 }
 
 void MainWindow::connectSignalsAndSlots()
 {
     connect(ui->bG0MBuild, &QPushButton::clicked, this, [=]() {
-        buildCmd(GPUDriver, G0M, m_buildConfig, m_isAutoReplace, AllDriver, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
+        buildCmd(BuildOptions::GPUDriver, BuildOptions::G0M, m_buildConfig, m_isAutoReplace, BuildOptions::AllDriver, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
     });
     connect(ui->bG0MUMDBuild, &QPushButton::clicked, this, [=]() {
-        buildCmd(GPUDriver, G0M, m_buildConfig, m_isAutoReplace, UMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
+        buildCmd(BuildOptions::GPUDriver, BuildOptions::G0M, m_buildConfig, m_isAutoReplace, BuildOptions::UMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
     });
     connect(ui->bG0MKMDBuild, &QPushButton::clicked, this, [=]() {
-        buildCmd(GPUDriver, G0M, m_buildConfig, m_isAutoReplace, KMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
+        buildCmd(BuildOptions::GPUDriver, BuildOptions::G0M, m_buildConfig, m_isAutoReplace, BuildOptions::KMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
     });
     connect(ui->bG3Build, &QPushButton::clicked, this, [=]() {
-        buildCmd(GPUDriver, G3, m_buildConfig, m_isAutoReplace, AllDriver, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
+        buildCmd(BuildOptions::GPUDriver, BuildOptions::G3, m_buildConfig, m_isAutoReplace, BuildOptions::AllDriver, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
     });
     connect(ui->bG3UMDBuild, &QPushButton::clicked, this, [=]() {
-        buildCmd(GPUDriver, G3, m_buildConfig, m_isAutoReplace, UMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
+        buildCmd(BuildOptions::GPUDriver, BuildOptions::G3, m_buildConfig, m_isAutoReplace, BuildOptions::UMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
     });
     connect(ui->bG3KMDBuild, &QPushButton::clicked, this, [=]() {
-        buildCmd(GPUDriver, G3, m_buildConfig, m_isAutoReplace, KMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
+        buildCmd(BuildOptions::GPUDriver, BuildOptions::G3, m_buildConfig, m_isAutoReplace, BuildOptions::KMD, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
     });
     connect(ui->bG0MPanelBuild, &QPushButton::clicked, this, [=]() {
-        buildCmd(FantasyPanel, G0M, m_buildConfig, m_isAutoReplace);
+        buildCmd(BuildOptions::FantasyPanel, BuildOptions::G0M, m_buildConfig, m_isAutoReplace);
     });
     connect(ui->bG3PanelBuild, &QPushButton::clicked, this, [=]() {
-        buildCmd(FantasyPanel, G3, m_buildConfig, m_isAutoReplace);
+        buildCmd(BuildOptions::FantasyPanel, BuildOptions::G3, m_buildConfig, m_isAutoReplace);
     });
     connect(ui->bManuallyBuild, &QPushButton::clicked, this, [=]() {
         buildCmd(m_buildType, m_gpuModel, m_buildConfig, m_isAutoReplace, m_driverType, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
     });
+    connect(ui->bMatrixBuild, &QPushButton::clicked, this, &MainWindow::buildMatrix);
     connect(ui->bClear, &QPushButton::clicked, this, [=]() {
-        ui->txtLog->clear();
+        ui->lvLog->clearLog();
     });
     connect(ui->bLogFile, &QPushButton::clicked, this, [=]() {
-        QDesktopServices::openUrl(QUrl::fromLocalFile(m_executor->logFileFolder()));
+        // Rotated segments are compressed next to it; the active segment always keeps logFilePath()
+        m_executor->flushLogFile();
+        QString logFile = m_executor->logFilePath();
+        if (!QFile::exists(logFile))
+        {
+            QDesktopServices::openUrl(QUrl::fromLocalFile(m_executor->logFileFolder()));
+            return;
+        }
+        // In-app viewer: external editors choke on multi-GB logs
+        LogFileViewer* viewer = new LogFileViewer(this);
+        viewer->setAttribute(Qt::WA_DeleteOnClose);
+        viewer->openFile(logFile);
+        viewer->show();
+    });
+    connect(ui->cbDiagSeverity, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [=](int index) {
+        // Combo order: All, Errors, Warnings
+        m_diagSeverityFilter->setFilterFixedString(index == 1 ? DiagnosticTable::severityName(Diagnostic::Error)
+                                                   : index == 2 ? DiagnosticTable::severityName(Diagnostic::Warning)
+                                                                : QString());
     });
+    connect(ui->leDiagFilter, &QLineEdit::textChanged, m_diagTextFilter, &QSortFilterProxyModel::setFilterFixedString);
+    connect(m_executor->diagnostics(), &DiagnosticTable::rowsInserted, this, &MainWindow::updateDiagnosticCounts);
+    connect(m_executor->diagnostics(), &DiagnosticTable::modelReset, this, &MainWindow::updateDiagnosticCounts);
     connect(ui->bReplace, &QPushButton::clicked, this, [=]() {
 
     });
@@ -88,6 +165,8 @@ void MainWindow::connectSignalsAndSlots()
     connect(ui->cbDriverType, &QComboBox::currentIndexChanged, this, &MainWindow::setDriverType);
     connect(ui->cbBitType, &QComboBox::currentIndexChanged, this, &MainWindow::setBit);
     connect(ui->cbFW, &QComboBox::currentIndexChanged, this, &MainWindow::setFirmwareVersion);
+    connect(ui->cbGenerator, &QComboBox::currentIndexChanged, this, &MainWindow::setGenerator);
+    connect(ui->cbCompilerLauncher, &QComboBox::currentIndexChanged, this, &MainWindow::setCompilerLauncher);
 
     connect(ui->cbReplace, &QCheckBox::clicked, this, &MainWindow::setReplace);
     connect(ui->cbDeleteKMD, &QCheckBox::clicked, this, &MainWindow::setDeleteKMD);
@@ -97,7 +176,7 @@ void MainWindow::connectSignalsAndSlots()
 
     connect(m_configButtonGroup, &QButtonGroup::idClicked, this, &MainWindow::setConfig);
 
-    // 1. Bind real-time log signal to QTextEdit (non-blocking update)
+    // 1. Bind real-time log signal to the log view (non-blocking update)
     connect(m_executor, &CommandExecutor::logUpdated, this, [this](const QString& logContent, bool isError) {
         // Ensure log update runs in UI thread (prevent cross-thread issues)
         if (QThread::currentThread() != thread()) {
@@ -106,38 +185,55 @@ void MainWindow::connectSignalsAndSlots()
             }, Qt::QueuedConnection);
             return;
         }
-
-        // Append log to text edit
-        QTextCursor cursor = ui->txtLog->textCursor();
-        cursor.movePosition(QTextCursor::End);
-
-        // Color coding: red for errors, black for normal logs
-        if (isError) {
-            ui->txtLog->setTextColor(Qt::red);
-        } else {
-            ui->txtLog->setTextColor(Qt::black);
-        }
-
-        ui->txtLog->insertPlainText(logContent);
-
-        // Auto-scroll to bottom (user always sees latest log)
-        QScrollBar* scrollBar = ui->txtLog->verticalScrollBar();
-        scrollBar->setValue(scrollBar->maximum());
-
-        // Limit log lines to prevent memory overflow/UI lag
-        limitLogLines(ui->txtLog, 10000);
+        on_logUpdated(logContent, isError);
     });
 
     // 2. Bind command completion signal
     connect(m_executor, &CommandExecutor::commandFinished, this, &MainWindow::onCommandFinished);
 
-    // 3. Bind progress signal (optional - for status bar display)
-    connect(m_executor, &CommandExecutor::commandProgress, this, [this](int current, int total, const QString& cmd) {
-        ui->statusbar->showMessage(QString("Progress: %1/%2 - Executing: %3").arg(current).arg(total).arg(cmd));
+    // 3. Bind per-job completion signal (status bar display)
+    connect(m_executor, &CommandExecutor::jobFinished, this, [this](int, const QString& jobName, bool success, const QString&, const QString&) {
+        ui->statusbar->showMessage(QString("Job %1: %2").arg(jobName, success ? "succeeded" : "failed"), 3000);
+    });
+
+    // Remember successful chains so unchanged components can be skipped next time
+    connect(m_executor, &CommandExecutor::chainSucceeded, this, [this](int jobId, const QString& chain) {
+        QString buildKey = m_chainBuildKeys.value(jobId).value(chain);
+        if (!buildKey.isEmpty()) {
+            m_changeTracker->markBuilt(buildKey, m_jobStartSequence.value(jobId));
+        }
+    });
+    connect(m_executor, &CommandExecutor::jobFinished, this, [this](int jobId, const QString&, bool success, const QString&, const QString&) {
+        m_chainBuildKeys.remove(jobId);
+        m_jobStartSequence.remove(jobId);
+        if (m_isMatrixBuild) {
+            m_matrix.setResult(jobId, success, m_executor->jobDurationMs(jobId));
+        }
+    });
+
+    // 4. Bind progress signal (optional - for status bar display)
+    connect(m_executor, &CommandExecutor::commandProgress, this, [this](int current, int total, const QString& cmd, const ResourceUsage& usage) {
+        QString message = QString("Progress: %1/%2 - Executing: %3").arg(current).arg(total).arg(cmd);
+        if (usage.commands > 0) {
+            message += QString("  [finished: %1]").arg(usage.summary());
+        }
+        ui->statusbar->showMessage(message);
     });
 
     connect(ui->cbRemoteDeploy, &QCheckBox::clicked, this, &MainWindow::setRemoteDeploy);
     connect(ui->bRemoteConfig, &QPushButton::clicked, this, &MainWindow::onRemoteConfigClicked);
+    connect(ui->cbUseDaemon, &QCheckBox::clicked, this, [](bool checked) {
+        QSettings("EazyBuild", "Build").setValue("UseDaemon", checked);
+    });
+
+    // Watch mode: every change restarts the debounce window
+    connect(ui->cbWatch, &QCheckBox::clicked, this, &MainWindow::setWatchMode);
+    connect(m_watchTimer, &QTimer::timeout, this, &MainWindow::onWatchTimeout);
+    connect(m_changeTracker, &SourceChangeTracker::sourcesChanged, this, [this](const QStringList&) {
+        if (m_isWatching) {
+            m_watchTimer->start();
+        }
+    });
 }
 
 void MainWindow::setStyleSheet()
@@ -146,37 +242,16 @@ void MainWindow::setStyleSheet()
     ui->bReplace->hide();
 }
 
-bool MainWindow::buildCmd(BuildType btype, GPUModel gpu, BuildConfig build, bool isAutomaticallyReplace, DriverType driver,
-                           Bit bit, FirmwareVersion fw, bool isForceDeleteKMD, bool isUniQ, bool isPvr, bool isStat)
-{
-    QStringList     cmds;
-    QString         workDir;
-    QString         foldername = "cmake_build_";
-    QString         umdfoldername;
-    QString         umd32foldername;
-    QString         kmdfoldername;
-    QString         panelfoldername;
-    QString         soctype;
-    QString         buildconfig;
-    QString         firmware;
-    QString         UNIQ;
-    QString         procstat;
-    QString         pvrtune;
-    QString         cmakeGenerator = "Visual Studio 16 2019"; // Store generator name separately without quotes
-    QString         bkmd       = "BUILD_KMD=1";
-    QString         conf32     = "CONFIG=wnow32";
-    QString         renderonly = "RENDER_ONLY=1";
-    bool            isGPU      = btype  != FantasyPanel;
-    bool            isPanel    = btype  != GPUDriver;
-    bool            isUMD      = driver != KMD;
-    bool            isKMD      = driver != UMD;
-    bool            is32Bit    = bit    != Bit64;
-    bool            is64Bit    = bit    != Bit32;
-    bool            isRemote   = m_isRemoteDeploy && !m_remotePath.isEmpty();
+bool MainWindow::buildCmd(BuildOptions::BuildType btype, BuildOptions::GPUModel gpu, BuildOptions::BuildConfig build, bool isAutomaticallyReplace,
+                          BuildOptions::DriverType driver, BuildOptions::Bit bit, BuildOptions::FirmwareVersion fw, bool isForceDeleteKMD,
+                          bool isUniQ, bool isPvr, bool isStat)
+{
+    QString workDir;
+    bool    isRemote = m_isRemoteDeploy && !m_remotePath.isEmpty();
 
     if(!FilePathSelector::isPathValid(m_projctPath))
     {
-        QMessageBox::warning(this, "Invalid Path", "Please select a valid project directory first!");
+        reportBuildWarning("Invalid Path", "Please select a valid project directory first!");
         return false;
     }
 
@@ -184,178 +259,253 @@ bool MainWindow::buildCmd(BuildType btype, GPUModel gpu, BuildConfig build, bool
     {
         if(!FilePathSelector::isPathValid(m_targetPath))
         {
-            QMessageBox::warning(this, "Invalid Path", "Please select a valid target directory or uncheck \"isAutomaticallyReplace\"!");
+            reportBuildWarning("Invalid Path", "Please select a valid target directory or uncheck \"isAutomaticallyReplace\"!");
             return false;
         }
     }
 
     workDir = ui->cbProjectPath->currentText();
 
-    switch(gpu)
-    {
-    case G3:
-        soctype = "G3";
-        break;
-    case G0M:
-        soctype = "G0M";
-        break;
-    case G1P:
-        soctype = "G1P";
-        break;
-    default:
-        break;
-    }
-
-    switch(fw)
-    {
-    case Firmware116:
-        firmware = "IMGDDK116=1"; // Remove leading space and -D for later concatenation
-        break;
-    case Firmware119:
-        firmware = "IMGDDK119=1"; // Remove leading space and -D for later concatenation
-        break;
-    default:
-        break;
-    }
-
-    UNIQ       = isUniQ ? "SUPPORT_UNIQ=1" : "";       // Remove leading space and -D for later concatenation
-    procstat   = isStat ? "ENABLE_PROCESS_STATS=1" : "";// Remove leading space and -D for later concatenation
-    pvrtune    = isPvr ? "SUPPORT_PERF=1" : "";        // Remove leading space and -D for later concatenation
-
-    umdfoldername   = foldername + "umd_" + soctype;
-    umd32foldername = umdfoldername + "_win32";
-    kmdfoldername   = foldername + "kmd_" + soctype;
-    panelfoldername = foldername + soctype;
-    soctype         = "SOC_TYPE=" + soctype;           // Remove leading space and -D for later concatenation
-
-    if(build == Debug)
-    {
-        buildconfig = "Debug";
+    BuildOptions options;
+    options.buildType      = btype;
+    options.gpu            = gpu;
+    options.config         = build;
+    options.autoReplace    = isAutomaticallyReplace;
+    options.driver         = driver;
+    options.bit            = bit;
+    options.firmware       = fw;
+    options.forceDeleteKMD = isForceDeleteKMD;
+    options.uniq           = isUniQ;
+    options.pvr            = isPvr;
+    options.stat           = isStat;
+    options.generator      = m_generator;
+    options.compilerLauncher = m_compilerLauncher;
+
+    // Opt-in: the resident daemon keeps its caches warm between builds (watch builds stay in-process)
+    if (ui->cbUseDaemon->isChecked() && !m_isWatchBuild && submitToDaemon(options, workDir, isRemote)) {
+        return true;
     }
-    else
-    {
-        buildconfig = "Release";
+
+    m_executor->setCompilerLauncher(m_compilerLauncher);
+    m_executor->setFailFastEnabled(ui->cbFailFast->isChecked());
+    if (!m_compilerLauncher.isEmpty() && !CMakeGenerator(m_generator).supportsCompilerLauncher()) {
+        QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+        on_logUpdated(QString("%1 ⚠️ %2 ignores compiler launchers, %3 is not used\n")
+                          .arg(timestamp, CMakeGenerator(m_generator).cmakeName(), m_compilerLauncher), true);
     }
 
+    // Watching starts with the first build of a project (the first build is always a full one)
+    m_changeTracker->setRoot(workDir);
+
     setButtonState(false);
     ui->bClear->click();
 
-    QList<QPair<QString, QString>> pendingCopyTasks;
-    QList<QString> pendingDelTasks;
-
-    // ========== GPU Driver Logic ==========
-    if (isGPU) {
-        // UMD logic (simplified by merging 32/64-bit handling)
-        if (isUMD) {
-            // Define UMD 32/64-bit configuration map using nested QPair
-            // Format: QPair<bool, QPair<QString, QPair<QString, QString>>>
-            //         {isBitEnabled, {buildDir, {extraParams, dllFileName}}}
-            QList<QPair<bool, QPair<QString, QPair<QString, QString>>>> umdConfigs = {
-                qMakePair(is32Bit, qMakePair(umd32foldername, qMakePair(conf32, "fantumd32.dll"))),
-                qMakePair(is64Bit, qMakePair(umdfoldername, qMakePair("", "fantumd64.dll")))
-            };
-
-            for (const auto& config : umdConfigs) {
-                bool isBitEnabled = config.first;
-                QString buildDir = config.second.first;
-                QString extraParams = config.second.second.first;
-                QString dllName = config.second.second.second;
-
-                if (isBitEnabled) {
-                    QStringList cmakeConfigureArgs;
-                    cmakeConfigureArgs << "-S." << "-B" << buildDir
-                                       << "-D" << soctype
-                                       << (UNIQ.isEmpty() ? "" : "-D") << UNIQ
-                                       << (firmware.isEmpty() ? "" : "-D") << firmware
-                                       << "-G" << cmakeGenerator // Generator as independent parameter (no quotes)
-                                       << (extraParams.isEmpty() ? "" : "-D") << extraParams;
-                    // Concatenate to standardized command string (no quotes, space-separated only)
-                    QString cmakeConfigureCmd = "cmake " + cmakeConfigureArgs.join(" ");
-
-                    // Keep original logic: Add CMake configure/build commands
-                    cmds.append(cmakeConfigureCmd);
-                    cmds.append(generateCmakeBuildCmd(buildDir, buildconfig));
-                    // Automatic file copy logic
-                    if (isAutomaticallyReplace)
-                    {
-                        QString srcFile = joinPath({workDir, buildDir, buildconfig, dllName});
-                        pendingCopyTasks.append(qMakePair(srcFile, m_targetPath));
-                    }
-                }
-            }
+    // Chains whose component sources are unchanged are dropped (their artifacts are still deployed)
+    QList<PlannedJob> jobs = BuildPlanner::plan(options, workDir, m_targetPath,
+        [this](const QString& component, const QString& chain, const QString& buildKey, const QStringList& artifacts) {
+            return skipUnchangedChain(component, chain, buildKey, artifacts);
+        },
+        // The tree is walked again only after the tracker saw an edit
+        [this](const QString& dir) { return m_changeTracker->treeStateOf(dir); });
+
+    // GPU Driver and FantasyPanel are queued as separate jobs so they run side by side
+    bool isJobQueued = false;
+    for (const PlannedJob& job : jobs) {
+        int jobId = m_executor->enqueueJob(job.name, job.nodes, job.copyTasks, job.delTasks, job.workDir, isRemote);
+        trackJobChains(jobId, job.chainKeys);
+        isJobQueued = isJobQueued || jobId >= 0;
+    }
+
+    // Everything was up to date: nothing will report back, re-enable the UI now
+    if (!isJobQueued) {
+        ui->statusbar->showMessage("All selected components are up to date", 3000);
+        setButtonState(true);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Queue a build on a running eazybuild-daemon instead of the in-process executor
+ * @param options Build options of the request
+ * @param workDir Project source directory
+ * @param isRemote Deploy to the configured RemoteReceiver host
+ * @return False = no daemon is listening (the caller builds in-process)
+ * @note Same protocol as eazybuild-cli --daemon: the daemon streams the log and job events of this build back
+ */
+bool MainWindow::submitToDaemon(const BuildOptions& options, const QString& workDir, bool isRemote)
+{
+    QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+    QString serverName = QSettings("EazyBuild", "Build").value("DaemonName", BuildDaemon::defaultServerName()).toString();
+
+    QLocalSocket* socket = new QLocalSocket(this);
+    socket->connectToServer(serverName);
+    if (!socket->waitForConnected(1000)) {
+        on_logUpdated(QString("%1 ⚠️ No build daemon listening on %2, building in-process\n").arg(timestamp, serverName), true);
+        delete socket;
+        return false;
+    }
+
+    m_daemonSocket       = socket;
+    m_daemonBuffer.clear();
+    m_daemonJobs.clear();
+    m_daemonAcceptedJobs = -1;
+    m_hasDaemonFailure   = false;
+    m_daemonErrors.clear();
+
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+        m_daemonBuffer.append(socket->readAll());
+        int newline;
+        // A finished build releases the socket: later lines are not ours
+        while (m_daemonSocket == socket && (newline = m_daemonBuffer.indexOf('\n')) >= 0) {
+            QJsonObject event = QJsonDocument::fromJson(m_daemonBuffer.left(newline)).object();
+            m_daemonBuffer.remove(0, newline + 1);
+            onDaemonEvent(event);
+        }
+    });
+    connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+        if (m_daemonSocket == socket) {
+            finishDaemonBuild(false, "The build daemon closed the connection");
         }
+    });
+
+    QJsonObject request;
+    request["request"]       = "build";
+    request["project"]       = workDir;
+    request["target"]        = m_targetPath;
+    request["options"]       = BuildPlanner::optionsToJson(options);
+    request["skipUnchanged"] = ui->cbSkipUnchanged->isChecked();
+    request["failFast"]      = ui->cbFailFast->isChecked();
+    if (isRemote) {
+        request["remoteHost"] = m_remoteHost;
+        request["remotePath"] = m_remotePath;
+    }
+    socket->write(QJsonDocument(request).toJson(QJsonDocument::Compact));
+    socket->write("\n", 1);
+
+    // Watching starts with the first build of a project, wherever it runs
+    m_changeTracker->setRoot(workDir);
+
+    setButtonState(false);
+    ui->bClear->click();
+    on_logUpdated(QString("%1 🛰️ Build submitted to daemon %2\n").arg(timestamp, serverName), false);
+    return true;
+}
 
-        // KMD logic
-        if (isKMD) {
-            // Force delete KMD directory if enabled
-            if (isForceDeleteKMD) {
-                QString KmdFolder = workDir + "/" + kmdfoldername;
-                pendingDelTasks.append(KmdFolder);
+// One event line of the daemon build (log, accepted, jobFinished, error)
+void MainWindow::onDaemonEvent(const QJsonObject& event)
+{
+    QString type = event.value("event").toString();
+
+    if (type == "log") {
+        on_logUpdated(event.value("text").toString(), event.value("error").toBool());
+    } else if (type == "error") {
+        finishDaemonBuild(false, event.value("message").toString());
+        return;
+    } else if (type == "accepted") {
+        // Jobs restored from cache may already be done when the reply arrives
+        QJsonArray jobs = event.value("jobs").toArray();
+        m_daemonAcceptedJobs = jobs.size();
+        for (const QJsonValue& value : jobs) {
+            QJsonObject job = value.toObject();
+            QString status = job.value("status").toString();
+            if (status == "queued" || status == "running") {
+                m_daemonJobs.insert(job.value("id").toInt());
+            } else if (status != "succeeded") {
+                m_hasDaemonFailure = true;
             }
-            QStringList cmakeKmdArgs;
-            cmakeKmdArgs << "-S." << "-B" << kmdfoldername
-                         << "-D" << soctype
-                         << "-D" << bkmd
-                         << (UNIQ.isEmpty() ? "" : "-D") << UNIQ
-                         << (firmware.isEmpty() ? "" : "-D") << firmware
-                         << (pvrtune.isEmpty() ? "" : "-D") << pvrtune
-                         << (procstat.isEmpty() ? "" : "-D") << procstat
-                         << "-G" << cmakeGenerator; // Generator as independent parameter (no quotes)
-            QString cmakeKmdConfigureCmd = "cmake " + cmakeKmdArgs.join(" ");
-
-            // Keep original logic: Add KMD configure/build commands
-            cmds.append(cmakeKmdConfigureCmd);
-            cmds.append(generateCmakeBuildCmd(kmdfoldername, buildconfig));
         }
+    } else if (type == "jobFinished") {
+        bool success = event.value("success").toBool();
+        ui->statusbar->showMessage(QString("Job %1: %2").arg(event.value("name").toString(), success ? "succeeded" : "failed"), 3000);
+        if (!success) {
+            m_hasDaemonFailure = true;
+            m_daemonErrors += event.value("stderr").toString();
+        }
+        m_daemonJobs.remove(event.value("id").toInt());
+    }
 
-        m_executor->executeMultiCommandsAsync(cmds, pendingCopyTasks, pendingDelTasks, workDir, isRemote);
-    }
-
-    // ========== FantasyPanel Logic ==========
-    cmds.clear();
-    pendingCopyTasks.clear();
-    pendingDelTasks.clear();
-    if (isPanel) {
-        QStringList cmakePanelArgs;
-        cmakePanelArgs << "-S." << "-B" << panelfoldername
-                       << "-D" << soctype
-                       << "-G" << cmakeGenerator; // Generator as independent parameter (no quotes)
-        QString cmakePanelConfigureCmd = "cmake " + cmakePanelArgs.join(" ");
-        // 1. Update working directory (NOTE: Use temporary variable to avoid polluting original workDir)
-        QString panelWorkDir = joinPath({workDir, "tools", "fantasypanel"});
-        // 2. Combine Panel path and additional parameters (keep original comment, adjusted logic)
-        QString srcFile = joinPath({panelWorkDir, panelfoldername, buildconfig, "FantasyPanel.exe"});
-        // 3. Generate CMake commands for Panel (keep original logic)
-        cmds.append(cmakePanelConfigureCmd);
-        cmds.append(generateCmakeBuildCmd(panelfoldername, buildconfig));
-        // 4. Automatic file copy if enabled
-        if (isAutomaticallyReplace) {
-            if (isAutomaticallyReplace)
-            {
-                pendingCopyTasks.append(qMakePair(srcFile, m_targetPath));
-            }
+    if (m_daemonAcceptedJobs >= 0 && m_daemonJobs.isEmpty()) {
+        finishDaemonBuild(!m_hasDaemonFailure, m_daemonErrors);
+    }
+}
+
+/**
+ * @brief Release the daemon connection and give the same feedback as an in-process build
+ * @param success True = every daemon job succeeded
+ * @param errorText Daemon error or stderr of the failed jobs
+ */
+void MainWindow::finishDaemonBuild(bool success, const QString& errorText)
+{
+    QLocalSocket* socket = m_daemonSocket;
+    m_daemonSocket = nullptr;
+    socket->disconnect(this);
+    socket->disconnectFromServer();
+    socket->deleteLater();
+
+    setButtonState(true);
+
+    if (success && m_daemonAcceptedJobs == 0) {
+        ui->statusbar->showMessage("All selected components are up to date", 3000);
+    } else if (success) {
+        QMessageBox::information(this, "Success", "All commands executed successfully!");
+        ui->statusbar->showMessage("Execution completed successfully", 3000);
+    } else {
+        QMessageBox::critical(this, "Error", QString("Command execution failed:\n%1").arg(errorText));
+        ui->statusbar->showMessage("Execution failed", 3000);
+    }
+
+    // Changes that arrived during the daemon build are built now
+    if (m_isWatchPending) {
+        m_isWatchPending = false;
+        if (m_isWatching) {
+            m_watchTimer->start();
         }
+    }
+}
+
+/**
+ * @brief Check whether a chain can be dropped because its component sources are unchanged
+ * @param component Component name registered in the change tracker ("UMD", "KMD", "Panel")
+ * @param chain Chain label (build directory)
+ * @param buildKey Build dir + configure/build commands of the chain
+ * @param artifacts Outputs that must still exist for the chain to be skipped
+ * @return True = chain skipped
+ */
+bool MainWindow::skipUnchangedChain(const QString& component, const QString& chain, const QString& buildKey, const QStringList& artifacts)
+{
+    if (!ui->cbSkipUnchanged->isChecked()) return false;
+    if (m_changeTracker->hasChangesSince(component, buildKey)) return false;
 
-        m_executor->executeMultiCommandsAsync(cmds, pendingCopyTasks, pendingDelTasks, panelWorkDir, isRemote); // Use temporary workDir to avoid modifying original
+    for (const QString& artifact : artifacts) {
+        if (!QFileInfo::exists(artifact)) return false;
     }
 
+    QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+    on_logUpdated(QString("%1 [%2] ⏭️ %3 sources unchanged since last successful build, skipped\n").arg(timestamp, chain, component), false);
     return true;
 }
 
+/**
+ * @brief Remember the build keys of a queued job until its chains report back
+ */
+void MainWindow::trackJobChains(int jobId, const QHash<QString, QString>& chainKeys)
+{
+    if (jobId < 0 || chainKeys.isEmpty()) return;
+    m_chainBuildKeys.insert(jobId, chainKeys);
+    // Edits made while the job runs stay pending for the next build
+    m_jobStartSequence.insert(jobId, m_changeTracker->currentSequence());
+}
+
 QString MainWindow::generateCmakeConfigureCmd(const QString& buildDir, const QString& extraParams)
 {
-    QString cmd = "cmake -S. -B " + buildDir;
+    QString cmd = "cmake -S. -B " + CommandLine::quote(buildDir);
     if (!extraParams.isEmpty()) {
         cmd += " " + extraParams;
     }
     return cmd;
 }
 
-QString MainWindow::generateCmakeBuildCmd(const QString& buildDir, const QString& buildConfig)
-{
-    return "cmake --build " + buildDir + " --config " + buildConfig;
-}
-
 QString MainWindow::generateCopyCmd(const QString& srcFile, const QString& targetPath)
 {
     QString quotedSrc = QString("\"%1\"").arg(srcFile);
@@ -375,28 +525,6 @@ QString MainWindow::generateRemoteCopyCmd(const QString& srcFile, const QString&
     return QString("robocopy %1 %2 /Y /R:1 /W:1").arg(quotedSrc).arg(quotedRemote);
 }
 
-QString MainWindow::joinPath(const QStringList& parts)
-{
-    QString path;
-    for (const QString& part : parts) {
-        if (path.isEmpty()) {
-            path = part;
-        } else {
-            path += "/" + part;
-        }
-    }
-    return path;
-}
-
-void MainWindow::limitLogLines(QTextEdit* logWidget, int maxLines)
-{
-    QStringList lines = logWidget->toPlainText().split("\n", Qt::SkipEmptyParts);
-    if (lines.size() > maxLines) {
-        QStringList keepLines = lines.mid(lines.size() - maxLines);
-        logWidget->setText(keepLines.join("\n"));
-    }
-}
-
 /**
  * @brief Command completion callback (UI feedback)
  * @param success True = all commands executed successfully
@@ -405,17 +533,77 @@ void MainWindow::limitLogLines(QTextEdit* logWidget, int maxLines)
  */
 void MainWindow::onCommandFinished(bool success, const QString& stdoutLog, const QString& stderrLog)
 {
+    // A matrix job restored from cache can drain the queue before the next job is queued
+    if (m_isMatrixEnqueuing) {
+        return;
+    }
+
     // Restore UI state
     setButtonState(true);
 
-    // Show completion message
-    if (success) {
-        QMessageBox::information(this, "Success", "All commands executed successfully!");
+    // A stale watch build was cancelled: the restarted build reports instead
+    if (m_isWatchRestart) {
+        return;
+    }
+
+    // Build matrix: one summary table instead of per-build feedback
+    if (m_isMatrixBuild) {
+        m_isMatrixBuild = false;
+        m_executor->setMaxConcurrentJobs(m_defaultConcurrentJobs);
+
+        QString summary = m_matrix.summaryTable();
+        QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+        on_logUpdated(timestamp + " 📊 Build matrix summary:\n" + summary + "\n", m_matrix.failedCount() > 0);
+
+        QString summaryPath = QString("%1/matrix_summary_%2.txt").arg(m_executor->logFileFolder(),
+                                                                      QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+        QFile summaryFile(summaryPath);
+        if (summaryFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            summaryFile.write(summary.toUtf8() + "\n");
+        }
+
+        QString message = QString("Build matrix finished: %1 passed, %2 failed.\nSummary: %3")
+                              .arg(m_matrix.passedCount()).arg(m_matrix.failedCount()).arg(summaryPath);
+        if (!m_executor->compilerCacheSummary().isEmpty()) {
+            message += "\n" + m_executor->compilerCacheSummary();
+        }
+        if (m_matrix.failedCount() == 0 && success) {
+            QMessageBox::information(this, "Build Matrix", message);
+        } else {
+            QMessageBox::warning(this, "Build Matrix", message);
+        }
+        ui->statusbar->showMessage(QString("Build matrix: %1 passed, %2 failed").arg(m_matrix.passedCount()).arg(m_matrix.failedCount()), 3000);
+    }
+    // Watch builds never block the loop with message boxes
+    else if (m_isWatchBuild) {
+        m_isWatchBuild = false;
+        QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+        if (success) {
+            on_logUpdated(timestamp + " 👀 Watch build finished, waiting for changes...\n", false);
+            ui->statusbar->showMessage("Watch build succeeded", 3000);
+        } else {
+            on_logUpdated(timestamp + " 👀 Watch build failed, waiting for changes...\n", true);
+            ui->statusbar->showMessage("Watch build failed", 3000);
+        }
+    } else if (success) {
+        QString message = "All commands executed successfully!";
+        if (!m_executor->compilerCacheSummary().isEmpty()) {
+            message += "\n" + m_executor->compilerCacheSummary();
+        }
+        QMessageBox::information(this, "Success", message);
         ui->statusbar->showMessage("Execution completed successfully", 3000);
     } else {
         QMessageBox::critical(this, "Error", QString("Command execution failed:\n%1").arg(stderrLog));
         ui->statusbar->showMessage("Execution failed", 3000);
     }
+
+    // Changes that arrived during a manual build are built now
+    if (m_isWatchPending) {
+        m_isWatchPending = false;
+        if (m_isWatching) {
+            m_watchTimer->start();
+        }
+    }
 }
 
 // ========== Implemented: Real-time log update handler (UI thread) ==========
@@ -427,25 +615,8 @@ void MainWindow::onCommandFinished(bool success, const QString& stdoutLog, const
  */
 void MainWindow::on_logUpdated(const QString& logContent, bool isError)
 {
-    // Append log to QTextEdit (UI widget)
-    QTextCursor cursor = ui->txtLog->textCursor();
-    cursor.movePosition(QTextCursor::End);
-
-    // Color coding for logs: red = error, black = normal
-    if (isError) {
-        ui->txtLog->setTextColor(Qt::red);
-    } else {
-        ui->txtLog->setTextColor(Qt::black);
-    }
-
-    ui->txtLog->insertPlainText(logContent);
-
-    // Auto-scroll to bottom (ensure user sees latest log)
-    QScrollBar* scrollBar = ui->txtLog->verticalScrollBar();
-    scrollBar->setValue(scrollBar->maximum());
-
-    // Limit log lines to prevent memory overflow/UI lag
-    limitLogLines(ui->txtLog, 10000);
+    // Ring-buffered view: drops the oldest lines itself and follows the end while scrolled down
+    ui->lvLog->appendLog(logContent, isError);
 }
 
 void MainWindow::setButtonState(bool isEnable)
@@ -466,16 +637,19 @@ void MainWindow::setButtonState(bool isEnable)
     ui->cbDriverType->setEnabled(isEnable);
     ui->cbDeleteKMD->setEnabled(isEnable);
     ui->cbFW->setEnabled(isEnable);
+    ui->cbGenerator->setEnabled(isEnable);
+    ui->cbCompilerLauncher->setEnabled(isEnable);
     ui->cbGPUModel->setEnabled(isEnable);
     ui->cbPVR->setEnabled(isEnable);
-    ui->cbProjectPath->setEnabled(isEnable);
+    ui->cbProjectPath->setEnabled(isEnable && !m_isWatching); // Watched tree is fixed while watching
     ui->cbTargetPath->setEnabled(isEnable);
     ui->cbReplace->setEnabled(isEnable);
     ui->cbSTAT->setEnabled(isEnable);
-    ui->cbUNIQ->setEnabled(isEnable && m_fwversion != Firmware116);
+    ui->cbUNIQ->setEnabled(isEnable && m_fwversion != BuildOptions::Firmware116);
 
     ui->bManuallyBuild->setEnabled(isEnable);
-    ui->bProjectPathBrowser->setEnabled(isEnable);
+    ui->bMatrixBuild->setEnabled(isEnable);
+    ui->bProjectPathBrowser->setEnabled(isEnable && !m_isWatching);
     ui->bTargetPathBrowser->setEnabled(isEnable);
     ui->bReplace->setEnabled(isEnable);
 
@@ -483,6 +657,7 @@ void MainWindow::setButtonState(bool isEnable)
     ui->rbRelease->setEnabled(isEnable);
 
     ui->cbRemoteDeploy->setEnabled(isEnable);
+    ui->cbUseDaemon->setEnabled(isEnable);
     ui->bRemoteConfig->setEnabled(isEnable && ui->cbRemoteDeploy->isChecked());
 }
 
@@ -498,33 +673,33 @@ void MainWindow::setTargetPath(const QString& path)
 
 void MainWindow::setBuildType(int index)
 {
-    m_buildType = static_cast<BuildType>(index);
+    m_buildType = static_cast<BuildOptions::BuildType>(index);
 }
 
 void MainWindow::setGPUModel(int index)
 {
-    m_gpuModel = static_cast<GPUModel>(index);
+    m_gpuModel = static_cast<BuildOptions::GPUModel>(index);
 }
 
 void MainWindow::setDriverType(int index)
 {
-    m_driverType = static_cast<DriverType>(index);
+    m_driverType = static_cast<BuildOptions::DriverType>(index);
 }
 
 void MainWindow::setBit(int index)
 {
-    m_bit = static_cast<Bit>(index);
+    m_bit = static_cast<BuildOptions::Bit>(index);
 }
 
 void MainWindow::setConfig(int id)
 {
     if (id == 0)
     {
-        m_buildConfig = Debug;
+        m_buildConfig = BuildOptions::Debug;
     }
     else if (id == 1)
     {
-        m_buildConfig = Release;
+        m_buildConfig = BuildOptions::Release;
     }
 }
 
@@ -553,11 +728,24 @@ void MainWindow::setPvrtune(bool checked)
     m_pvr = checked;
 }
 
+void MainWindow::setGenerator(int index)
+{
+    m_generator = static_cast<CMakeGenerator::Kind>(index);
+    QSettings("EazyBuild", "Build").setValue("Generator", CMakeGenerator::optionName(m_generator));
+}
+
+void MainWindow::setCompilerLauncher(int index)
+{
+    // Index 0 = "None"
+    m_compilerLauncher = index > 0 ? ui->cbCompilerLauncher->itemText(index) : QString();
+    QSettings("EazyBuild", "Build").setValue("CompilerLauncher", m_compilerLauncher);
+}
+
 void MainWindow::setFirmwareVersion(int index)
 {
-    m_fwversion = static_cast<FirmwareVersion>(index);
+    m_fwversion = static_cast<BuildOptions::FirmwareVersion>(index);
 
-    if(m_fwversion == Firmware116)
+    if(m_fwversion == BuildOptions::Firmware116)
     {
         if(m_uniq)
         {
@@ -600,3 +788,151 @@ void MainWindow::onRemoteConfigClicked()
         ui->labRemoteStatus->setText(QString("Remote: %1").arg(m_remotePath));
     }
 }
+
+// Enable/disable watch mode
+void MainWindow::setWatchMode(bool checked)
+{
+    QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+
+    if (checked) {
+        if (!FilePathSelector::isPathValid(m_projctPath)) {
+            QMessageBox::warning(this, "Invalid Path", "Please select a valid project directory first!");
+            ui->cbWatch->setChecked(false);
+            return;
+        }
+        m_changeTracker->setRoot(m_projctPath);
+        m_isWatching = true;
+        on_logUpdated(timestamp + " 👀 Watch mode enabled: " + m_projctPath + "\n", false);
+        if (!m_isAutoReplace) {
+            on_logUpdated(timestamp + " 👀 \"Automatically Replace\" is off: watch builds will not deploy\n", false);
+        }
+        if (!m_changeTracker->isReliable()) {
+            on_logUpdated(timestamp + " 👀 Not every directory could be watched: some edits may be missed\n", true);
+        }
+    } else {
+        m_isWatching = false;
+        m_isWatchPending = false;
+        m_watchTimer->stop();
+        on_logUpdated(timestamp + " 👀 Watch mode disabled\n", false);
+    }
+
+    bool isIdle = !m_executor->isExecuting();
+    ui->cbProjectPath->setEnabled(isIdle && !m_isWatching);
+    ui->bProjectPathBrowser->setEnabled(isIdle && !m_isWatching);
+}
+
+// Debounce window elapsed: start the Manually Build selection, cancelling a stale watch build
+void MainWindow::onWatchTimeout()
+{
+    if (!m_isWatching) return;
+
+    // Daemon builds are never watch builds
+    if (m_executor->isExecuting() || m_daemonSocket) {
+        if (!m_isWatchBuild) {
+            // Never cancel a build the user started: coalesce into one build after it
+            m_isWatchPending = true;
+            return;
+        }
+        QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+        on_logUpdated(timestamp + " 👀 Sources changed during the build, restarting...\n", false);
+        m_isWatchRestart = true;
+        m_executor->stopExecution();
+        m_isWatchRestart = false;
+    }
+
+    m_isWatchBuild = true;
+    buildCmd(m_buildType, m_gpuModel, m_buildConfig, m_isAutoReplace, m_driverType, m_bit, m_fwversion, m_isForceDelKMD, m_uniq, m_pvr, m_stat);
+    // Rejected or fully up to date: nothing will report back
+    if (!m_executor->isExecuting()) {
+        m_isWatchBuild = false;
+    }
+}
+
+// Build warnings are dialogs for manual builds and log lines for watch builds
+void MainWindow::reportBuildWarning(const QString& title, const QString& text)
+{
+    if (m_isWatchBuild) {
+        QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+        on_logUpdated(QString("%1 ❌ %2: %3\n").arg(timestamp, title, text), true);
+        return;
+    }
+    QMessageBox::warning(this, title, text);
+}
+
+// Unique diagnostics of the current batch (the table filters do not change the counts)
+void MainWindow::updateDiagnosticCounts()
+{
+    DiagnosticTable* diagnostics = m_executor->diagnostics();
+    ui->labDiagCounts->setText(QString("%1 errors, %2 warnings").arg(diagnostics->errorCount()).arg(diagnostics->warningCount()));
+}
+
+// Build every ticked GPU model x config x bitness x firmware combination in one scheduled batch
+void MainWindow::buildMatrix()
+{
+    if (!FilePathSelector::isPathValid(m_projctPath)) {
+        QMessageBox::warning(this, "Invalid Path", "Please select a valid project directory first!");
+        return;
+    }
+
+    MatrixAxes axes;
+    if (ui->cbMatrixG0M->isChecked()) axes.gpus << BuildOptions::G0M;
+    if (ui->cbMatrixG3->isChecked()) axes.gpus << BuildOptions::G3;
+    if (ui->cbMatrixG1P->isChecked()) axes.gpus << BuildOptions::G1P;
+    if (ui->cbMatrixDebug->isChecked()) axes.configs << BuildOptions::Debug;
+    if (ui->cbMatrixRelease->isChecked()) axes.configs << BuildOptions::Release;
+    if (ui->cbMatrix32Bit->isChecked()) axes.bits << BuildOptions::Bit32;
+    if (ui->cbMatrix64Bit->isChecked()) axes.bits << BuildOptions::Bit64;
+    if (ui->cbMatrixFW116->isChecked()) axes.firmwares << BuildOptions::Firmware116;
+    if (ui->cbMatrixFW119->isChecked()) axes.firmwares << BuildOptions::Firmware119;
+
+    if (axes.gpus.isEmpty() || axes.configs.isEmpty() || axes.bits.isEmpty() || axes.firmwares.isEmpty()) {
+        QMessageBox::warning(this, "Build Matrix", "Please tick at least one GPU model, config, architecture and firmware!");
+        return;
+    }
+
+    // Build type, driver type and feature switches come from the Manually Build selection
+    BuildOptions base;
+    base.buildType      = m_buildType;
+    base.driver         = m_driverType;
+    base.forceDeleteKMD = m_isForceDelKMD;
+    base.uniq           = m_uniq;
+    base.pvr            = m_pvr;
+    base.stat           = m_stat;
+    base.generator      = m_generator;
+    base.compilerLauncher = m_compilerLauncher;
+    m_executor->setCompilerLauncher(m_compilerLauncher);
+    m_executor->setFailFastEnabled(ui->cbFailFast->isChecked());
+
+    QString workDir = ui->cbProjectPath->currentText();
+    QList<PlannedJob> jobs = BuildMatrix::expand(base, axes, workDir);
+    if (jobs.isEmpty()) {
+        QMessageBox::warning(this, "Build Matrix", "Nothing to build for the selected combination!");
+        return;
+    }
+
+    // As many combinations as cores and memory allow; jobs sharing a build dir still run one after another
+    QSettings matrixSettings("EazyBuild", "Matrix");
+    int concurrentJobs = BuildMatrix::recommendedConcurrentJobs(matrixSettings.value("CoresPerJob", 4).toInt(),
+                                                                matrixSettings.value("MemoryPerJobMB", 4096).toInt());
+
+    setButtonState(false);
+    ui->bClear->click();
+
+    QString timestamp = QDateTime::currentDateTime().toString("[yyyy-MM-dd hh:mm:ss]");
+    on_logUpdated(QString("%1 📊 Build matrix: %2 jobs, up to %3 at a time\n").arg(timestamp).arg(jobs.size()).arg(concurrentJobs), false);
+
+    m_isMatrixBuild = true;
+    m_isMatrixEnqueuing = true;
+    m_matrix.begin();
+    m_executor->setMaxConcurrentJobs(concurrentJobs);
+    for (const PlannedJob& job : jobs) {
+        int jobId = m_executor->enqueueJob(job.name, job.nodes, job.copyTasks, job.delTasks, job.workDir, false);
+        m_matrix.addJob(jobId, job);
+    }
+    m_isMatrixEnqueuing = false;
+
+    // Every job finished while queueing (all artifacts restored from cache)
+    if (!m_executor->isExecuting()) {
+        onCommandFinished(m_matrix.failedCount() == 0, "", "");
+    }
+}
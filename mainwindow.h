@@ -3,10 +3,18 @@
 
 #include <QMainWindow>
 #include <QButtonGroup>
+#include <QTimer>
+#include <QSortFilterProxyModel>
+#include <QLocalSocket>
+#include <QSet>
+#include <QJsonObject>
 #include "FilePathSelector.h"
 #include "CommandExecutor.h"
 #include "qtextedit.h"
 #include "remoteconfigdialog.h"
+#include "sourcechangetracker.h"
+#include "buildplanner.h"
+#include "buildmatrix.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -22,56 +30,22 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
-    enum BuildType
-    {
-        GPUDriver,
-        FantasyPanel,
-        AllType,
-    };
-
-    enum GPUModel
-    {
-        G0M,
-        G3,
-        G1P,
-    };
-
-    enum DriverType
-    {
-        UMD,
-        KMD,
-        AllDriver,
-    };
-
-    enum BuildConfig
-    {
-        Debug,
-        Release,
-    };
-
-    enum Bit
-    {
-        Bit32,
-        Bit64,
-        AllBit
-    };
-
-    enum FirmwareVersion
-    {
-        Firmware116,
-        Firmware119,
-    };
-
     void connectSignalsAndSlots();
     void setStyleSheet();
     void initUI();
-    bool buildCmd(BuildType btype = AllType, GPUModel gpu = G0M, BuildConfig build = Debug, bool isAutomaticallyReplace = false, DriverType driver = AllDriver, Bit bit = Bit64,
-                  FirmwareVersion fw = Firmware119, bool isForceDeleteKMD = false, bool isUniQ = false, bool isPvr = false, bool isStat = false);
+    bool buildCmd(BuildOptions::BuildType btype = BuildOptions::AllType, BuildOptions::GPUModel gpu = BuildOptions::G0M,
+                  BuildOptions::BuildConfig build = BuildOptions::Debug, bool isAutomaticallyReplace = false,
+                  BuildOptions::DriverType driver = BuildOptions::AllDriver, BuildOptions::Bit bit = BuildOptions::Bit64,
+                  BuildOptions::FirmwareVersion fw = BuildOptions::Firmware119, bool isForceDeleteKMD = false,
+                  bool isUniQ = false, bool isPvr = false, bool isStat = false);
 private slots:
     void on_logUpdated(const QString &logContent, bool isError);
     void onCommandFinished(bool success, const QString &stdoutLog, const QString &stderrLog);
     void setRemoteDeploy(bool checked);  // Enable/disable remote deployment
     void onRemoteConfigClicked();        // Open remote configuration dialog
+    void setWatchMode(bool checked);     // Enable/disable automatic rebuild on source changes
+    void onWatchTimeout();               // Debounce window elapsed: (re)start the watch build
+    void buildMatrix();                  // Build every ticked matrix combination in one batch
 private:
     FilePathSelector *m_projectpathselector = nullptr;
     FilePathSelector *m_targetpathselector  = nullptr;
@@ -86,13 +60,35 @@ private:
     bool             m_uniq                 = false;
     bool             m_pvr                  = false;
     bool             m_stat                 = false;
-    Bit              m_bit                  = Bit64;
-    BuildConfig      m_buildConfig          = Debug;
-    BuildType        m_buildType            = AllType;
-    DriverType       m_driverType           = AllDriver;
-    GPUModel         m_gpuModel             = G0M;
-    FirmwareVersion  m_fwversion            = Firmware119;
+    BuildOptions::Bit             m_bit         = BuildOptions::Bit64;
+    BuildOptions::BuildConfig     m_buildConfig = BuildOptions::Debug;
+    BuildOptions::BuildType       m_buildType   = BuildOptions::AllType;
+    BuildOptions::DriverType      m_driverType  = BuildOptions::AllDriver;
+    BuildOptions::GPUModel        m_gpuModel    = BuildOptions::G0M;
+    BuildOptions::FirmwareVersion m_fwversion   = BuildOptions::Firmware119;
+    CMakeGenerator::Kind          m_generator   = CMakeGenerator::defaultKind();
+    QString          m_compilerLauncher;               // ccache/sccache injected into every configure (empty = none)
     QButtonGroup*    m_configButtonGroup    = nullptr;
+    SourceChangeTracker* m_changeTracker    = nullptr;
+    QHash<int, QHash<QString, QString>> m_chainBuildKeys; // Job id -> (chain -> build key)
+    QHash<int, quint64> m_jobStartSequence;                // Job id -> change sequence when the job was queued
+    QTimer*          m_watchTimer           = nullptr; // Debounce timer of watch mode
+    bool             m_isWatching           = false;   // Watch mode enabled
+    bool             m_isWatchBuild         = false;   // Current build was started by watch mode
+    bool             m_isWatchRestart       = false;   // Stale watch build is being cancelled for a restart
+    bool             m_isWatchPending       = false;   // Changes arrived during a manual build
+    BuildMatrix      m_matrix;                         // Jobs and results of the running matrix batch
+    bool             m_isMatrixBuild        = false;   // Current batch is a build matrix
+    bool             m_isMatrixEnqueuing    = false;   // Matrix jobs are being queued
+    int              m_defaultConcurrentJobs = 2;      // Executor job limit outside matrix batches
+    QSortFilterProxyModel* m_diagSeverityFilter = nullptr; // Diagnostics table filtered by severity
+    QSortFilterProxyModel* m_diagTextFilter     = nullptr; // ... then by free text over all columns
+    QLocalSocket*    m_daemonSocket         = nullptr; // Connection of the build submitted to eazybuild-daemon
+    QByteArray       m_daemonBuffer;                   // Partial event line received from the daemon
+    QSet<int>        m_daemonJobs;                     // Daemon job ids still queued or running
+    int              m_daemonAcceptedJobs   = -1;      // Jobs the daemon accepted (-1 = no reply yet)
+    bool             m_hasDaemonFailure     = false;   // A daemon job failed
+    QString          m_daemonErrors;                   // stderr of the failed daemon jobs
 
     void setProjectPath(const QString& path);
     void setTargetPath(const QString& path);
@@ -107,14 +103,20 @@ private:
     void setUniQ(bool checked);
     void setPvrtune(bool checked);
     void setFirmwareVersion(int index);
+    void setGenerator(int index);
+    void setCompilerLauncher(int index);
     void setButtonState(bool isEnable);
-    void limitLogLines(QTextEdit *logWidget, int maxLines);
+    void reportBuildWarning(const QString &title, const QString &text);
+    void updateDiagnosticCounts();
 
     QString generateCmakeConfigureCmd(const QString &buildDir, const QString &extraParams = "");
-    QString generateCmakeBuildCmd(const QString &buildDir, const QString &buildConfig);
+    bool submitToDaemon(const BuildOptions &options, const QString &workDir, bool isRemote);
+    void onDaemonEvent(const QJsonObject &event);
+    void finishDaemonBuild(bool success, const QString &errorText);
+    bool skipUnchangedChain(const QString &component, const QString &chain, const QString &buildKey, const QStringList &artifacts);
+    void trackJobChains(int jobId, const QHash<QString, QString> &chainKeys);
     QString generateCopyCmd(const QString &srcFile, const QString &targetPath);
     QString generateRemoteCopyCmd(const QString &srcFile, const QString &remotePath);
-    QString joinPath(const QStringList &parts);
 
     Ui::MainWindow *ui;
 };
@@ -0,0 +1,128 @@
+#include "outputcapture.h"
+#include <algorithm>
+#include <QDir>
+#include <QFile>
+
+// Spool files are read back in blocks of this many characters
+static const int SPOOL_READ_CHARS = 512 * 1024;
+
+OutputCapture::OutputCapture(int headLimit, int tailLimit)
+    : m_headLimit(qMax(0, headLimit))
+    , m_tailLimit(qMax(1, tailLimit))
+    , m_tailPos(0)
+    , m_tailSize(0)
+    , m_size(0)
+    , m_spoolFailed(false)
+{
+}
+
+void OutputCapture::append(const QString& chunk)
+{
+    if (chunk.isEmpty()) return;
+
+    // Output is about to outgrow memory: everything so far is still complete, start the spool with it
+    if (!m_spool && !m_spoolFailed && m_size + chunk.size() > m_headLimit + m_tailLimit)
+    {
+        m_spool.reset(new QTemporaryFile(QDir::tempPath() + "/eazybuild_output_XXXXXX.spool"));
+        if (m_spool->open())
+        {
+            spool(m_head + tail());
+        }
+        else
+        {
+            qWarning("OutputCapture: cannot create spool file, only head and tail of the output are kept");
+            m_spool.reset();
+            m_spoolFailed = true;
+        }
+    }
+    if (m_spool) spool(chunk);
+
+    m_size += chunk.size();
+    int headPart = qMin(chunk.size(), m_headLimit - m_head.size());
+    if (headPart > 0) m_head += chunk.left(headPart);
+    if (headPart < chunk.size()) appendToTail(chunk.constData() + headPart, chunk.size() - headPart);
+}
+
+void OutputCapture::reset()
+{
+    m_head.clear();
+    m_tail.clear();
+    m_tailPos = 0;
+    m_tailSize = 0;
+    m_size = 0;
+    m_spool.reset();
+    m_spoolFailed = false;
+}
+
+QString OutputCapture::text() const
+{
+    if (!isTruncated()) return m_head + tail();
+
+    qint64 omitted = m_size - m_head.size() - m_tailSize;
+    return m_head + QString("\n... [%1 characters omitted, complete output in the log file] ...\n").arg(omitted) + tail();
+}
+
+void OutputCapture::writeTo(const std::function<void(const QString&)>& sink) const
+{
+    if (!m_spool)
+    {
+        sink(text());
+        return;
+    }
+
+    m_spool->flush();
+    QFile reader(m_spool->fileName());
+    if (!reader.open(QIODevice::ReadOnly))
+    {
+        sink(text());
+        return;
+    }
+
+    // A surrogate pair split by the block boundary is carried into the next block
+    QString pending;
+    while (!reader.atEnd())
+    {
+        QByteArray block = reader.read(SPOOL_READ_CHARS * 2);
+        QString text = pending + QString(reinterpret_cast<const QChar*>(block.constData()), block.size() / 2);
+        pending.clear();
+        if (!text.isEmpty() && text.at(text.size() - 1).isHighSurrogate())
+        {
+            pending = text.right(1);
+            text.chop(1);
+        }
+        sink(text);
+    }
+    if (!pending.isEmpty()) sink(pending);
+}
+
+void OutputCapture::appendToTail(const QChar* data, int count)
+{
+    if (m_tail.size() != m_tailLimit) m_tail.resize(m_tailLimit);
+    QChar* ring = m_tail.data();
+
+    if (count >= m_tailLimit)
+    {
+        std::copy(data + count - m_tailLimit, data + count, ring);
+        m_tailPos = 0;
+        m_tailSize = m_tailLimit;
+        return;
+    }
+
+    int firstPart = qMin(count, m_tailLimit - m_tailPos);
+    std::copy(data, data + firstPart, ring + m_tailPos);
+    std::copy(data + firstPart, data + count, ring);
+    m_tailPos = (m_tailPos + count) % m_tailLimit;
+    m_tailSize = qMin(m_tailSize + count, m_tailLimit);
+}
+
+// Ring contents in arrival order
+QString OutputCapture::tail() const
+{
+    if (m_tailSize < m_tailLimit) return m_tail.left(m_tailSize);
+    return m_tail.mid(m_tailPos) + m_tail.left(m_tailPos);
+}
+
+void OutputCapture::spool(const QString& text)
+{
+    m_spool->write(reinterpret_cast<const char*>(text.constData()), qint64(text.size()) * 2);
+}
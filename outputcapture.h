@@ -0,0 +1,50 @@
+#ifndef OUTPUTCAPTURE_H
+#define OUTPUTCAPTURE_H
+
+#include <QSharedPointer>
+#include <QString>
+#include <QTemporaryFile>
+#include <functional>
+
+// Bounded capture of one output stream of a running command
+// Memory holds a fixed-size head and a tail ring; once output outgrows both, the complete
+// stream is spooled to a temporary file, so memory stays flat however verbose the build is
+// Copies share the spool file: a copy taken before reset() can still write the full output
+class OutputCapture
+{
+public:
+    explicit OutputCapture(int headLimit = 32 * 1024, int tailLimit = 128 * 1024);
+
+    void append(const QString& chunk);
+
+    // Forget the output (a new command starts); the spool file goes once no copy uses it
+    void reset();
+
+    // Head + tail (with an omission marker when the middle was dropped)
+    QString text() const;
+
+    // Hand the complete output to sink in blocks (read from the spool file when the middle was dropped)
+    // Safe on another thread once no more output is appended to this capture
+    void writeTo(const std::function<void(const QString&)>& sink) const;
+
+    qint64 size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+    bool isTruncated() const { return m_size > m_head.size() + m_tailSize; }
+
+private:
+    void appendToTail(const QChar* data, int count);
+    QString tail() const;
+    void spool(const QString& text);
+
+    int     m_headLimit;
+    int     m_tailLimit;
+    QString m_head;
+    QString m_tail;          // Ring of m_tailLimit characters
+    int     m_tailPos;       // Next write position in the ring
+    int     m_tailSize;      // Valid characters in the ring
+    qint64  m_size;          // Characters appended since reset
+    QSharedPointer<QTemporaryFile> m_spool;  // Complete output as UTF-16 (null = everything fits in memory)
+    bool    m_spoolFailed;   // True = temporary file unavailable, only head and tail are kept
+};
+
+#endif // OUTPUTCAPTURE_H
@@ -0,0 +1,138 @@
+#include "processtree.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QSet>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <tlhelp32.h>
+#else
+#include <signal.h>
+#endif
+
+// Kill the tree rooted at pid
+int ProcessTree::kill(qint64 pid)
+{
+    if (pid <= 0) return 0;
+
+#ifdef Q_OS_WIN
+    // Orphans keep their parent pid in the snapshot, so collect before terminating anything
+    QList<qint64> victims = QList<qint64>() << pid << descendantsOf(pid, childrenByParent());
+    int killed = 0;
+    for (qint64 victim : victims)
+    {
+        HANDLE process = OpenProcess(PROCESS_TERMINATE, FALSE, static_cast<DWORD>(victim));
+        if (process == nullptr) continue;
+        if (TerminateProcess(process, 1)) killed++;
+        CloseHandle(process);
+    }
+    return killed;
+#else
+    // Freeze the tree level by level, rescanning until no new descendants show up
+    QSet<qint64> stopped;
+    QList<qint64> victims;
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        QList<qint64> tree = QList<qint64>() << pid << descendantsOf(pid, childrenByParent());
+        bool hasNewProcess = false;
+        for (qint64 process : tree)
+        {
+            if (stopped.contains(process)) continue;
+            ::kill(static_cast<pid_t>(process), SIGSTOP);
+            stopped.insert(process);
+            victims << process;
+            hasNewProcess = true;
+        }
+        if (!hasNewProcess) break;
+    }
+
+    int killed = 0;
+    for (qint64 victim : victims)
+    {
+        if (::kill(static_cast<pid_t>(victim), SIGKILL) == 0) killed++;
+    }
+    return killed;
+#endif
+}
+
+// Snapshot parent -> child relations of all processes
+QMultiHash<qint64, qint64> ProcessTree::childrenByParent()
+{
+    QMultiHash<qint64, qint64> children;
+
+#ifdef Q_OS_WIN
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+    if (snapshot == INVALID_HANDLE_VALUE) return children;
+    PROCESSENTRY32W entry;
+    entry.dwSize = sizeof(entry);
+    for (BOOL hasEntry = Process32FirstW(snapshot, &entry); hasEntry; hasEntry = Process32NextW(snapshot, &entry))
+    {
+        if (entry.th32ProcessID != entry.th32ParentProcessID)
+        {
+            children.insert(entry.th32ParentProcessID, entry.th32ProcessID);
+        }
+    }
+    CloseHandle(snapshot);
+#else
+    QDir proc("/proc");
+    if (QFileInfo::exists("/proc/self/stat"))
+    {
+        const QStringList entries = proc.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+        for (const QString& entry : entries)
+        {
+            bool isPid = false;
+            qint64 pid = entry.toLongLong(&isPid);
+            if (!isPid) continue;
+
+            QFile stat(proc.filePath(entry + "/stat"));
+            if (!stat.open(QIODevice::ReadOnly)) continue;
+            // "pid (comm) state ppid ...": comm may contain spaces and parentheses
+            QByteArray line = stat.readAll();
+            int commEnd = line.lastIndexOf(')');
+            if (commEnd < 0) continue;
+            QList<QByteArray> fields = line.mid(commEnd + 2).split(' ');
+            if (fields.size() < 2) continue;
+            children.insert(fields[1].toLongLong(), pid);
+        }
+    }
+    else
+    {
+        QProcess ps;
+        ps.start("ps", QStringList() << "-A" << "-o" << "pid=" << "-o" << "ppid=");
+        if (!ps.waitForFinished(3000)) return children;
+        const QList<QByteArray> lines = ps.readAllStandardOutput().split('\n');
+        for (const QByteArray& line : lines)
+        {
+            QList<QByteArray> fields = line.simplified().split(' ');
+            if (fields.size() < 2) continue;
+            children.insert(fields[1].toLongLong(), fields[0].toLongLong());
+        }
+    }
+#endif
+
+    return children;
+}
+
+// Breadth-first walk of the snapshot
+QList<qint64> ProcessTree::descendantsOf(qint64 pid, const QMultiHash<qint64, qint64>& children)
+{
+    QList<qint64> descendants;
+    QSet<qint64> seen;
+    seen.insert(pid);
+    QList<qint64> queue = QList<qint64>() << pid;
+    while (!queue.isEmpty())
+    {
+        qint64 parent = queue.takeFirst();
+        const QList<qint64> direct = children.values(parent);
+        for (qint64 child : direct)
+        {
+            if (seen.contains(child)) continue;
+            seen.insert(child);
+            descendants << child;
+            queue << child;
+        }
+    }
+    return descendants;
+}
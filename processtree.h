@@ -0,0 +1,37 @@
+#ifndef PROCESSTREE_H
+#define PROCESSTREE_H
+
+#include <QList>
+#include <QMultiHash>
+
+/**
+ * @brief Kills a process together with every process it spawned
+ * @note QProcess::kill() only reaches the direct child; cmake --build leaves ninja/make/MSBuild
+ *       and their compilers and linkers running behind it
+ * @note Linux: /proc, macOS: ps, Windows: Toolhelp snapshot
+ * @note The snapshot helpers are public for callers walking trees themselves (resource sampling)
+ */
+class ProcessTree
+{
+public:
+    /**
+     * @brief Kill a process and all of its descendants
+     * @param pid Process id of the tree root
+     * @return Number of processes killed
+     * @note POSIX: the tree is frozen with SIGSTOP first so it cannot fork new children while being collected
+     */
+    static int kill(qint64 pid);
+
+    /**
+     * @brief Snapshot of all processes of the system
+     * @return Parent pid -> child pids
+     */
+    static QMultiHash<qint64, qint64> childrenByParent();
+
+    /**
+     * @brief Collect all descendants of a process (children before grandchildren)
+     */
+    static QList<qint64> descendantsOf(qint64 pid, const QMultiHash<qint64, qint64>& children);
+};
+
+#endif // PROCESSTREE_H
@@ -190,147 +190,3 @@ void RemoteConfigDialog::onTestConnection()
                                   .arg(remoteIp).arg(remotePort).arg(socket.error()).arg(socket.errorString()));
     }
 }
-
-// Core function: Send local file to remote receiver via TCP (no Python/SMB dependency)
-// Parameters:
-//   - remoteIp: IP address of the remote receiver server
-//   - port: TCP port number of the remote receiver (must match server's listening port)
-//   - localFilePath: Full path of the local file to be transferred
-//   - remoteSavePath: Full target path to save the file on remote machine (including filename)
-// Return: true if transfer succeeds, false if any error occurs
-bool RemoteConfigDialog::sendFileToRemote(
-    const QString& remoteIp,
-    int port,
-    const QString& localFilePath,
-    const QString& remoteSavePath
-    ) {
-    // 1. Validate local file existence and read permission
-    QFile localFile(localFilePath);
-    if (!localFile.exists()) {
-        QMessageBox::warning(this, "Error", QString("Local file not found:\n%1").arg(localFilePath));
-        return false;
-    }
-    if (!localFile.open(QIODevice::ReadOnly)) {
-        QMessageBox::warning(this, "Error", QString("Cannot open file:\n%1").arg(localFile.errorString()));
-        return false;
-    }
-    qint64 totalFileSize = localFile.size(); // Get total file size (critical for transfer completion check)
-    qInfo() << "Local file size:" << totalFileSize << "bytes";
-
-    // 2. Establish TCP connection to remote server
-    QTcpSocket socket;
-    socket.connectToHost(QHostAddress(remoteIp), port);
-    if (!socket.waitForConnected(5000)) { // 5-second connection timeout
-        QMessageBox::critical(this, "Connection Failed",
-                              QString("Cannot connect to %1:%2\n%3").arg(remoteIp).arg(port).arg(socket.errorString()));
-        localFile.close();
-        socket.disconnectFromHost();
-        return false;
-    }
-
-    // 3. Send metadata: Step 1 - Remote save path (protocol: 4-byte length header + UTF-8 encoded path)
-    QByteArray pathData = remoteSavePath.toUtf8();
-    quint32 pathLen = pathData.size();
-    QByteArray lenBytes;
-    QDataStream lenStream(&lenBytes, QIODevice::WriteOnly);
-    lenStream.setByteOrder(QDataStream::BigEndian); // Match server's byte order (big-endian)
-    lenStream << pathLen;
-
-    // Send path length header (ensure complete write to socket buffer)
-    if (socket.write(lenBytes) == -1 || !socket.waitForBytesWritten(2000)) {
-        QMessageBox::critical(this, "Metadata Failed", "Failed to send path length");
-        localFile.close();
-        socket.disconnectFromHost();
-        return false;
-    }
-    // Send actual remote path content
-    if (socket.write(pathData) == -1 || !socket.waitForBytesWritten(2000)) {
-        QMessageBox::critical(this, "Metadata Failed", "Failed to send remote path");
-        localFile.close();
-        socket.disconnectFromHost();
-        return false;
-    }
-
-    // 4. Send metadata: Step 2 - File size (4-byte big-endian header, required for server completion check)
-    QByteArray sizeBytes;
-    QDataStream sizeStream(&sizeBytes, QIODevice::WriteOnly);
-    sizeStream.setByteOrder(QDataStream::BigEndian);
-    sizeStream << (quint32)totalFileSize; // Convert to 32-bit unsigned (matches server's data type)
-    if (socket.write(sizeBytes) == -1 || !socket.waitForBytesWritten(2000)) {
-        QMessageBox::critical(this, "Metadata Failed", "Failed to send file size");
-        localFile.close();
-        socket.disconnectFromHost();
-        return false;
-    }
-
-    // 5. Send file data (optimized with larger buffer, retry mechanism and progress tracking)
-    qint64 totalBytesSent = 0;
-    const int bufferSize = 4096; // Increased buffer to 4KB (improves transfer efficiency, reduces write frequency)
-    const int maxRetries = 3;    // Maximum retry attempts for failed writes
-    QByteArray buffer;
-
-    while (!(buffer = localFile.read(bufferSize)).isEmpty()) {
-        // Check TCP connection status before each write operation
-        if (socket.state() != QTcpSocket::ConnectedState) {
-            QMessageBox::critical(this, "Transfer Failed", "Socket disconnected during transfer!");
-            localFile.close();
-            socket.disconnectFromHost();
-            return false;
-        }
-
-        // Write logic with retry mechanism (handle transient network errors)
-        int retryCount = 0;
-        qint64 bytesWritten = -1;
-        while (retryCount < maxRetries && bytesWritten == -1) {
-            bytesWritten = socket.write(buffer);
-            if (bytesWritten == -1) {
-                retryCount++;
-                qWarning() << "Write failed, retry" << retryCount << "/" << maxRetries;
-                QThread::msleep(100); // Short delay before retry (100ms)
-            }
-        }
-        // Final failure handling after all retries exhausted
-        if (bytesWritten == -1) {
-            QMessageBox::critical(this, "Transfer Failed",
-                                  QString("Failed to write data after %1 retries!\n%2").arg(maxRetries).arg(socket.errorString()));
-            localFile.close();
-            socket.disconnectFromHost();
-            return false;
-        }
-
-        // Ensure data is fully written to network buffer (extended timeout to 3 seconds)
-        if (!socket.waitForBytesWritten(3000)) {
-            QMessageBox::critical(this, "Transfer Failed", "Timeout waiting for bytes written");
-            localFile.close();
-            socket.disconnectFromHost();
-            return false;
-        }
-
-        totalBytesSent += bytesWritten;
-        qDebug() << "Sent:" << totalBytesSent << "/" << totalFileSize << "bytes"; // Log transfer progress
-    }
-
-    // 6. Wait for server acknowledgment (extended timeout to 10 seconds for large files)
-    localFile.close();
-    qInfo() << "All data sent, waiting for server ACK...";
-    if (!socket.waitForReadyRead(10000)) {
-        QMessageBox::critical(this, "Transfer Failed", "Timeout waiting for server confirmation");
-        socket.disconnectFromHost();
-        return false;
-    }
-
-    // 7. Process server acknowledgment response
-    QByteArray ack = socket.readAll();
-    if (ack == "OK") {
-        QMessageBox::information(this, "Success",
-                                 QString("File transferred successfully!\nTotal size: %1 bytes\nRemote path: %2")
-                                     .arg(totalBytesSent).arg(remoteSavePath));
-    } else {
-        QMessageBox::critical(this, "Transfer Failed",
-                              QString("Receiver returned error:\n%1").arg(ack.isEmpty() ? "No response" : ack));
-    }
-
-    // Clean up: Disconnect socket after transfer completion/failure
-    socket.disconnectFromHost();
-    return true;
-}
@@ -19,7 +19,6 @@ public:
     // Get saved remote configuration
     QString remoteHost() const { return m_leHost->text().trimmed(); }
     QString remotePath() const { return m_leRemotePath->text().trimmed(); }
-    bool sendFileToRemote(const QString &remoteIp, int port, const QString &localFilePath, const QString &remoteSavePath);
 
 private slots:
     // Test remote connection
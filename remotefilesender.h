@@ -0,0 +1,21 @@
+#ifndef REMOTEFILESENDER_H
+#define REMOTEFILESENDER_H
+
+#include <QString>
+
+// Sends a file to the RemoteReceiver over TCP (QtNetwork only, usable without widgets)
+class RemoteFileSender
+{
+public:
+    // Transfer one file
+    // Parameters:
+    //   - remoteIp: IP address of the remote receiver server
+    //   - port: TCP port number of the remote receiver (must match server's listening port)
+    //   - localFilePath: Full path of the local file to be transferred
+    //   - remoteSavePath: Full target path to save the file on remote machine (including filename)
+    //   - errorMsg: Failure reason (empty on success)
+    // Return: true if the receiver acknowledged the file, false if any error occurs
+    static bool sendFile(const QString &remoteIp, int port, const QString &localFilePath, const QString &remoteSavePath, QString &errorMsg);
+};
+
+#endif // REMOTEFILESENDER_H
@@ -0,0 +1,301 @@
+#include "resourceusage.h"
+#include "processtree.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+// History file size at which the oldest half of the records is dropped
+static const qint64 MAX_HISTORY_BYTES = 32 * 1024 * 1024;
+
+void ResourceUsage::add(const ResourceUsage& other)
+{
+    // Unknown (-1) values do not count; wall time adds up to command time, not elapsed time
+    auto sum = [](qint64& total, qint64 value) {
+        if (value >= 0) total = qMax<qint64>(total, 0) + value;
+    };
+    wallMs += other.wallMs;
+    sum(userMs, other.userMs);
+    sum(systemMs, other.systemMs);
+    sum(readBytes, other.readBytes);
+    sum(writeBytes, other.writeBytes);
+    sum(contextSwitches, other.contextSwitches);
+    peakMemoryKb = qMax(peakMemoryKb, other.peakMemoryKb);
+    commands += other.commands;
+}
+
+QString ResourceUsage::summary() const
+{
+    auto seconds = [](qint64 ms) { return QString::number(ms / 1000.0, 'f', 1) + "s"; };
+    auto megabytes = [](qint64 bytes) { return QString::number(bytes / (1024.0 * 1024.0), 'f', bytes < 10 * 1024 * 1024 ? 1 : 0) + " MB"; };
+
+    QStringList parts;
+    parts << "wall " + seconds(wallMs);
+    if (userMs >= 0 && systemMs >= 0) parts << QString("cpu %1 user + %2 sys").arg(seconds(userMs), seconds(systemMs));
+    if (peakMemoryKb >= 0) parts << "peak " + megabytes(peakMemoryKb * 1024);
+    if (readBytes >= 0) parts << "read " + megabytes(readBytes);
+    if (writeBytes >= 0) parts << "write " + megabytes(writeBytes);
+    if (contextSwitches >= 0) parts << QString("%1 ctx switches").arg(contextSwitches);
+    return parts.join(", ");
+}
+
+QJsonObject ResourceUsage::toJson() const
+{
+    QJsonObject obj;
+    obj.insert("wallMs", wallMs);
+    obj.insert("userMs", userMs);
+    obj.insert("systemMs", systemMs);
+    obj.insert("peakMemoryKb", peakMemoryKb);
+    obj.insert("readBytes", readBytes);
+    obj.insert("writeBytes", writeBytes);
+    obj.insert("contextSwitches", contextSwitches);
+    obj.insert("commands", commands);
+    return obj;
+}
+
+#ifdef Q_OS_LINUX
+static QByteArray readProcFile(qint64 pid, const char* name)
+{
+    QFile file(QString("/proc/%1/%2").arg(pid).arg(QLatin1String(name)));
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+// Number after "key:" in /proc/<pid>/status or /proc/<pid>/io (0 = missing)
+static qint64 procField(const QByteArray& text, const QByteArray& key)
+{
+    int pos = text.startsWith(key) ? 0 : text.indexOf("\n" + key);
+    if (pos < 0) return 0;
+    if (pos > 0) pos++;
+    int end = text.indexOf('\n', pos);
+    return text.mid(pos + key.size(), end < 0 ? -1 : end - pos - key.size()).simplified().split(' ').first().toLongLong();
+}
+#endif
+
+#ifdef Q_OS_WIN
+// Totals of every process that ever ran in the job
+static void queryJob(void* jobHandle, ResourceUsage& usage)
+{
+    HANDLE job = static_cast<HANDLE>(jobHandle);
+    // Times in 100 ns units
+    JOBOBJECT_BASIC_AND_IO_ACCOUNTING_INFORMATION accounting;
+    if (QueryInformationJobObject(job, JobObjectBasicAndIoAccountingInformation, &accounting, sizeof(accounting), nullptr))
+    {
+        usage.userMs = accounting.BasicInfo.TotalUserTime.QuadPart / 10000;
+        usage.systemMs = accounting.BasicInfo.TotalKernelTime.QuadPart / 10000;
+        usage.readBytes = static_cast<qint64>(accounting.IoInfo.ReadTransferCount);
+        usage.writeBytes = static_cast<qint64>(accounting.IoInfo.WriteTransferCount);
+    }
+    JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits;
+    if (QueryInformationJobObject(job, JobObjectExtendedLimitInformation, &limits, sizeof(limits), nullptr))
+    {
+        usage.peakMemoryKb = static_cast<qint64>(limits.PeakJobMemoryUsed / 1024);
+    }
+}
+#endif
+
+bool ResourceMonitor::needsSampling()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ResourceMonitor::start(qint64 pid)
+{
+#ifdef Q_OS_WIN
+    if (m_job) CloseHandle(static_cast<HANDLE>(m_job));
+    m_job = nullptr;
+#endif
+    m_pid = pid;
+    m_memoryKb = 0;
+    m_usage = ResourceUsage();
+    m_usage.commands = 1;
+    m_timer.start();
+
+#ifdef Q_OS_WIN
+    // Children inherit the job; only those spawned before the assignment (a few instructions in) escape it
+    if (pid <= 0) return;
+    HANDLE job = CreateJobObjectW(nullptr, nullptr);
+    HANDLE process = OpenProcess(PROCESS_SET_QUOTA | PROCESS_TERMINATE, FALSE, static_cast<DWORD>(pid));
+    if (job != nullptr && process != nullptr && AssignProcessToJobObject(job, process))
+    {
+        m_job = job;
+    }
+    else if (job != nullptr)
+    {
+        CloseHandle(job);
+    }
+    if (process != nullptr) CloseHandle(process);
+#endif
+}
+
+ResourceMonitor::Sample ResourceMonitor::measure(qint64 pid, const QMultiHash<qint64, qint64>& children)
+{
+    Sample sample;
+    sample.pid = pid;
+#ifdef Q_OS_LINUX
+    if (pid <= 0) return sample;
+    static const qint64 ticksPerSecond = sysconf(_SC_CLK_TCK);
+    static const qint64 pageKb = sysconf(_SC_PAGESIZE) / 1024;
+
+    qint64 userTicks = 0;
+    qint64 systemTicks = 0;
+    qint64 residentKb = 0;
+    qint64 peakKb = 0;
+    qint64 readBytes = 0;
+    qint64 writeBytes = 0;
+    qint64 contextSwitches = 0;
+    const QList<qint64> tree = QList<qint64>() << pid << ProcessTree::descendantsOf(pid, children);
+    for (qint64 treePid : tree)
+    {
+        // "pid (comm) state ppid ...": utime, stime, cutime, cstime are fields 14-17, rss is field 24
+        QByteArray stat = readProcFile(treePid, "stat");
+        int commEnd = stat.lastIndexOf(')');
+        if (commEnd < 0) continue;
+        QList<QByteArray> fields = stat.mid(commEnd + 2).split(' ');
+        if (fields.size() < 22) continue;
+        sample.isValid = true;
+        userTicks += fields[11].toLongLong() + fields[13].toLongLong();
+        systemTicks += fields[12].toLongLong() + fields[14].toLongLong();
+        residentKb += fields[21].toLongLong() * pageKb;
+
+        QByteArray status = readProcFile(treePid, "status");
+        peakKb = qMax(peakKb, procField(status, "VmHWM:"));
+        contextSwitches += procField(status, "voluntary_ctxt_switches:") + procField(status, "nonvoluntary_ctxt_switches:");
+        QByteArray io = readProcFile(treePid, "io");
+        readBytes += procField(io, "read_bytes:");
+        writeBytes += procField(io, "write_bytes:");
+    }
+    sample.memoryKb = residentKb;
+    sample.usage.userMs = userTicks * 1000 / ticksPerSecond;
+    sample.usage.systemMs = systemTicks * 1000 / ticksPerSecond;
+    sample.usage.peakMemoryKb = qMax(residentKb, peakKb);
+    sample.usage.readBytes = readBytes;
+    sample.usage.writeBytes = writeBytes;
+    sample.usage.contextSwitches = contextSwitches;
+#else
+    Q_UNUSED(children);
+#endif
+    return sample;
+}
+
+void ResourceMonitor::add(const Sample& sample)
+{
+    if (!sample.isValid || sample.pid != m_pid || m_pid <= 0) return;
+    m_memoryKb = sample.memoryKb;
+
+    // Counters of a process vanish when it is reaped: keep the largest totals seen
+    m_usage.userMs = qMax(m_usage.userMs, sample.usage.userMs);
+    m_usage.systemMs = qMax(m_usage.systemMs, sample.usage.systemMs);
+    m_usage.peakMemoryKb = qMax(m_usage.peakMemoryKb, sample.usage.peakMemoryKb);
+    m_usage.readBytes = qMax(m_usage.readBytes, sample.usage.readBytes);
+    m_usage.writeBytes = qMax(m_usage.writeBytes, sample.usage.writeBytes);
+    m_usage.contextSwitches = qMax(m_usage.contextSwitches, sample.usage.contextSwitches);
+}
+
+void ResourceMonitor::sample(const QMultiHash<qint64, qint64>& children)
+{
+#ifdef Q_OS_LINUX
+    add(measure(m_pid, children));
+#elif defined(Q_OS_WIN)
+    Q_UNUSED(children);
+    // Job counters are live; there is no current-memory counter, so the job peak stands in
+    if (!m_job) return;
+    queryJob(m_job, m_usage);
+    m_memoryKb = qMax<qint64>(m_usage.peakMemoryKb, 0);
+#else
+    Q_UNUSED(children);
+#endif
+}
+
+ResourceUsage ResourceMonitor::current() const
+{
+    ResourceUsage usage = m_usage;
+    usage.wallMs = m_timer.isValid() ? m_timer.elapsed() : 0;
+    return usage;
+}
+
+ResourceUsage ResourceMonitor::finish()
+{
+    ResourceUsage usage = m_usage;
+    usage.wallMs = m_timer.isValid() ? m_timer.elapsed() : 0;
+
+#ifdef Q_OS_WIN
+    if (m_job)
+    {
+        queryJob(m_job, usage);
+        CloseHandle(static_cast<HANDLE>(m_job));
+        m_job = nullptr;
+    }
+#endif
+
+    m_pid = 0;
+    return usage;
+}
+
+CommandHistory::CommandHistory(const QString& filePath)
+    : m_filePath(filePath)
+{
+    if (m_filePath.isEmpty())
+    {
+        QString dataLocation = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation);
+        if (dataLocation.isEmpty())
+        {
+            dataLocation = QDir::homePath() + "/.local/share";
+        }
+        m_filePath = dataLocation + "/EazyBuild/command_history.jsonl";
+    }
+    m_writer.setMaxThreadCount(1);
+}
+
+void CommandHistory::append(const QString& job, const QString& command, int exitCode, const ResourceUsage& usage)
+{
+    QJsonObject record = usage.toJson();
+    record.insert("time", QDateTime::currentDateTime().toString(Qt::ISODate));
+    record.insert("job", job);
+    record.insert("command", command);
+    record.insert("exitCode", exitCode);
+
+    QString filePath = m_filePath;
+    QByteArray line = QJsonDocument(record).toJson(QJsonDocument::Compact) + "\n";
+    m_writer.start([filePath, line]() { write(filePath, line); });
+}
+
+void CommandHistory::write(const QString& filePath, const QByteArray& record)
+{
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) return;
+    file.write(record);
+    bool isFull = file.size() > MAX_HISTORY_BYTES;
+    file.close();
+    if (isFull) trim(filePath);
+}
+
+void CommandHistory::trim(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) return;
+    QByteArray records = file.readAll();
+    file.close();
+
+    // Cut at a record boundary
+    int cut = records.indexOf('\n', records.size() / 2);
+    if (cut < 0) return;
+    QSaveFile trimmed(filePath);
+    if (!trimmed.open(QIODevice::WriteOnly)) return;
+    trimmed.write(records.constData() + cut + 1, records.size() - cut - 1);
+    trimmed.commit();
+}
@@ -0,0 +1,110 @@
+#ifndef RESOURCEUSAGE_H
+#define RESOURCEUSAGE_H
+
+#include <QJsonObject>
+#include <QMetaType>
+#include <QMultiHash>
+#include <QString>
+#include <QElapsedTimer>
+#include <QThreadPool>
+
+// Resources used by a command and every process it spawned
+// -1 = not measured on this platform (or the command ended before the first sample)
+struct ResourceUsage
+{
+    qint64 wallMs          = 0;
+    qint64 userMs          = -1;  // User CPU time of the whole tree
+    qint64 systemMs        = -1;  // Kernel CPU time of the whole tree
+    qint64 peakMemoryKb    = -1;  // Linux: peak resident set of the tree; Windows: peak committed memory of the job
+    qint64 readBytes       = -1;  // Linux: block device reads; Windows: all read I/O
+    qint64 writeBytes      = -1;  // Linux: block device writes; Windows: all write I/O
+    qint64 contextSwitches = -1;  // Voluntary + involuntary (Linux only)
+    int    commands        = 0;   // Commands summed up (1 for a single command)
+
+    // Sum of two usages (peak memory: the larger one), e.g. the total of a batch
+    void add(const ResourceUsage& other);
+
+    // "wall 12.3s, cpu 40.1s user + 3.2s sys, peak 512 MB, read 10 MB, write 200 MB, 1234 ctx switches"
+    QString summary() const;
+
+    QJsonObject toJson() const;
+};
+
+Q_DECLARE_METATYPE(ResourceUsage)
+
+// Accounting of one running command's process tree
+// Windows: the command runs in a job object, whose counters cover every process of the tree exactly
+// Linux: the tree is sampled from /proc; CPU and I/O of exited children reach their waiting parent
+//        (cutime/cstime, /proc/<pid>/io), so sampling misses at most the last interval
+// macOS: wall time only
+class ResourceMonitor
+{
+public:
+    // One reading of a running tree (Linux)
+    struct Sample
+    {
+        qint64        pid = 0;          // Root of the tree
+        ResourceUsage usage;            // Totals of the tree when it was read
+        qint64        memoryKb = 0;     // Resident set of the tree
+        bool          isValid = false;  // False = the root is gone (or nothing is read on this platform)
+    };
+
+    // True = the tree has to be sampled periodically while the command runs
+    static bool needsSampling();
+
+    // Read the tree of pid from /proc (children: ProcessTree::childrenByParent())
+    // Touches no monitor: the executor takes its samples on a worker thread
+    static Sample measure(qint64 pid, const QMultiHash<qint64, qint64>& children);
+
+    // Start accounting of a started process (forgets the previous command)
+    void start(qint64 pid);
+
+    // Root of the monitored tree (0 = no command running)
+    qint64 pid() const { return m_pid; }
+
+    // Add a reading of the running tree (readings of another command are ignored)
+    void add(const Sample& sample);
+
+    // Add a snapshot of the running tree on the calling thread (children: unused on Windows)
+    void sample(const QMultiHash<qint64, qint64>& children);
+
+    // Usage so far of the running command (as of the last sample)
+    ResourceUsage current() const;
+
+    // Memory of the running tree at the last sample (Linux: resident set; Windows: job peak)
+    qint64 memoryKb() const { return m_memoryKb; }
+
+    // Usage of the finished command
+    ResourceUsage finish();
+
+private:
+    QElapsedTimer m_timer;
+    qint64        m_pid = 0;
+    qint64        m_memoryKb = 0;
+    void*         m_job = nullptr;  // Windows job object (released by finish() or the next start())
+    ResourceUsage m_usage;          // Largest totals sampled so far
+};
+
+// Append-only history of per-command resource usage (JSON lines, survives restarts)
+// Default location: <generic data location>/EazyBuild/command_history.jsonl
+class CommandHistory
+{
+public:
+    explicit CommandHistory(const QString& filePath = QString());
+
+    // The record is written on a background thread (records keep their order)
+    void append(const QString& job, const QString& command, int exitCode, const ResourceUsage& usage);
+
+    QString filePath() const { return m_filePath; }
+
+private:
+    static void write(const QString& filePath, const QByteArray& record);
+
+    // The oldest half of the records goes once the file outgrows its limit
+    static void trim(const QString& filePath);
+
+    QString     m_filePath;
+    QThreadPool m_writer;   // Single thread, so appends and trims never overlap; waits for pending records when destroyed
+};
+
+#endif // RESOURCEUSAGE_H
@@ -0,0 +1,357 @@
+#include "sourcechangetracker.h"
+#include "artifactcache.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QSocketNotifier>
+#include <QDebug>
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Keep at most this many changes; older history is dropped (affected builds become dirty)
+static const int MAX_CHANGE_HISTORY = 200000;
+
+SourceChangeTracker::SourceChangeTracker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SourceChangeTracker::~SourceChangeTracker()
+{
+    stopWatching();
+}
+
+// Start watching a new source tree
+void SourceChangeTracker::setRoot(const QString& rootPath)
+{
+    QString cleanRoot = rootPath.isEmpty() ? "" : QDir::cleanPath(rootPath);
+    if (cleanRoot == m_rootPath) return;
+
+    stopWatching();
+    m_rootPath = cleanRoot;
+    m_builtSequence.clear();
+    m_changes.clear();
+    m_treeStates.clear();
+    m_overflowSequence = m_sequence;
+
+    if (m_rootPath.isEmpty() || !QDir(m_rootPath).exists()) return;
+    m_reliable = true;
+
+#ifdef Q_OS_LINUX
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0)
+    {
+        qWarning() << "inotify_init1 failed, source change tracking disabled";
+        m_reliable = false;
+        return;
+    }
+    m_inotifyNotifier = new QSocketNotifier(m_inotifyFd, QSocketNotifier::Read, this);
+    connect(m_inotifyNotifier, &QSocketNotifier::activated, this, &SourceChangeTracker::onInotifyActivated);
+#else
+    m_watcher = new QFileSystemWatcher(this);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &SourceChangeTracker::onDirectoryChanged);
+#endif
+
+    watchTree(m_rootPath);
+}
+
+// Release watches of the current tree
+void SourceChangeTracker::stopWatching()
+{
+#ifdef Q_OS_LINUX
+    if (m_inotifyNotifier != nullptr)
+    {
+        delete m_inotifyNotifier;
+        m_inotifyNotifier = nullptr;
+    }
+    if (m_inotifyFd >= 0)
+    {
+        ::close(m_inotifyFd); // Closing the instance drops every watch
+        m_inotifyFd = -1;
+    }
+    m_watchDirs.clear();
+#endif
+    if (m_watcher != nullptr)
+    {
+        delete m_watcher;
+        m_watcher = nullptr;
+    }
+    m_snapshots.clear();
+    m_reliable = false;
+}
+
+void SourceChangeTracker::setComponentPaths(const QString& component, const QStringList& relativePrefixes)
+{
+    QStringList cleanPrefixes;
+    for (const QString& prefix : relativePrefixes)
+    {
+        cleanPrefixes << QDir::cleanPath(prefix);
+    }
+    m_componentPaths.insert(component, cleanPrefixes);
+}
+
+void SourceChangeTracker::markBuilt(const QString& buildKey, quint64 sequence)
+{
+    m_builtSequence.insert(buildKey, sequence);
+}
+
+// Walk changes newer than the last successful build of the key
+bool SourceChangeTracker::hasChangesSince(const QString& component, const QString& buildKey) const
+{
+    if (!m_reliable) return true;
+
+    auto built = m_builtSequence.constFind(buildKey);
+    if (built == m_builtSequence.constEnd()) return true;
+    if (built.value() < m_overflowSequence) return true;
+
+    for (int i = m_changes.size() - 1; i >= 0 && m_changes[i].sequence > built.value(); --i)
+    {
+        if (affects(component, m_changes[i].relativePath)) return true;
+    }
+    return false;
+}
+
+// Changes inside a component's subtrees affect only that component, everything else is shared
+bool SourceChangeTracker::affects(const QString& component, const QString& relativePath) const
+{
+    bool ownedByOther = false;
+    for (auto it = m_componentPaths.constBegin(); it != m_componentPaths.constEnd(); ++it)
+    {
+        for (const QString& prefix : it.value())
+        {
+            if (relativePath == prefix || relativePath.startsWith(prefix + "/"))
+            {
+                if (it.key() == component) return true;
+                ownedByOther = true;
+            }
+        }
+    }
+    return !ownedByOther;
+}
+
+// Build output and VCS folders are never watched
+bool SourceChangeTracker::isExcludedDir(const QString& name)
+{
+    return name.startsWith("cmake_build_") || name == ".git" || name == ".vs" || name == ".svn";
+}
+
+// Watch a directory and all its (non-excluded) subdirectories
+void SourceChangeTracker::watchTree(const QString& dirPath)
+{
+    QStringList pending;
+    pending << dirPath;
+    QStringList portableDirs;
+
+    while (!pending.isEmpty())
+    {
+        QString current = pending.takeLast();
+        if (m_inotifyFd >= 0)
+        {
+            if (!watchDirectory(current)) return;
+        }
+        else
+        {
+            portableDirs << current;
+            snapshotDirectory(current);
+        }
+
+        const QStringList subDirs = QDir(current).entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden);
+        for (const QString& subDir : subDirs)
+        {
+            if (!isExcludedDir(subDir)) pending << current + "/" + subDir;
+        }
+    }
+
+    if (m_watcher != nullptr && !portableDirs.isEmpty())
+    {
+        QStringList failed = m_watcher->addPaths(portableDirs);
+        if (!failed.isEmpty())
+        {
+            qWarning() << "Failed to watch" << failed.size() << "directories, source change tracking disabled";
+            m_reliable = false;
+        }
+    }
+}
+
+// Add one inotify watch (false = watch limit reached, tracking becomes unreliable)
+bool SourceChangeTracker::watchDirectory(const QString& dirPath)
+{
+#ifdef Q_OS_LINUX
+    int wd = inotify_add_watch(m_inotifyFd, QFile::encodeName(dirPath).constData(),
+                               IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_DELETE |
+                               IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR);
+    if (wd < 0)
+    {
+        qWarning() << "inotify_add_watch failed for" << dirPath << "(errno" << errno << "), source change tracking disabled";
+        m_reliable = false;
+        return false;
+    }
+    m_watchDirs.insert(wd, dirPath);
+    return true;
+#else
+    Q_UNUSED(dirPath);
+    return false;
+#endif
+}
+
+// The tracker excludes the same folders as sourceTreeState, so an unchanged sequence means an unchanged state
+QByteArray SourceChangeTracker::treeStateOf(const QString& dir)
+{
+    bool isTracked = m_reliable && !m_rootPath.isEmpty() && (dir == m_rootPath || dir.startsWith(m_rootPath + "/"));
+    if (isTracked)
+    {
+        auto it = m_treeStates.constFind(dir);
+        if (it != m_treeStates.constEnd() && it.value().first == m_sequence) return it.value().second;
+    }
+
+    QByteArray state = ArtifactCache::sourceTreeState(dir);
+    if (isTracked) m_treeStates.insert(dir, qMakePair(m_sequence, state));
+    return state;
+}
+
+// Only the inotify backend can be polled; QFileSystemWatcher reports through the event loop
+void SourceChangeTracker::flushPendingEvents()
+{
+#ifdef Q_OS_LINUX
+    if (m_inotifyFd >= 0)
+    {
+        onInotifyActivated();
+    }
+#endif
+}
+
+// Drain inotify events and record changed paths
+void SourceChangeTracker::onInotifyActivated()
+{
+#ifdef Q_OS_LINUX
+    QStringList changed;
+    QStringList newDirs;
+    char buffer[64 * 1024] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    for (;;)
+    {
+        ssize_t length = ::read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        for (char* ptr = buffer; ptr < buffer + length; )
+        {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // Events were lost: every previous build becomes dirty
+                m_overflowSequence = ++m_sequence;
+                continue;
+            }
+            if (event->mask & IN_IGNORED)
+            {
+                m_watchDirs.remove(event->wd);
+                continue;
+            }
+
+            QString dirPath = m_watchDirs.value(event->wd);
+            if (dirPath.isEmpty()) continue;
+            QString name = event->len > 0 ? QFile::decodeName(event->name) : QString();
+            if ((event->mask & IN_ISDIR) && isExcludedDir(name)) continue;
+
+            QString absolutePath = name.isEmpty() ? dirPath : dirPath + "/" + name;
+            changed << QDir(m_rootPath).relativeFilePath(absolutePath);
+
+            if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+            {
+                newDirs << absolutePath;
+            }
+        }
+    }
+
+    for (const QString& dir : newDirs)
+    {
+        watchTree(dir);
+    }
+    if (!changed.isEmpty())
+    {
+        changed.removeDuplicates();
+        recordChanges(changed);
+    }
+#endif
+}
+
+// Remember entries of a directory (portable backend compares against it on change)
+void SourceChangeTracker::snapshotDirectory(const QString& dirPath)
+{
+    QHash<QString, qint64> entries;
+    const QFileInfoList infos = QDir(dirPath).entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden);
+    for (const QFileInfo& info : infos)
+    {
+        entries.insert(info.fileName(), info.isDir() ? -1 : info.lastModified().toMSecsSinceEpoch());
+    }
+    m_snapshots.insert(dirPath, entries);
+}
+
+// Portable backend: diff the changed directory against its snapshot
+void SourceChangeTracker::onDirectoryChanged(const QString& path)
+{
+    QHash<QString, qint64> before = m_snapshots.value(path);
+    QStringList changed;
+
+    if (!QDir(path).exists())
+    {
+        // Directory removed: drop snapshots of the whole subtree
+        for (auto it = m_snapshots.begin(); it != m_snapshots.end(); )
+        {
+            if (it.key() == path || it.key().startsWith(path + "/")) it = m_snapshots.erase(it);
+            else ++it;
+        }
+        changed << QDir(m_rootPath).relativeFilePath(path);
+        recordChanges(changed);
+        return;
+    }
+
+    snapshotDirectory(path);
+    const QHash<QString, qint64>& after = m_snapshots[path];
+    for (auto it = after.constBegin(); it != after.constEnd(); ++it)
+    {
+        auto old = before.constFind(it.key());
+        if (old != before.constEnd() && old.value() == it.value()) continue;
+        if (it.value() == -1 && isExcludedDir(it.key())) continue;
+
+        changed << QDir(m_rootPath).relativeFilePath(path + "/" + it.key());
+        if (it.value() == -1 && old == before.constEnd())
+        {
+            watchTree(path + "/" + it.key());
+        }
+    }
+    for (auto it = before.constBegin(); it != before.constEnd(); ++it)
+    {
+        if (!after.contains(it.key())) changed << QDir(m_rootPath).relativeFilePath(path + "/" + it.key());
+    }
+
+    if (!changed.isEmpty()) recordChanges(changed);
+}
+
+// Number and store changes
+void SourceChangeTracker::recordChanges(const QStringList& relativePaths)
+{
+    for (const QString& relativePath : relativePaths)
+    {
+        Change change;
+        change.sequence = ++m_sequence;
+        change.relativePath = relativePath;
+        m_changes.append(change);
+    }
+
+    if (m_changes.size() > MAX_CHANGE_HISTORY)
+    {
+        m_overflowSequence = m_sequence;
+        m_changes.clear();
+    }
+
+    emit sourcesChanged(relativePaths);
+}
@@ -0,0 +1,120 @@
+#ifndef SOURCECHANGETRACKER_H
+#define SOURCECHANGETRACKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+class QFileSystemWatcher;
+class QSocketNotifier;
+
+/**
+ * @brief Background watcher recording which source subtrees changed since the last successful build
+ * @note Linux: native inotify (every directory of the tree, file-level events)
+ * @note Other platforms: QFileSystemWatcher on every directory + rescan of the changed directory
+ * @note Changes are numbered; a build key (build dir + options) remembers the sequence it was built at
+ */
+class SourceChangeTracker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SourceChangeTracker(QObject *parent = nullptr);
+    ~SourceChangeTracker();
+
+    /**
+     * @brief Start watching a source tree (previous tree is released, build history is reset)
+     * @param rootPath Source root (empty = stop watching)
+     */
+    void setRoot(const QString& rootPath);
+    QString root() const { return m_rootPath; }
+
+    /**
+     * @brief Declare the subtrees owned by a component
+     * @param component Component name (e.g. "UMD", "KMD", "Panel")
+     * @param relativePrefixes Subtrees relative to the root (changes anywhere else affect every component)
+     */
+    void setComponentPaths(const QString& component, const QStringList& relativePrefixes);
+
+    /**
+     * @brief Current change sequence (capture it when a build starts)
+     */
+    quint64 currentSequence() const { return m_sequence; }
+
+    /**
+     * @brief Record a successful build
+     * @param buildKey Build dir + options of the build
+     * @param sequence Sequence captured when the build started (edits during the build stay pending)
+     */
+    void markBuilt(const QString& buildKey, quint64 sequence);
+
+    /**
+     * @brief Check whether a component must be rebuilt for a build key
+     * @return True = inputs changed, the key was never built in this session, or tracking is unreliable
+     */
+    bool hasChangesSince(const QString& component, const QString& buildKey) const;
+
+    /**
+     * @brief True while every directory of the tree is watched (watch limit not exceeded)
+     */
+    bool isReliable() const { return m_reliable; }
+
+    /**
+     * @brief ArtifactCache::sourceTreeState of a directory, memoized on the change sequence
+     * @note Walked again only after a change was recorded; directories outside the root and
+     *       unreliable tracking are walked on every call
+     */
+    QByteArray treeStateOf(const QString& dir);
+
+    /**
+     * @brief Record events the kernel already queued but the event loop has not delivered yet
+     * @note Call before deciding on a build so an edit saved right before the request is not missed
+     */
+    void flushPendingEvents();
+
+signals:
+    /**
+     * @brief Emitted when source files changed
+     * @param relativePaths Changed paths relative to the root
+     */
+    void sourcesChanged(const QStringList& relativePaths);
+
+private slots:
+    void onInotifyActivated();
+    void onDirectoryChanged(const QString& path);
+
+private:
+    struct Change
+    {
+        quint64 sequence;
+        QString relativePath;
+    };
+
+    void stopWatching();
+    void watchTree(const QString& dirPath);
+    bool watchDirectory(const QString& dirPath);
+    void recordChanges(const QStringList& relativePaths);
+    void snapshotDirectory(const QString& dirPath);
+    static bool isExcludedDir(const QString& name);
+    bool affects(const QString& component, const QString& relativePath) const;
+
+    QString m_rootPath;
+    QHash<QString, QStringList> m_componentPaths;      // Component -> owned subtrees
+    QHash<QString, quint64> m_builtSequence;            // Build key -> sequence at last successful build
+    QVector<Change> m_changes;                          // Changes in sequence order
+    quint64 m_sequence = 0;
+    quint64 m_overflowSequence = 0;                     // Builds older than this are dirty (history dropped)
+    bool m_reliable = false;
+    QHash<QString, QPair<quint64, QByteArray>> m_treeStates; // Directory -> (sequence, tree state) of the current root
+
+    // Linux inotify backend
+    int m_inotifyFd = -1;
+    QSocketNotifier* m_inotifyNotifier = nullptr;
+    QHash<int, QString> m_watchDirs;                    // Watch descriptor -> absolute directory
+
+    // Portable backend
+    QFileSystemWatcher* m_watcher = nullptr;
+    QHash<QString, QHash<QString, qint64>> m_snapshots; // Directory -> (entry -> mtime, -1 for subdirs)
+};
+
+#endif // SOURCECHANGETRACKER_H